@@ -0,0 +1,775 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../s21_async.h"
+#include "../s21_fixed_matrix.h"
+#include "../s21_incremental_matrix.h"
+#include "../s21_lazy_matrix.h"
+#include "../s21_lu.h"
+#include "../s21_matrix.h"
+#include "../s21_matrix_batch.h"
+#include "../s21_matrix_file.h"
+#include "../s21_sparse_matrix.h"
+#include "../s21_strassen.h"
+#include "../s21_tiled_matrix.h"
+#include "../s21_vector.h"
+
+// Every benchmark takes the shape of its first operand as (rows, cols) and
+// reports FLOPS (shown as GFLOP/s by the console reporter for large values)
+// and bytes_per_second for the data the operation has to touch at least once.
+
+namespace {
+
+void FillPseudoRandom(S21Matrix& matr, unsigned seed) {
+  for (int i = 0; i < matr.GetRows(); i++) {
+    for (int j = 0; j < matr.GetCols(); j++) {
+      seed = seed * 1103515245u + 12345u;
+      matr(i, j) = static_cast<double>((seed >> 16) % 2001) / 1000. - 1.;
+    }
+  }
+}
+
+void FillDiagonallyDominant(S21Matrix& matr, unsigned seed) {
+  FillPseudoRandom(matr, seed);
+  for (int i = 0; i < matr.GetRows(); i++) matr(i, i) += matr.GetCols();
+}
+
+void SetCounters(benchmark::State& state, double flops, double bytes) {
+  if (flops > 0) {
+    state.counters["FLOPS"] = benchmark::Counter(
+        flops, benchmark::Counter::kIsIterationInvariantRate,
+        benchmark::Counter::kIs1000);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(bytes) *
+                          state.iterations());
+}
+
+double Elements(const benchmark::State& state) {
+  return static_cast<double>(state.range(0)) * state.range(1);
+}
+
+// Square, tall-skinny and single-row shapes.
+void ElementWiseShapes(benchmark::internal::Benchmark* bench) {
+  for (int n : {16, 64, 256, 1024}) bench->Args({n, n});
+  bench->Args({16384, 16})->Args({65536, 4});
+  bench->Args({1, 4096})->Args({1, 65536});
+}
+
+void ProductShapes(benchmark::internal::Benchmark* bench) {
+  for (int n : {16, 64, 128, 256, 512}) bench->Args({n, n});
+  bench->Args({4096, 16})->Args({16384, 64});
+  bench->Args({1, 512})->Args({1, 2048});
+}
+
+void SquareShapes(benchmark::internal::Benchmark* bench) {
+  for (int n : {3, 4, 16, 64, 128, 256, 512}) bench->Args({n, n});
+}
+
+void BM_EqMatrix(benchmark::State& state) {
+  S21Matrix a(state.range(0), state.range(1));
+  FillPseudoRandom(a, 1);
+  S21Matrix b(a);
+  for (auto _ : state) benchmark::DoNotOptimize(a.EqMatrix(b));
+  SetCounters(state, Elements(state), 2 * Elements(state) * sizeof(double));
+}
+BENCHMARK(BM_EqMatrix)->Apply(ElementWiseShapes);
+
+void BM_SumMatrix(benchmark::State& state) {
+  S21Matrix a(state.range(0), state.range(1));
+  S21Matrix b(state.range(0), state.range(1));
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(b, 2);
+  for (auto _ : state) {
+    a.SumMatrix(b);
+    benchmark::ClobberMemory();
+  }
+  SetCounters(state, Elements(state), 3 * Elements(state) * sizeof(double));
+}
+BENCHMARK(BM_SumMatrix)->Apply(ElementWiseShapes);
+
+void BM_SubMatrix(benchmark::State& state) {
+  S21Matrix a(state.range(0), state.range(1));
+  S21Matrix b(state.range(0), state.range(1));
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(b, 2);
+  for (auto _ : state) {
+    a.SubMatrix(b);
+    benchmark::ClobberMemory();
+  }
+  SetCounters(state, Elements(state), 3 * Elements(state) * sizeof(double));
+}
+BENCHMARK(BM_SubMatrix)->Apply(ElementWiseShapes);
+
+void BM_MulNumber(benchmark::State& state) {
+  S21Matrix a(state.range(0), state.range(1));
+  FillPseudoRandom(a, 1);
+  for (auto _ : state) {
+    a.MulNumber(1.0000001);
+    benchmark::ClobberMemory();
+  }
+  SetCounters(state, Elements(state), 2 * Elements(state) * sizeof(double));
+}
+BENCHMARK(BM_MulNumber)->Apply(ElementWiseShapes);
+
+// A fused expression: one pass over three operands and the result.
+void BM_Expression(benchmark::State& state) {
+  S21Matrix a(state.range(0), state.range(1));
+  S21Matrix b(state.range(0), state.range(1));
+  S21Matrix c(state.range(0), state.range(1));
+  S21Matrix result(state.range(0), state.range(1));
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(b, 2);
+  FillPseudoRandom(c, 3);
+  for (auto _ : state) {
+    result = a + b - c * 2.;
+    benchmark::ClobberMemory();
+  }
+  SetCounters(state, 3 * Elements(state),
+              4 * Elements(state) * sizeof(double));
+}
+BENCHMARK(BM_Expression)->Apply(ElementWiseShapes);
+
+void BM_Copy(benchmark::State& state) {
+  S21Matrix a(state.range(0), state.range(1));
+  FillPseudoRandom(a, 1);
+  S21Matrix b(state.range(0), state.range(1));
+  for (auto _ : state) {
+    b = a;
+    benchmark::ClobberMemory();
+  }
+  SetCounters(state, 0, 2 * Elements(state) * sizeof(double));
+}
+BENCHMARK(BM_Copy)->Apply(ElementWiseShapes);
+
+void BM_Transpose(benchmark::State& state) {
+  S21Matrix a(state.range(0), state.range(1));
+  FillPseudoRandom(a, 1);
+  for (auto _ : state) {
+    S21Matrix t = a.Transpose();
+    benchmark::DoNotOptimize(t.data());
+  }
+  SetCounters(state, 0, 2 * Elements(state) * sizeof(double));
+}
+BENCHMARK(BM_Transpose)->Apply(ElementWiseShapes);
+
+void BM_TransposeInPlace(benchmark::State& state) {
+  S21Matrix a(state.range(0), state.range(1));
+  FillPseudoRandom(a, 1);
+  for (auto _ : state) {
+    a.TransposeInPlace();
+    benchmark::ClobberMemory();
+  }
+  SetCounters(state, 0, 2 * Elements(state) * sizeof(double));
+}
+BENCHMARK(BM_TransposeInPlace)->Apply(ElementWiseShapes);
+
+// (m x k) * (k x k).
+void BM_MulMatrix(benchmark::State& state) {
+  const int m = state.range(0), k = state.range(1);
+  S21Matrix a(m, k), b(k, k);
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(b, 2);
+  S21Matrix c(m, k);
+  for (auto _ : state) {
+    S21Matrix::Gemm(1., a, b, 0., c);
+    benchmark::ClobberMemory();
+  }
+  SetCounters(state, 2. * m * k * k,
+              (2. * m * k + static_cast<double>(k) * k) * sizeof(double));
+}
+BENCHMARK(BM_MulMatrix)->Apply(ProductShapes);
+
+// (n x n) * (n x 1) through S21Matrix, which routes it to GEMV, and the
+// same product and the rank-1 update on S21Vector.
+void BM_MulMatrixVector(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a(n, n), x(n, 1), y(n, 1);
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(x, 2);
+  for (auto _ : state) {
+    S21Matrix::Gemm(1., a, x, 0., y);
+    benchmark::ClobberMemory();
+  }
+  SetCounters(state, 2. * n * n, 1. * n * n * sizeof(double));
+}
+BENCHMARK(BM_MulMatrixVector)->Arg(512)->Arg(2048);
+
+void BM_Gemv(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a(n, n), column(n, 1);
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(column, 2);
+  S21Vector x(column);
+  for (auto _ : state) benchmark::DoNotOptimize((a * x).data());
+  SetCounters(state, 2. * n * n, 1. * n * n * sizeof(double));
+}
+BENCHMARK(BM_Gemv)->Arg(512)->Arg(2048);
+
+void BM_Ger(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a(n, n), column(n, 1);
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(column, 2);
+  S21Vector x(column);
+  for (auto _ : state) {
+    s21::Ger<double>(1e-9, x, x, a.View());
+    benchmark::ClobberMemory();
+  }
+  SetCounters(state, 2. * n * n, 2. * n * n * sizeof(double));
+}
+BENCHMARK(BM_Ger)->Arg(512)->Arg(2048);
+
+void BM_Dot(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix column(n, 1);
+  FillPseudoRandom(column, 1);
+  S21Vector x(column), y(x);
+  for (auto _ : state) benchmark::DoNotOptimize(x.Dot(y));
+  SetCounters(state, 2. * n, 2. * n * sizeof(double));
+}
+BENCHMARK(BM_Dot)->Arg(4096)->Arg(1 << 20);
+
+// (A * B) + (C * D) on n x n matrices, evaluated in order and through the
+// asynchronous graph, whose two products run side by side on the pool.
+void BM_SumOfProducts(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a(n, n), b(n, n), c(n, n), d(n, n);
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(b, 2);
+  FillPseudoRandom(c, 3);
+  FillPseudoRandom(d, 4);
+  for (auto _ : state) {
+    S21Matrix sum = a * b + c * d;
+    benchmark::DoNotOptimize(sum.data());
+  }
+  SetCounters(state, 4. * n * n * n, 5. * n * n * sizeof(double));
+}
+BENCHMARK(BM_SumOfProducts)->Arg(256)->Arg(1024);
+
+void BM_AsyncSumOfProducts(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a(n, n), b(n, n), c(n, n), d(n, n);
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(b, 2);
+  FillPseudoRandom(c, 3);
+  FillPseudoRandom(d, 4);
+  const S21AsyncMatrix async_a(a), async_b(b), async_c(c), async_d(d);
+  for (auto _ : state) {
+    S21AsyncMatrix sum = async_a * async_b + async_c * async_d;
+    benchmark::DoNotOptimize(sum.Get().data());
+  }
+  SetCounters(state, 4. * n * n * n, 5. * n * n * sizeof(double));
+}
+BENCHMARK(BM_AsyncSumOfProducts)->Arg(256)->Arg(1024);
+
+// a * b * v for n x n matrices and an n x 1 vector: eagerly left to right,
+// which costs a matrix product, and through the lazy graph, which reorders
+// it into two matrix-vector products. FLOPS counts the 4n^2 of the latter.
+void BM_ChainMulVector(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a(n, n), b(n, n), v(n, 1);
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(b, 2);
+  FillPseudoRandom(v, 3);
+  for (auto _ : state) {
+    S21Matrix product = a * b * v;
+    benchmark::DoNotOptimize(product.data());
+  }
+  SetCounters(state, 4. * n * n, 2. * n * n * sizeof(double));
+}
+BENCHMARK(BM_ChainMulVector)->Arg(256)->Arg(1024);
+
+void BM_LazyChainMulVector(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a(n, n), b(n, n), v(n, 1);
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(b, 2);
+  FillPseudoRandom(v, 3);
+  for (auto _ : state) {
+    S21Matrix product = (S21LazyMatrix(a) * b * v).Evaluate();
+    benchmark::DoNotOptimize(product.data());
+  }
+  SetCounters(state, 4. * n * n, 2. * n * n * sizeof(double));
+}
+BENCHMARK(BM_LazyChainMulVector)->Arg(256)->Arg(1024);
+
+// n x n products by Strassen-Winograd with the crossover of the second
+// argument. FLOPS counts the 2n^3 of the classic product, so the rate is
+// comparable with BM_MulMatrix.
+void BM_StrassenMulMatrix(benchmark::State& state) {
+  const int n = state.range(0);
+  const int crossover = s21::SetStrassenCrossover(state.range(1));
+  S21Matrix a(n, n), b(n, n);
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(b, 2);
+  for (auto _ : state) {
+    S21Matrix c = a;
+    c.MulMatrix(b, s21::MulAlgorithm::kStrassen);
+    benchmark::DoNotOptimize(c.data());
+  }
+  s21::SetStrassenCrossover(crossover);
+  SetCounters(state, 2. * n * n * n, 3. * n * n * sizeof(double));
+}
+BENCHMARK(BM_StrassenMulMatrix)
+    ->Args({1024, 256})
+    ->Args({1024, 1024})
+    ->Args({2048, 256})
+    ->Args({2048, 512})
+    ->Args({2048, 2048});
+
+// The same products on float operands, accumulated in float and in double.
+template <bool kMixed>
+void BM_FloatMulMatrix(benchmark::State& state) {
+  const int m = state.range(0), k = state.range(1);
+  S21Matrix a(m, k), b(k, k);
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(b, 2);
+  S21FloatMatrix fa(a), fb(b);
+  for (auto _ : state) {
+    S21FloatMatrix c(fa);
+    if (kMixed)
+      c.MulMatrixMixed(fb);
+    else
+      c.MulMatrix(fb);
+    benchmark::DoNotOptimize(c.data());
+  }
+  SetCounters(state, 2. * m * k * k,
+              (2. * m * k + static_cast<double>(k) * k) * sizeof(float));
+}
+BENCHMARK_TEMPLATE(BM_FloatMulMatrix, false)->Apply(ProductShapes);
+BENCHMARK_TEMPLATE(BM_FloatMulMatrix, true)->Apply(ProductShapes);
+
+void BM_Determinant(benchmark::State& state) {
+  const double n = state.range(0);
+  S21Matrix a(state.range(0), state.range(1));
+  FillDiagonallyDominant(a, 1);
+  for (auto _ : state) benchmark::DoNotOptimize(a.Determinant());
+  SetCounters(state, 2. / 3. * n * n * n, n * n * sizeof(double));
+}
+BENCHMARK(BM_Determinant)->Apply(SquareShapes);
+
+void BM_InverseMatrix(benchmark::State& state) {
+  const double n = state.range(0);
+  S21Matrix a(state.range(0), state.range(1));
+  FillDiagonallyDominant(a, 1);
+  for (auto _ : state) {
+    S21Matrix inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.data());
+  }
+  SetCounters(state, 2. * n * n * n, 2 * n * n * sizeof(double));
+}
+BENCHMARK(BM_InverseMatrix)->Apply(SquareShapes);
+
+// n^2 minors of O(n^3) each, so only small sizes.
+void BM_CalcComplements(benchmark::State& state) {
+  const double n = state.range(0);
+  S21Matrix a(state.range(0), state.range(1));
+  FillDiagonallyDominant(a, 1);
+  for (auto _ : state) {
+    S21Matrix complements = a.CalcComplements();
+    benchmark::DoNotOptimize(complements.data());
+  }
+  SetCounters(state, 2. / 3. * n * n * n * n * n,
+              2 * n * n * sizeof(double));
+}
+BENCHMARK(BM_CalcComplements)->Args({4, 4})->Args({16, 16})->Args({32, 32});
+
+// A x = b for an n x n matrix and range(1) right-hand sides. The FLOPS of
+// every solver count the work of the LU path, 2/3 n^3 + 2 n^2 k, so the
+// rates compare times directly.
+void SolveShapes(benchmark::internal::Benchmark* bench) {
+  for (int n : {64, 256, 512}) bench->Args({n, 1})->Args({n, 32});
+  bench->Args({512, 512});
+}
+
+double SolveFlops(const benchmark::State& state) {
+  const double n = state.range(0), k = state.range(1);
+  return 2. / 3. * n * n * n + 2. * n * n * k;
+}
+
+double SolveBytes(const benchmark::State& state) {
+  const double n = state.range(0), k = state.range(1);
+  return (n * n + 2 * n * k) * sizeof(double);
+}
+
+// The path the solvers replace: InverseMatrix, then a product.
+void BM_InverseThenMultiply(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a(n, n), b(n, state.range(1));
+  FillDiagonallyDominant(a, 1);
+  FillPseudoRandom(b, 2);
+  for (auto _ : state) {
+    S21Matrix x = a.InverseMatrix() * b;
+    benchmark::DoNotOptimize(x.data());
+  }
+  SetCounters(state, SolveFlops(state), SolveBytes(state));
+}
+BENCHMARK(BM_InverseThenMultiply)->Apply(SolveShapes);
+
+void BM_Solve(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a(n, n), b(n, state.range(1));
+  FillDiagonallyDominant(a, 1);
+  FillPseudoRandom(b, 2);
+  for (auto _ : state) {
+    S21Matrix x = a.Solve(b);
+    benchmark::DoNotOptimize(x.data());
+  }
+  SetCounters(state, SolveFlops(state), SolveBytes(state));
+}
+BENCHMARK(BM_Solve)->Apply(SolveShapes);
+
+// Only the substitutions: the factorization is kept across iterations.
+void BM_SolveFactored(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a(n, n), b(n, state.range(1));
+  FillDiagonallyDominant(a, 1);
+  FillPseudoRandom(b, 2);
+  const S21LU lu(a);
+  for (auto _ : state) {
+    S21Matrix x = lu.Solve(b);
+    benchmark::DoNotOptimize(x.data());
+  }
+  SetCounters(state, 2. * n * n * state.range(1), SolveBytes(state));
+}
+BENCHMARK(BM_SolveFactored)->Apply(SolveShapes);
+
+void BM_SolveCholesky(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a(n, n), b(n, state.range(1));
+  FillPseudoRandom(a, 1);
+  a = a + a.Transpose();
+  for (int i = 0; i < n; i++) a(i, i) += 2 * n;
+  FillPseudoRandom(b, 2);
+  for (auto _ : state) {
+    S21Matrix x = a.SolveCholesky(b);
+    benchmark::DoNotOptimize(x.data());
+  }
+  SetCounters(state, SolveFlops(state), SolveBytes(state));
+}
+BENCHMARK(BM_SolveCholesky)->Apply(SolveShapes);
+
+// Least squares on an m x n matrix with one right-hand side, counting the
+// 2 m n^2 - 2/3 n^3 flops of Householder QR.
+void BM_SolveLeastSquares(benchmark::State& state) {
+  const double m = state.range(0), n = state.range(1);
+  S21Matrix a(state.range(0), state.range(1)), b(state.range(0), 1);
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(b, 2);
+  for (auto _ : state) {
+    S21Matrix x = a.SolveLeastSquares(b);
+    benchmark::DoNotOptimize(x.data());
+  }
+  SetCounters(state, 2. * m * n * n - 2. / 3. * n * n * n,
+              (m * n + m) * sizeof(double));
+}
+BENCHMARK(BM_SolveLeastSquares)
+    ->Args({256, 256})
+    ->Args({1024, 64})
+    ->Args({4096, 256})
+    ->Args({16384, 32});
+
+// One step of an online estimator: row step % n is scaled by 1.01 on even
+// passes over the rows and restored on odd ones, then the determinant and
+// the inverse are read. The first recomputes both, the second keeps them
+// current by Sherman-Morrison and the matrix determinant lemma.
+double SetRowScale(int step, int n) { return (step / n) % 2 == 0 ? 1.01 : 1.; }
+
+void BM_RefactorAfterSetRow(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a(n, n), changed(n, n);
+  FillDiagonallyDominant(a, 1);
+  changed = a;
+  int step = 0;
+  for (auto _ : state) {
+    const int i = step % n;
+    const double scale = SetRowScale(step++, n);
+    for (int j = 0; j < n; j++) changed(i, j) = a(i, j) * scale;
+    benchmark::DoNotOptimize(changed.Determinant());
+    S21Matrix inverse = changed.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.data());
+  }
+  SetCounters(state, 0, static_cast<double>(n) * n * sizeof(double));
+}
+BENCHMARK(BM_RefactorAfterSetRow)->Arg(128)->Arg(512);
+
+void BM_IncrementalSetRow(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a(n, n), row(1, n);
+  FillDiagonallyDominant(a, 1);
+  S21IncrementalMatrix incremental(a);
+  incremental.Inverse();
+  int step = 0;
+  for (auto _ : state) {
+    const int i = step % n;
+    const double scale = SetRowScale(step++, n);
+    for (int j = 0; j < n; j++) row(0, j) = a(i, j) * scale;
+    incremental.SetRow(i, row);
+    benchmark::DoNotOptimize(incremental.Determinant());
+    benchmark::DoNotOptimize(incremental.Inverse().data());
+  }
+  state.counters["factorizations"] = incremental.GetFactorizations();
+  SetCounters(state, 0, static_cast<double>(n) * n * sizeof(double));
+}
+BENCHMARK(BM_IncrementalSetRow)->Arg(128)->Arg(512);
+
+void BM_SetRowsCols(benchmark::State& state) {
+  const int n = state.range(0);
+  for (auto _ : state) {
+    S21Matrix a(1, 1);
+    for (int i = 2; i <= n; i++) {
+      a.SetRows(i);
+      a.SetCols(i);
+    }
+    benchmark::DoNotOptimize(a.data());
+  }
+  SetCounters(state, 0, static_cast<double>(n) * n * sizeof(double));
+}
+BENCHMARK(BM_SetRowsCols)->Arg(64)->Arg(256);
+
+// Small transforms through S21FixedMatrix, to compare with the S21Matrix
+// runs of the same size above.
+template <int N>
+void BM_FixedMulMatrix(benchmark::State& state) {
+  S21Matrix a(N, N), b(N, N);
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(b, 2);
+  S21FixedMatrix<N, N> fa(a), fb(b);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fb);
+    benchmark::DoNotOptimize(fa * fb);
+  }
+  SetCounters(state, 2. * N * N * N, 3. * N * N * sizeof(double));
+}
+BENCHMARK_TEMPLATE(BM_FixedMulMatrix, 3);
+BENCHMARK_TEMPLATE(BM_FixedMulMatrix, 4);
+
+template <int N>
+void BM_FixedInverseMatrix(benchmark::State& state) {
+  S21Matrix a(N, N);
+  FillDiagonallyDominant(a, 1);
+  S21FixedMatrix<N, N> fa(a);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fa);
+    benchmark::DoNotOptimize(fa.InverseMatrix());
+  }
+  SetCounters(state, 2. * N * N * N, 2. * N * N * sizeof(double));
+}
+BENCHMARK_TEMPLATE(BM_FixedInverseMatrix, 3);
+BENCHMARK_TEMPLATE(BM_FixedInverseMatrix, 4);
+
+// Many small matrices: (count, n). The Loop variants do the same work one
+// S21Matrix at a time, as callers without the batch API would.
+void BatchShapes(benchmark::internal::Benchmark* bench) {
+  for (int n : {3, 4, 8}) bench->Args({1024, n})->Args({16384, n});
+}
+
+S21MatrixBatch RandomBatch(int count, int n, unsigned seed) {
+  S21MatrixBatch batch(count, n, n);
+  S21Matrix matr(n, n);
+  for (int index = 0; index < count; index++) {
+    FillDiagonallyDominant(matr, seed + index);
+    batch.Set(index, matr);
+  }
+  return batch;
+}
+
+void BM_BatchMulMatrix(benchmark::State& state) {
+  const int count = state.range(0), n = state.range(1);
+  S21MatrixBatch a = RandomBatch(count, n, 1), b = RandomBatch(count, n, 2);
+  for (auto _ : state) {
+    S21MatrixBatch c(a);
+    c.MulBatch(b);
+    benchmark::DoNotOptimize(c.Lane(0, 0));
+  }
+  SetCounters(state, 2. * count * n * n * n,
+              3. * count * n * n * sizeof(double));
+}
+BENCHMARK(BM_BatchMulMatrix)->Apply(BatchShapes);
+
+void BM_LoopMulMatrix(benchmark::State& state) {
+  const int count = state.range(0), n = state.range(1);
+  S21MatrixBatch a = RandomBatch(count, n, 1), b = RandomBatch(count, n, 2);
+  std::vector<S21Matrix> as, bs;
+  for (int index = 0; index < count; index++) {
+    as.push_back(a.Get(index));
+    bs.push_back(b.Get(index));
+  }
+  for (auto _ : state) {
+    for (int index = 0; index < count; index++) {
+      S21Matrix c = as[index] * bs[index];
+      benchmark::DoNotOptimize(c.data());
+    }
+  }
+  SetCounters(state, 2. * count * n * n * n,
+              3. * count * n * n * sizeof(double));
+}
+BENCHMARK(BM_LoopMulMatrix)->Apply(BatchShapes);
+
+void BM_BatchInverseMatrix(benchmark::State& state) {
+  const int count = state.range(0), n = state.range(1);
+  S21MatrixBatch a = RandomBatch(count, n, 1);
+  for (auto _ : state) {
+    S21MatrixBatch inverse = a.InverseBatch();
+    benchmark::DoNotOptimize(inverse.Lane(0, 0));
+  }
+  SetCounters(state, 2. * count * n * n * n,
+              2. * count * n * n * sizeof(double));
+}
+BENCHMARK(BM_BatchInverseMatrix)->Apply(BatchShapes);
+
+void BM_LoopInverseMatrix(benchmark::State& state) {
+  const int count = state.range(0), n = state.range(1);
+  S21MatrixBatch a = RandomBatch(count, n, 1);
+  std::vector<S21Matrix> as;
+  for (int index = 0; index < count; index++) as.push_back(a.Get(index));
+  for (auto _ : state) {
+    for (S21Matrix& matr : as) {
+      S21Matrix inverse = matr.InverseMatrix();
+      benchmark::DoNotOptimize(inverse.data());
+    }
+  }
+  SetCounters(state, 2. * count * n * n * n,
+              2. * count * n * n * sizeof(double));
+}
+BENCHMARK(BM_LoopInverseMatrix)->Apply(BatchShapes);
+
+void BM_BatchDeterminant(benchmark::State& state) {
+  const int count = state.range(0), n = state.range(1);
+  S21MatrixBatch a = RandomBatch(count, n, 1);
+  for (auto _ : state) benchmark::DoNotOptimize(a.DeterminantBatch());
+  SetCounters(state, 2. / 3. * count * n * n * n,
+              1. * count * n * n * sizeof(double));
+}
+BENCHMARK(BM_BatchDeterminant)->Apply(BatchShapes);
+
+void BM_LoopDeterminant(benchmark::State& state) {
+  const int count = state.range(0), n = state.range(1);
+  S21MatrixBatch a = RandomBatch(count, n, 1);
+  std::vector<S21Matrix> as;
+  for (int index = 0; index < count; index++) as.push_back(a.Get(index));
+  for (auto _ : state) {
+    for (S21Matrix& matr : as) benchmark::DoNotOptimize(matr.Determinant());
+  }
+  SetCounters(state, 2. / 3. * count * n * n * n,
+              1. * count * n * n * sizeof(double));
+}
+BENCHMARK(BM_LoopDeterminant)->Apply(BatchShapes);
+
+// Sparse products: (n, percent of non-zeros) for an n x n matrix. The
+// dense product of the same matrix is BM_MulMatrix.
+void SparseShapes(benchmark::internal::Benchmark* bench) {
+  for (int n : {256, 1024, 4096}) bench->Args({n, 1})->Args({n, 5});
+}
+
+S21SparseMatrix RandomSparse(int n, int percent, unsigned seed) {
+  std::vector<S21Triplet> triplets;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      seed = seed * 1103515245u + 12345u;
+      if ((seed >> 16) % 100 < static_cast<unsigned>(percent))
+        triplets.push_back({i, j, ((seed >> 8) % 2001) / 1000. - 1.});
+    }
+  }
+  return S21SparseMatrix(n, n, triplets);
+}
+
+void BM_SparseMulVector(benchmark::State& state) {
+  const int n = state.range(0);
+  S21SparseMatrix a = RandomSparse(n, state.range(1), 1);
+  std::vector<double> x(n, 0.5), y(n);
+  for (auto _ : state) {
+    a.MulVector(x.data(), y.data());
+    benchmark::ClobberMemory();
+  }
+  const double nnz = a.NonZeros();
+  SetCounters(state, 2. * nnz,
+              nnz * (sizeof(double) + sizeof(int)) + 2. * n * sizeof(double));
+}
+BENCHMARK(BM_SparseMulVector)->Apply(SparseShapes);
+
+void BM_SparseMulMatrix(benchmark::State& state) {
+  const int n = state.range(0), cols = 64;
+  S21SparseMatrix a = RandomSparse(n, state.range(1), 1);
+  S21Matrix b(n, cols);
+  FillPseudoRandom(b, 2);
+  for (auto _ : state) {
+    S21Matrix c = a * b;
+    benchmark::DoNotOptimize(c.data());
+  }
+  const double nnz = a.NonZeros();
+  SetCounters(state, 2. * nnz * cols,
+              nnz * (sizeof(double) + sizeof(int)) +
+                  2. * n * cols * sizeof(double));
+}
+BENCHMARK(BM_SparseMulMatrix)->Apply(SparseShapes);
+
+// Persistence of an n x n matrix. Load reads and checksums the whole file
+// (from the page cache here); Map only opens it and touches one element.
+std::string BenchPath() { return "/tmp/s21_bench_matrix.bin"; }
+
+void BM_SaveMatrix(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a(n, n);
+  FillPseudoRandom(a, 1);
+  for (auto _ : state) a.Save(BenchPath());
+  std::remove(BenchPath().c_str());
+  SetCounters(state, 0, static_cast<double>(n) * n * sizeof(double));
+}
+BENCHMARK(BM_SaveMatrix)->Arg(256)->Arg(2048);
+
+void BM_LoadMatrix(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a(n, n);
+  FillPseudoRandom(a, 1);
+  a.Save(BenchPath());
+  for (auto _ : state) {
+    S21Matrix loaded = S21Matrix::Load(BenchPath());
+    benchmark::DoNotOptimize(loaded.data());
+  }
+  std::remove(BenchPath().c_str());
+  SetCounters(state, 0, static_cast<double>(n) * n * sizeof(double));
+}
+BENCHMARK(BM_LoadMatrix)->Arg(256)->Arg(2048);
+
+void BM_MapMatrix(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a(n, n);
+  FillPseudoRandom(a, 1);
+  a.Save(BenchPath());
+  for (auto _ : state) {
+    S21MappedMatrix mapped(BenchPath());
+    benchmark::DoNotOptimize(mapped(n - 1, n - 1));
+  }
+  std::remove(BenchPath().c_str());
+}
+BENCHMARK(BM_MapMatrix)->Arg(256)->Arg(2048);
+
+// n x n product through tile files of the given tile size; compare with
+// BM_MulMatrix for the cost of going through the disk.
+void BM_TiledMulMatrix(benchmark::State& state) {
+  const int n = state.range(0), tile = state.range(1);
+  S21Matrix a(n, n), b(n, n);
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(b, 2);
+  const std::string a_path = BenchPath() + ".a", b_path = BenchPath() + ".b";
+  S21TiledMatrix tiled_a = S21TiledMatrix::FromMatrix(a_path, a, tile);
+  S21TiledMatrix tiled_b = S21TiledMatrix::FromMatrix(b_path, b, tile);
+  for (auto _ : state) {
+    S21TiledMatrix c = tiled_a.MulMatrix(tiled_b, BenchPath());
+    benchmark::DoNotOptimize(c.GetRows());
+  }
+  std::remove(a_path.c_str());
+  std::remove(b_path.c_str());
+  std::remove(BenchPath().c_str());
+  SetCounters(state, 2. * n * n * n, 3. * n * n * sizeof(double));
+}
+BENCHMARK(BM_TiledMulMatrix)->Args({1024, 256})->Args({2048, 512});
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+"""Compares two Google Benchmark JSON reports (see `make bench`).
+
+    benchmarks/compare.py baseline.json contender.json [--threshold 0.05]
+
+Prints the time ratio contender/baseline of every benchmark present in both
+reports and exits with status 1 when any of them got slower by more than
+the threshold.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as report:
+        data = json.load(report)
+    times = {}
+    for bench in data["benchmarks"]:
+        # With --benchmark_repetitions only the aggregates are compared.
+        if bench.get("run_type") == "aggregate" and \
+                bench.get("aggregate_name") != "median":
+            continue
+        name = bench.get("run_name", bench["name"])
+        times[name] = bench["real_time"] * _UNITS[bench.get("time_unit", "ns")]
+    return times
+
+
+_UNITS = {"ns": 1e-9, "us": 1e-6, "ms": 1e-3, "s": 1.}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="allowed relative slowdown (default 0.05)")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    contender = load(args.contender)
+    regressions = 0
+    width = max((len(name) for name in baseline), default=0)
+    for name, old in baseline.items():
+        if name not in contender:
+            continue
+        ratio = contender[name] / old
+        mark = ""
+        if ratio > 1. + args.threshold:
+            mark = "  REGRESSION"
+            regressions += 1
+        elif ratio < 1. - args.threshold:
+            mark = "  improved"
+        print(f"{name:<{width}}  {old * 1e6:12.3f}us  "
+              f"{contender[name] * 1e6:12.3f}us  {ratio:6.3f}x{mark}")
+    missing = sorted(set(baseline) ^ set(contender))
+    for name in missing:
+        print(f"{name:<{width}}  only in one report")
+    print(f"{regressions} regression(s) above {args.threshold:.0%}")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,149 @@
+#include "s21_async.h"
+
+#include <stdexcept>
+
+#include "s21_lu.h"
+
+namespace s21 {
+
+bool AsyncState::IsReady() const noexcept {
+  return ready_.load(std::memory_order_acquire);
+}
+
+void AsyncState::Wait() const {
+  if (IsReady()) return;
+  ThreadPool::Instance().RunUntil([this] { return IsReady(); });
+}
+
+void AsyncState::OnReady(std::function<void()> continuation) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!IsReady()) {
+      continuations_.push_back(std::move(continuation));
+      return;
+    }
+  }
+  continuation();
+}
+
+void AsyncState::_SetReady(std::exception_ptr error) {
+  std::vector<std::function<void()>> continuations;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    error_ = std::move(error);
+    ready_.store(true, std::memory_order_release);
+    continuations.swap(continuations_);
+  }
+  for (std::function<void()>& continuation : continuations) continuation();
+}
+
+void AsyncState::_Rethrow() const {
+  if (error_) std::rethrow_exception(error_);
+}
+
+}  // namespace s21
+
+namespace {
+
+template <class T>
+using Matrix = S21BasicMatrix<T>;
+
+// The factorization behind Determinant, InverseMatrix and Solve, with their
+// checks. Those members are not const, and a copy to call them on would be
+// a deep one: copy-on-write and the default resource are per thread, so
+// the results reaching a pool worker are not refcounted.
+template <class T>
+S21BasicLU<T> Factor(const Matrix<T>& a) {
+  if (a.GetRows() != a.GetCols())
+    throw std::invalid_argument("Matrix is not square");
+  if (a.GetRows() < 1) throw std::out_of_range("Invalid matrix");
+  return S21BasicLU<T>(a.View());
+}
+
+}  // namespace
+
+template <class T>
+S21BasicAsyncMatrix<T>::S21BasicAsyncMatrix(S21BasicMatrix<T> matrix)
+    : s21::Future<S21BasicMatrix<T>>(std::move(matrix)) {}
+
+template <class T>
+S21BasicAsyncMatrix<T>::S21BasicAsyncMatrix(
+    s21::Future<S21BasicMatrix<T>> future)
+    : s21::Future<S21BasicMatrix<T>>(std::move(future)) {}
+
+template <class T>
+S21BasicAsyncMatrix<T> S21BasicAsyncMatrix<T>::operator+(
+    const S21BasicAsyncMatrix& other) const {
+  return s21::Then(
+      [](const Matrix<T>& a, const Matrix<T>& b) { return Matrix<T>(a + b); },
+      *this, other);
+}
+
+template <class T>
+S21BasicAsyncMatrix<T> S21BasicAsyncMatrix<T>::operator-(
+    const S21BasicAsyncMatrix& other) const {
+  return s21::Then(
+      [](const Matrix<T>& a, const Matrix<T>& b) { return Matrix<T>(a - b); },
+      *this, other);
+}
+
+template <class T>
+S21BasicAsyncMatrix<T> S21BasicAsyncMatrix<T>::operator*(
+    const S21BasicAsyncMatrix& other) const {
+  return s21::Then(
+      [](const Matrix<T>& a, const Matrix<T>& b) { return Matrix<T>(a * b); },
+      *this, other);
+}
+
+template <class T>
+S21BasicAsyncMatrix<T> S21BasicAsyncMatrix<T>::operator*(const T num) const {
+  return s21::Then([num](const Matrix<T>& a) { return Matrix<T>(a * num); },
+                   *this);
+}
+
+template <class T>
+S21BasicAsyncMatrix<T> S21BasicAsyncMatrix<T>::Transpose() const {
+  return s21::Then([](const Matrix<T>& a) { return Matrix<T>(a.Transpose()); },
+                   *this);
+}
+
+// CalcComplements is not const and has no const counterpart, so it runs on
+// a copy; O(n^2) against its O(n^5).
+template <class T>
+S21BasicAsyncMatrix<T> S21BasicAsyncMatrix<T>::CalcComplements() const {
+  return s21::Then(
+      [](const Matrix<T>& a) { return Matrix<T>(a).CalcComplements(); },
+      *this);
+}
+
+template <class T>
+S21BasicAsyncMatrix<T> S21BasicAsyncMatrix<T>::InverseMatrix() const {
+  return s21::Then(
+      [](const Matrix<T>& a) {
+        const S21BasicLU<T> lu = Factor(a);
+        if (lu.IsSingular())
+          throw std::invalid_argument("Determinant equals 0");
+        return lu.Inverse();
+      },
+      *this);
+}
+
+template <class T>
+S21BasicAsyncMatrix<T> S21BasicAsyncMatrix<T>::Solve(
+    const S21BasicAsyncMatrix& b) const {
+  return s21::Then(
+      [](const Matrix<T>& a, const Matrix<T>& rhs) {
+        return Factor(a).Solve(rhs.View());
+      },
+      *this, b);
+}
+
+template <class T>
+s21::Future<T> S21BasicAsyncMatrix<T>::Determinant() const {
+  return s21::Then([](const Matrix<T>& a) { return Factor(a).Determinant(); },
+                   *this);
+}
+
+template class S21BasicAsyncMatrix<float>;
+template class S21BasicAsyncMatrix<double>;
+template class S21BasicAsyncMatrix<long double>;
@@ -0,0 +1,157 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_ASYNC_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_ASYNC_H
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix.h"
+#include "s21_thread_pool.h"
+
+namespace s21 {
+
+// Completion state shared by the futures of one value and the task that
+// computes it.
+class AsyncState {
+ public:
+  bool IsReady() const noexcept;
+  // Runs pool tasks on the calling thread until the state is ready.
+  void Wait() const;
+  // Calls continuation once the state is ready: on the thread that makes
+  // it ready, or right away when it already is.
+  void OnReady(std::function<void()> continuation);
+
+ protected:
+  void _SetReady(std::exception_ptr error);
+  // Rethrows what the producing task threw, if anything.
+  void _Rethrow() const;
+
+ private:
+  std::mutex mutex_;
+  std::atomic<bool> ready_{false};
+  std::exception_ptr error_;
+  std::vector<std::function<void()>> continuations_;
+};
+
+template <class V>
+class AsyncValue : public AsyncState {
+ public:
+  // Stores f() or the exception it throws, then runs the continuations.
+  template <class F>
+  void Run(F& f) noexcept {
+    std::exception_ptr error;
+    try {
+      value_.emplace(f());
+    } catch (...) {
+      error = std::current_exception();
+    }
+    _SetReady(error);
+  }
+
+  const V& Get() const {
+    Wait();
+    _Rethrow();
+    return *value_;
+  }
+
+ private:
+  std::optional<V> value_;
+};
+
+template <class V>
+class Future;
+
+// Schedules f(args.Get()...) on the shared pool once every argument is
+// ready and returns the future of its result. Nothing blocks meanwhile:
+// the last argument to become ready submits the task, so the independent
+// branches of a graph built by Then run concurrently. An argument that
+// failed fails the result with the same exception.
+template <class F, class... Args>
+auto Then(F f, const Future<Args>&... args);
+
+// Handle on a value computed on the shared pool; copies share the value.
+// Get() waits, running pool tasks on the calling thread in the meantime,
+// and rethrows what the producing task threw.
+template <class V>
+class Future {
+ public:
+  // A future that is ready with value.
+  explicit Future(V value) : state_(std::make_shared<AsyncValue<V>>()) {
+    auto make = [&value] { return std::move(value); };
+    state_->Run(make);
+  }
+
+  bool IsReady() const noexcept { return state_->IsReady(); }
+  void Wait() const { state_->Wait(); }
+  const V& Get() const { return state_->Get(); }
+
+ private:
+  std::shared_ptr<AsyncValue<V>> state_;
+
+  explicit Future(std::shared_ptr<AsyncValue<V>> state)
+      : state_(std::move(state)) {}
+
+  template <class F, class... Args>
+  friend auto Then(F f, const Future<Args>&... args);
+};
+
+// The continuations keep the task, and the task its arguments, until it
+// runs; the references go away with the continuations once it is
+// submitted.
+template <class F, class... Args>
+auto Then(F f, const Future<Args>&... args) {
+  using Result = std::decay_t<std::invoke_result_t<F&, const Args&...>>;
+  auto state = std::make_shared<AsyncValue<Result>>();
+  auto pending =
+      std::make_shared<std::atomic<int>>(static_cast<int>(sizeof...(Args)) + 1);
+  auto task = [state, f = std::move(f), args...]() mutable {
+    auto call = [&] { return f(args.Get()...); };
+    state->Run(call);
+  };
+  auto arrive = [pending, task = std::move(task)] {
+    if (--*pending == 0) ThreadPool::Instance().Submit(task);
+  };
+  (args.state_->OnReady(arrive), ...);
+  arrive();
+  return Future<Result>(std::move(state));
+}
+
+}  // namespace s21
+
+// Asynchronous counterparts of the S21BasicMatrix operations. Each one
+// returns at once and runs on the shared pool as soon as its operands are
+// ready, so chained calls form a dependency graph: in (a * b) + (c * d)
+// both products run concurrently and the sum starts when the second one
+// finishes. Operands are never modified; errors surface from Get().
+template <class T>
+class S21BasicAsyncMatrix : public s21::Future<S21BasicMatrix<T>> {
+ public:
+  explicit S21BasicAsyncMatrix(S21BasicMatrix<T> matrix);
+  // Implicit, so that the futures of s21::Then chain like the operations.
+  S21BasicAsyncMatrix(s21::Future<S21BasicMatrix<T>> future);
+
+  S21BasicAsyncMatrix operator+(const S21BasicAsyncMatrix& other) const;
+  S21BasicAsyncMatrix operator-(const S21BasicAsyncMatrix& other) const;
+  S21BasicAsyncMatrix operator*(const S21BasicAsyncMatrix& other) const;
+  S21BasicAsyncMatrix operator*(const T num) const;
+
+  S21BasicAsyncMatrix Transpose() const;
+  S21BasicAsyncMatrix CalcComplements() const;
+  S21BasicAsyncMatrix InverseMatrix() const;
+  S21BasicAsyncMatrix Solve(const S21BasicAsyncMatrix& b) const;
+  s21::Future<T> Determinant() const;
+};
+
+using S21AsyncMatrix = S21BasicAsyncMatrix<double>;
+
+extern template class S21BasicAsyncMatrix<float>;
+extern template class S21BasicAsyncMatrix<double>;
+extern template class S21BasicAsyncMatrix<long double>;
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_ASYNC_H
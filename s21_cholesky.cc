@@ -0,0 +1,194 @@
+#include "s21_cholesky.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "s21_gemm.h"
+#include "s21_triangular.h"
+
+template <class T>
+S21BasicCholesky<T>::S21BasicCholesky(S21BasicMatrixView<const T> matrix)
+    : l_(matrix), size_(matrix.GetRows()), positive_(false) {
+  if (matrix.GetRows() != matrix.GetCols())
+    throw std::invalid_argument("Matrix is not square");
+  positive_ = _Factorize(l_);
+  for (int i = 0; i + 1 < size_; i++) {
+    std::fill(l_.data() + static_cast<std::size_t>(i) * l_.stride() + i + 1,
+              l_.data() + static_cast<std::size_t>(i) * l_.stride() + size_,
+              T(0));
+  }
+}
+
+template <class T>
+bool S21BasicCholesky<T>::_Factorize(S21BasicMatrixView<T> a) {
+  const int size = a.GetRows();
+  T max_abs = 0;
+  for (int i = 0; i < size; i++)
+    max_abs = std::max(max_abs, std::abs(a.Row(i)[i]));
+  const T tolerance = max_abs * size * std::numeric_limits<T>::epsilon();
+  for (int k = 0; k < size; k += kBlock) {
+    const int nb = std::min(kBlock, size - k);
+    if (!_FactorDiagonal(a, k, nb, tolerance)) return false;
+    _SolvePanel(a, k, nb);
+    _UpdateTrailing(a, k, nb);
+  }
+  return true;
+}
+
+// Left-looking elimination of the diagonal block; the columns left of it
+// were already subtracted by the trailing updates.
+template <class T>
+bool S21BasicCholesky<T>::_FactorDiagonal(S21BasicMatrixView<T> a, int k,
+                                          int nb, T tolerance) {
+  const int end = k + nb;
+  for (int j = k; j < end; j++) {
+    T* row_j = a.Row(j);
+    T pivot = row_j[j];
+    for (int r = k; r < j; r++) pivot -= row_j[r] * row_j[r];
+    if (!(pivot > tolerance)) return false;
+    pivot = std::sqrt(pivot);
+    row_j[j] = pivot;
+    for (int i = j + 1; i < end; i++) {
+      T* row_i = a.Row(i);
+      T sum = row_i[j];
+      for (int r = k; r < j; r++) sum -= row_i[r] * row_j[r];
+      row_i[j] = sum / pivot;
+    }
+  }
+  return true;
+}
+
+// L21 := A21 * L11^-T, i.e. L11 * L21^T = A21^T, solved on a transposed
+// copy so that every row of A21 becomes one right-hand side.
+template <class T>
+void S21BasicCholesky<T>::_SolvePanel(S21BasicMatrixView<T> a, int k,
+                                      int nb) {
+  const int rest = a.GetRows() - k - nb;
+  if (rest <= 0) return;
+  const S21BasicMatrixView<T> a21 = a.Block(k + nb, k, rest, nb);
+  S21BasicMatrix<T> panel(nb, rest);
+  s21::Copy<T>(a21.Transposed(), panel);
+  s21::TriangularSolve<T>(s21::Triangle::kLower, s21::Diagonal::kNonUnit,
+                          a.Block(k, k, nb, nb), panel);
+  s21::Copy<T>(std::as_const(panel).View().Transposed(), a21);
+}
+
+// A22 -= L21 * L21^T on the lower triangle only, one GEMM per block row.
+template <class T>
+void S21BasicCholesky<T>::_UpdateTrailing(S21BasicMatrixView<T> a, int k,
+                                          int nb) {
+  const int size = a.GetRows();
+  const int end = k + nb;
+  const int stride = a.stride();
+  for (int i = end; i < size; i += kBlock) {
+    const int rows = std::min(kBlock, size - i);
+    s21::Gemm<T>(rows, i + rows - end, nb, -1, a.Row(i) + k, stride, 1,
+                 a.Row(end) + k, 1, stride, 1, a.Row(i) + end, stride, 1);
+  }
+}
+
+template <class T>
+int S21BasicCholesky<T>::GetSize() const noexcept {
+  return size_;
+}
+
+template <class T>
+const S21BasicMatrix<T>& S21BasicCholesky<T>::GetFactor() const noexcept {
+  return l_;
+}
+
+template <class T>
+bool S21BasicCholesky<T>::IsPositiveDefinite() const noexcept {
+  return positive_;
+}
+
+template <class T>
+T S21BasicCholesky<T>::Determinant() const noexcept {
+  T det = 1;
+  for (int i = 0; i < size_; i++) {
+    const T pivot = l_.data()[static_cast<std::size_t>(i) * l_.stride() + i];
+    det *= pivot * pivot;
+  }
+  return det;
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicCholesky<T>::Solve(
+    S21BasicMatrixView<const T> b) const {
+  if (b.Empty()) throw std::out_of_range("Invalid matrix");
+  if (b.GetRows() != size_) throw std::invalid_argument("Sizes are not equal");
+  if (!positive_)
+    throw std::invalid_argument("Matrix is not positive definite");
+  S21BasicMatrix<T> x(b);
+  const S21BasicMatrixView<const T> l = l_.View();
+  s21::TriangularSolve<T>(s21::Triangle::kLower, s21::Diagonal::kNonUnit, l,
+                          x);
+  s21::TriangularSolve<T>(s21::Triangle::kUpper, s21::Diagonal::kNonUnit,
+                          l.Transposed(), x);
+  return x;
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicCholesky<T>::Inverse() const {
+  S21BasicMatrix<T> identity(size_, size_);
+  for (int i = 0; i < size_; i++)
+    identity.data()[static_cast<std::size_t>(i) * identity.stride() + i] = 1;
+  return Solve(identity);
+}
+
+template <class T>
+bool S21BasicCholesky<T>::Update(S21BasicMatrixView<const T> u) {
+  return _Rotate(u, 1);
+}
+
+template <class T>
+bool S21BasicCholesky<T>::Downdate(S21BasicMatrixView<const T> u) {
+  return _Rotate(u, -1);
+}
+
+// Column k of [L u] is rotated so that u_k vanishes: the new pivot is
+// r = sqrt(l_kk^2 +- u_k^2), and with c = r / l_kk, s = u_k / l_kk the rest
+// of the column and of u become (l +- s u) / c and c u - s l'.
+template <class T>
+bool S21BasicCholesky<T>::_Rotate(S21BasicMatrixView<const T> u, int sign) {
+  if (u.Empty()) throw std::out_of_range("Invalid matrix");
+  if (u.GetRows() != size_ || u.GetCols() != 1)
+    throw std::invalid_argument("Sizes are not equal");
+  if (!positive_)
+    throw std::invalid_argument("Matrix is not positive definite");
+  std::vector<T> x(size_);
+  for (int i = 0; i < size_; i++) x[i] = u(i, 0);
+  const T roundoff = size_ * std::numeric_limits<T>::epsilon();
+  for (int k = 0; k < size_; k++) {
+    T* row_k = l_.data() + static_cast<std::size_t>(k) * l_.stride();
+    const T pivot = row_k[k], xk = x[k];
+    if (xk == 0) continue;
+    T r;
+    if (sign > 0) {
+      r = std::hypot(pivot, xk);
+    } else {
+      const T r2 = (pivot - xk) * (pivot + xk);
+      if (!(r2 > roundoff * pivot * pivot)) {
+        positive_ = false;
+        return false;
+      }
+      r = std::sqrt(r2);
+    }
+    const T c = r / pivot, s = xk / pivot;
+    row_k[k] = r;
+    for (int i = k + 1; i < size_; i++) {
+      T& l = l_.data()[static_cast<std::size_t>(i) * l_.stride() + k];
+      l = (l + sign * s * x[i]) / c;
+      x[i] = c * x[i] - s * l;
+    }
+  }
+  return true;
+}
+
+template class S21BasicCholesky<float>;
+template class S21BasicCholesky<double>;
+template class S21BasicCholesky<long double>;
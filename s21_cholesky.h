@@ -0,0 +1,60 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_CHOLESKY_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_CHOLESKY_H
+
+#include "s21_matrix.h"
+
+// Cholesky factorization A = L * L^T of a symmetric positive definite
+// matrix: half the flops of LU and stable without pivoting. Only the lower
+// triangle of A is read. Like S21BasicLU, the factorization is computed
+// once and reused for any number of solves.
+template <class T>
+class S21BasicCholesky {
+ public:
+  explicit S21BasicCholesky(S21BasicMatrixView<const T> matrix);
+
+  int GetSize() const noexcept;
+  // L, with zeros above the diagonal.
+  const S21BasicMatrix<T>& GetFactor() const noexcept;
+  // False when some pivot is negative or negligible relative to the largest
+  // diagonal element of A; the factorization stops there.
+  bool IsPositiveDefinite() const noexcept;
+
+  // Meaningful only for a positive definite matrix.
+  T Determinant() const noexcept;
+  S21BasicMatrix<T> Solve(S21BasicMatrixView<const T> b) const;
+  S21BasicMatrix<T> Inverse() const;
+
+  // L * L^T := L * L^T + u * u^T and L * L^T - u * u^T for an n x 1 u, in
+  // O(n^2) by one plane rotation per column (LINPACK xCHUD / xCHDD). An
+  // update always succeeds on a positive definite factorization; a downdate
+  // returns false, and IsPositiveDefinite() turns false, when the result is
+  // not positive definite. L is then invalid until the matrix is factored
+  // again.
+  bool Update(S21BasicMatrixView<const T> u);
+  bool Downdate(S21BasicMatrixView<const T> u);
+
+ private:
+  static constexpr int kBlock = 64;
+
+  S21BasicMatrix<T> l_;
+  int size_;
+  bool positive_;
+
+  // Right-looking blocked factorization in place; false at the first pivot
+  // that is not above tolerance.
+  static bool _Factorize(S21BasicMatrixView<T> a);
+  static bool _FactorDiagonal(S21BasicMatrixView<T> a, int k, int nb,
+                              T tolerance);
+  static void _SolvePanel(S21BasicMatrixView<T> a, int k, int nb);
+  static void _UpdateTrailing(S21BasicMatrixView<T> a, int k, int nb);
+  // Rank-1 update for sign 1, downdate for sign -1.
+  bool _Rotate(S21BasicMatrixView<const T> u, int sign);
+};
+
+using S21Cholesky = S21BasicCholesky<double>;
+
+extern template class S21BasicCholesky<float>;
+extern template class S21BasicCholesky<double>;
+extern template class S21BasicCholesky<long double>;
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_CHOLESKY_H
@@ -0,0 +1,407 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_FIXED_MATRIX_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_FIXED_MATRIX_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_matrix.h"
+
+namespace s21 {
+
+template <class T>
+constexpr T FixedAbs(T value) noexcept {
+  return value < T(0) ? -value : value;
+}
+
+// Row i of A times column j of B, with the k loop unrolled at compile time.
+template <class T, std::size_t... P>
+constexpr T FixedDot(const T* a_row, const T* b, std::size_t ldb,
+                     std::size_t j, std::index_sequence<P...>) noexcept {
+  return (T(0) + ... + (a_row[P] * b[P * ldb + j]));
+}
+
+// out := A * B for a row-major R x C matrix A and C x K matrix B; one fold
+// term per element of out, so there is no loop left at all.
+template <class T, std::size_t C, std::size_t K, std::size_t... E>
+constexpr void FixedProduct(const T* a, const T* b, T* out,
+                            std::index_sequence<E...>) noexcept {
+  ((out[E] = FixedDot(a + E / K * C, b, K, E % K,
+                      std::make_index_sequence<C>())),
+   ...);
+}
+
+// Determinant and inverse of a row-major N x N array. The general case is
+// Gaussian elimination with partial pivoting; 2x2, 3x3 and 4x4 use closed
+// forms.
+template <int N, class T>
+struct FixedKernels {
+  static constexpr T Determinant(const T* a) noexcept {
+    T m[N * N]{};
+    for (int i = 0; i < N * N; i++) m[i] = a[i];
+    T det(1);
+    for (int k = 0; k < N; k++) {
+      int pivot = k;
+      for (int i = k + 1; i < N; i++) {
+        if (FixedAbs(m[i * N + k]) > FixedAbs(m[pivot * N + k])) pivot = i;
+      }
+      if (m[pivot * N + k] == T(0)) return T(0);
+      if (pivot != k) {
+        for (int j = 0; j < N; j++) {
+          T tmp = m[k * N + j];
+          m[k * N + j] = m[pivot * N + j];
+          m[pivot * N + j] = tmp;
+        }
+        det = -det;
+      }
+      det *= m[k * N + k];
+      for (int i = k + 1; i < N; i++) {
+        T l = m[i * N + k] / m[k * N + k];
+        for (int j = k + 1; j < N; j++) m[i * N + j] -= l * m[k * N + j];
+      }
+    }
+    return det;
+  }
+
+  // Gauss-Jordan on [A | I]; A must not be singular.
+  static constexpr void Inverse(const T* a, T, T* out) noexcept {
+    T m[N * N]{};
+    for (int i = 0; i < N * N; i++) {
+      m[i] = a[i];
+      out[i] = i / N == i % N ? T(1) : T(0);
+    }
+    for (int k = 0; k < N; k++) {
+      int pivot = k;
+      for (int i = k + 1; i < N; i++) {
+        if (FixedAbs(m[i * N + k]) > FixedAbs(m[pivot * N + k])) pivot = i;
+      }
+      for (int j = 0; j < N; j++) {
+        T tmp = m[k * N + j];
+        m[k * N + j] = m[pivot * N + j];
+        m[pivot * N + j] = tmp;
+        tmp = out[k * N + j];
+        out[k * N + j] = out[pivot * N + j];
+        out[pivot * N + j] = tmp;
+      }
+      T scale = T(1) / m[k * N + k];
+      for (int j = 0; j < N; j++) {
+        m[k * N + j] *= scale;
+        out[k * N + j] *= scale;
+      }
+      for (int i = 0; i < N; i++) {
+        T l = m[i * N + k];
+        if (i == k || l == T(0)) continue;
+        for (int j = 0; j < N; j++) {
+          m[i * N + j] -= l * m[k * N + j];
+          out[i * N + j] -= l * out[k * N + j];
+        }
+      }
+    }
+  }
+};
+
+template <class T>
+struct FixedKernels<1, T> {
+  static constexpr T Determinant(const T* a) noexcept { return a[0]; }
+  static constexpr void Inverse(const T*, T det, T* out) noexcept {
+    out[0] = T(1) / det;
+  }
+};
+
+template <class T>
+struct FixedKernels<2, T> {
+  static constexpr T Determinant(const T* a) noexcept {
+    return a[0] * a[3] - a[1] * a[2];
+  }
+  static constexpr void Inverse(const T* a, T det, T* out) noexcept {
+    T r = T(1) / det;
+    out[0] = a[3] * r;
+    out[1] = -a[1] * r;
+    out[2] = -a[2] * r;
+    out[3] = a[0] * r;
+  }
+};
+
+template <class T>
+struct FixedKernels<3, T> {
+  static constexpr T Determinant(const T* a) noexcept {
+    return a[0] * (a[4] * a[8] - a[5] * a[7]) -
+           a[1] * (a[3] * a[8] - a[5] * a[6]) +
+           a[2] * (a[3] * a[7] - a[4] * a[6]);
+  }
+  // Adjugate divided by the determinant.
+  static constexpr void Inverse(const T* a, T det, T* out) noexcept {
+    T r = T(1) / det;
+    out[0] = (a[4] * a[8] - a[5] * a[7]) * r;
+    out[1] = (a[2] * a[7] - a[1] * a[8]) * r;
+    out[2] = (a[1] * a[5] - a[2] * a[4]) * r;
+    out[3] = (a[5] * a[6] - a[3] * a[8]) * r;
+    out[4] = (a[0] * a[8] - a[2] * a[6]) * r;
+    out[5] = (a[2] * a[3] - a[0] * a[5]) * r;
+    out[6] = (a[3] * a[7] - a[4] * a[6]) * r;
+    out[7] = (a[1] * a[6] - a[0] * a[7]) * r;
+    out[8] = (a[0] * a[4] - a[1] * a[3]) * r;
+  }
+};
+
+// Laplace expansion by complementary 2x2 minors of the top (s) and bottom
+// (c) row pairs; the inverse reuses the same twelve minors.
+template <class T>
+struct FixedKernels<4, T> {
+  struct Minors {
+    T s[6];
+    T c[6];
+  };
+
+  static constexpr Minors Compute(const T* a) noexcept {
+    return {{a[0] * a[5] - a[4] * a[1], a[0] * a[6] - a[4] * a[2],
+             a[0] * a[7] - a[4] * a[3], a[1] * a[6] - a[5] * a[2],
+             a[1] * a[7] - a[5] * a[3], a[2] * a[7] - a[6] * a[3]},
+            {a[8] * a[13] - a[12] * a[9], a[8] * a[14] - a[12] * a[10],
+             a[8] * a[15] - a[12] * a[11], a[9] * a[14] - a[13] * a[10],
+             a[9] * a[15] - a[13] * a[11], a[10] * a[15] - a[14] * a[11]}};
+  }
+
+  static constexpr T Determinant(const T* a) noexcept {
+    Minors m = Compute(a);
+    return m.s[0] * m.c[5] - m.s[1] * m.c[4] + m.s[2] * m.c[3] +
+           m.s[3] * m.c[2] - m.s[4] * m.c[1] + m.s[5] * m.c[0];
+  }
+
+  static constexpr void Inverse(const T* a, T det, T* out) noexcept {
+    Minors m = Compute(a);
+    const T* s = m.s;
+    const T* c = m.c;
+    T r = T(1) / det;
+    out[0] = (a[5] * c[5] - a[6] * c[4] + a[7] * c[3]) * r;
+    out[1] = (-a[1] * c[5] + a[2] * c[4] - a[3] * c[3]) * r;
+    out[2] = (a[13] * s[5] - a[14] * s[4] + a[15] * s[3]) * r;
+    out[3] = (-a[9] * s[5] + a[10] * s[4] - a[11] * s[3]) * r;
+    out[4] = (-a[4] * c[5] + a[6] * c[2] - a[7] * c[1]) * r;
+    out[5] = (a[0] * c[5] - a[2] * c[2] + a[3] * c[1]) * r;
+    out[6] = (-a[12] * s[5] + a[14] * s[2] - a[15] * s[1]) * r;
+    out[7] = (a[8] * s[5] - a[10] * s[2] + a[11] * s[1]) * r;
+    out[8] = (a[4] * c[4] - a[5] * c[2] + a[7] * c[0]) * r;
+    out[9] = (-a[0] * c[4] + a[1] * c[2] - a[3] * c[0]) * r;
+    out[10] = (a[12] * s[4] - a[13] * s[2] + a[15] * s[0]) * r;
+    out[11] = (-a[8] * s[4] + a[9] * s[2] - a[11] * s[0]) * r;
+    out[12] = (-a[4] * c[3] + a[5] * c[1] - a[6] * c[0]) * r;
+    out[13] = (a[0] * c[3] - a[1] * c[1] + a[2] * c[0]) * r;
+    out[14] = (-a[12] * s[3] + a[13] * s[1] - a[14] * s[0]) * r;
+    out[15] = (a[8] * s[3] - a[9] * s[1] + a[10] * s[0]) * r;
+  }
+};
+
+}  // namespace s21
+
+// R x C matrix stored inline (no heap, no padding), for the small transforms
+// where S21Matrix spends more on allocation than on arithmetic. The API
+// mirrors S21Matrix and every operation is constexpr, so matrices known at
+// compile time are folded completely.
+template <int R, int C, class T = double>
+class S21FixedMatrix {
+  static_assert(R > 0 && C > 0, "Invalid matrix");
+
+ public:
+  using Scalar = T;
+
+  constexpr S21FixedMatrix() noexcept : matrix_{} {}
+  // Row-major values; missing ones are zero.
+  constexpr S21FixedMatrix(std::initializer_list<T> values) : matrix_{} {
+    if (values.size() > static_cast<std::size_t>(R * C))
+      throw std::out_of_range("Invalid matrix");
+    int n = 0;
+    for (T value : values) matrix_[n++] = value;
+  }
+  template <class U>
+  explicit S21FixedMatrix(const S21BasicMatrix<U>& other) : matrix_{} {
+    if (other.data() == nullptr)
+      throw std::out_of_range("Invalid matrix");
+    if (other.GetRows() != R || other.GetCols() != C)
+      throw std::invalid_argument("Sizes are not equal");
+    for (int i = 0; i < R; i++) {
+      const U* row =
+          other.data() + static_cast<std::size_t>(i) * other.stride();
+      for (int j = 0; j < C; j++) matrix_[i * C + j] = static_cast<T>(row[j]);
+    }
+  }
+
+  static constexpr S21FixedMatrix Identity() noexcept {
+    static_assert(R == C, "Matrix is not square");
+    S21FixedMatrix result;
+    for (int i = 0; i < R; i++) result.matrix_[i * C + i] = T(1);
+    return result;
+  }
+
+  // A dynamic matrix of the same element type unless U says otherwise.
+  template <class U = T>
+  S21BasicMatrix<U> ToMatrix() const {
+    S21BasicMatrix<U> result(R, C);
+    for (int i = 0; i < R; i++) {
+      U* row = result.data() + static_cast<std::size_t>(i) * result.stride();
+      for (int j = 0; j < C; j++) {
+        row[j] = static_cast<U>(matrix_[i * C + j]);
+      }
+    }
+    return result;
+  }
+
+  static constexpr int GetRows() noexcept { return R; }
+  static constexpr int GetCols() noexcept { return C; }
+  constexpr T* data() noexcept { return matrix_; }
+  constexpr const T* data() const noexcept { return matrix_; }
+
+  constexpr T& operator()(int i, int j) {
+    if (i >= R || j >= C || i < 0 || j < 0)
+      throw std::out_of_range("Invalid index");
+    return matrix_[i * C + j];
+  }
+  constexpr const T& operator()(int i, int j) const {
+    if (i >= R || j >= C || i < 0 || j < 0)
+      throw std::out_of_range("Invalid index");
+    return matrix_[i * C + j];
+  }
+
+  constexpr bool EqMatrix(const S21FixedMatrix& other) const noexcept {
+    return EqMatrix(other, S21Tolerance<T>::kEqual);
+  }
+  constexpr bool EqMatrix(const S21FixedMatrix& other,
+                          T tolerance) const noexcept {
+    for (int n = 0; n < R * C; n++) {
+      if (s21::FixedAbs(matrix_[n] - other.matrix_[n]) > tolerance)
+        return false;
+    }
+    return true;
+  }
+  constexpr void SumMatrix(const S21FixedMatrix& other) noexcept {
+    for (int n = 0; n < R * C; n++) matrix_[n] += other.matrix_[n];
+  }
+  constexpr void SubMatrix(const S21FixedMatrix& other) noexcept {
+    for (int n = 0; n < R * C; n++) matrix_[n] -= other.matrix_[n];
+  }
+  constexpr void MulNumber(const T num) noexcept {
+    for (int n = 0; n < R * C; n++) matrix_[n] *= num;
+  }
+  constexpr void MulMatrix(const S21FixedMatrix<C, C, T>& other) noexcept {
+    *this = Product(other);
+  }
+  template <int K>
+  constexpr S21FixedMatrix<R, K, T> Product(
+      const S21FixedMatrix<C, K, T>& other) const noexcept {
+    S21FixedMatrix<R, K, T> result;
+    s21::FixedProduct<T, C, K>(matrix_, other.data(), result.data(),
+                               std::make_index_sequence<R * K>());
+    return result;
+  }
+
+  constexpr S21FixedMatrix<C, R, T> Transpose() const noexcept {
+    S21FixedMatrix<C, R, T> result;
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) {
+        result.data()[j * R + i] = matrix_[i * C + j];
+      }
+    }
+    return result;
+  }
+
+  constexpr T Determinant() const noexcept {
+    static_assert(R == C, "Matrix is not square");
+    return s21::FixedKernels<R, T>::Determinant(matrix_);
+  }
+
+  constexpr S21FixedMatrix CalcComplements() const noexcept {
+    static_assert(R == C, "Matrix is not square");
+    S21FixedMatrix result;
+    if constexpr (R == 1) {
+      result.matrix_[0] = T(1);
+    } else {
+      for (int i = 0; i < R; i++) {
+        for (int j = 0; j < C; j++) {
+          T minor[(R - 1) * (C - 1)]{};
+          int n = 0;
+          for (int x = 0; x < R; x++) {
+            for (int y = 0; y < C; y++) {
+              if (x != i && y != j) minor[n++] = matrix_[x * C + y];
+            }
+          }
+          T det = s21::FixedKernels<R - 1, T>::Determinant(minor);
+          result.matrix_[i * C + j] = (i + j) % 2 ? -det : det;
+        }
+      }
+    }
+    return result;
+  }
+
+  constexpr S21FixedMatrix InverseMatrix() const {
+    static_assert(R == C, "Matrix is not square");
+    T det = Determinant();
+    if (det == T(0)) throw std::invalid_argument("Determinant equals 0");
+    S21FixedMatrix result;
+    s21::FixedKernels<R, T>::Inverse(matrix_, det, result.matrix_);
+    return result;
+  }
+
+  constexpr S21FixedMatrix& operator+=(const S21FixedMatrix& other) noexcept {
+    SumMatrix(other);
+    return *this;
+  }
+  constexpr S21FixedMatrix& operator-=(const S21FixedMatrix& other) noexcept {
+    SubMatrix(other);
+    return *this;
+  }
+  constexpr S21FixedMatrix& operator*=(
+      const S21FixedMatrix<C, C, T>& other) noexcept {
+    MulMatrix(other);
+    return *this;
+  }
+  constexpr S21FixedMatrix& operator*=(const T num) noexcept {
+    MulNumber(num);
+    return *this;
+  }
+  constexpr bool operator==(const S21FixedMatrix& other) const noexcept {
+    return EqMatrix(other);
+  }
+
+ private:
+  T matrix_[R * C];
+};
+
+template <int R, int C, class T>
+constexpr S21FixedMatrix<R, C, T> operator+(
+    S21FixedMatrix<R, C, T> lhs, const S21FixedMatrix<R, C, T>& rhs) {
+  return lhs += rhs;
+}
+
+template <int R, int C, class T>
+constexpr S21FixedMatrix<R, C, T> operator-(
+    S21FixedMatrix<R, C, T> lhs, const S21FixedMatrix<R, C, T>& rhs) {
+  return lhs -= rhs;
+}
+
+// The scalar takes no part in deduction, so m * 2 works as for S21Matrix.
+template <int R, int C, class T>
+constexpr S21FixedMatrix<R, C, T> operator*(
+    S21FixedMatrix<R, C, T> lhs,
+    const typename S21FixedMatrix<R, C, T>::Scalar num) {
+  return lhs *= num;
+}
+
+template <int R, int C, class T>
+constexpr S21FixedMatrix<R, C, T> operator*(
+    const typename S21FixedMatrix<R, C, T>::Scalar num,
+    S21FixedMatrix<R, C, T> rhs) {
+  return rhs *= num;
+}
+
+template <int R, int C, int K, class T>
+constexpr S21FixedMatrix<R, K, T> operator*(
+    const S21FixedMatrix<R, C, T>& lhs, const S21FixedMatrix<C, K, T>& rhs) {
+  return lhs.Product(rhs);
+}
+
+using S21Matrix2 = S21FixedMatrix<2, 2>;
+using S21Matrix3 = S21FixedMatrix<3, 3>;
+using S21Matrix4 = S21FixedMatrix<4, 4>;
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_FIXED_MATRIX_H
@@ -0,0 +1,371 @@
+#include "s21_gemm.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+namespace s21 {
+
+namespace {
+
+// Per-thread packing buffers, one per nesting level: a thread that waits for
+// its own parallel GEMM may run a task that starts another GEMM, and that
+// one must not overwrite the panels still being read.
+template <class Acc>
+class PackBuffer {
+ public:
+  // The level is taken only once the buffer exists, so a throwing resize
+  // leaves the depth as it was.
+  explicit PackBuffer(std::size_t size) : level_(Depth()) {
+    std::vector<std::vector<Acc>>& buffers = Buffers();
+    if (buffers.size() <= level_) buffers.resize(level_ + 1);
+    buffers[level_].resize(size);
+    data_ = buffers[level_].data();
+    Depth()++;
+  }
+  PackBuffer(const PackBuffer&) = delete;
+  PackBuffer& operator=(const PackBuffer&) = delete;
+  ~PackBuffer() { Depth()--; }
+
+  Acc* data() const noexcept { return data_; }
+
+ private:
+  std::size_t level_;
+  Acc* data_;
+
+  static std::size_t& Depth() {
+    thread_local std::size_t depth = 0;
+    return depth;
+  }
+  static std::vector<std::vector<Acc>>& Buffers() {
+    thread_local std::vector<std::vector<Acc>> buffers;
+    return buffers;
+  }
+};
+
+// Copies an mc x kc block of A into MR-row panels. Inside a panel the MR
+// values of one column are adjacent, which is the order the micro-kernel
+// consumes them in. Missing rows of the last panel are zero-filled.
+template <class T, class Acc>
+void PackA(int mc, int kc, const T* a, int rsa, int csa, Acc* ap) {
+  for (int ir = 0; ir < mc; ir += kGemmMR) {
+    int mr = std::min(kGemmMR, mc - ir);
+    for (int p = 0; p < kc; p++) {
+      const T* src = a + static_cast<std::ptrdiff_t>(ir) * rsa +
+                          static_cast<std::ptrdiff_t>(p) * csa;
+      for (int i = 0; i < mr; i++) ap[i] = src[i * rsa];
+      for (int i = mr; i < kGemmMR; i++) ap[i] = 0.;
+      ap += kGemmMR;
+    }
+  }
+}
+
+// Copies a kc x nc panel of B into NR-column slivers, zero-filling the
+// missing columns of the last sliver.
+template <class T, class Acc>
+void PackB(int kc, int nc, const T* b, int rsb, int csb, Acc* bp) {
+  for (int jr = 0; jr < nc; jr += kGemmNR) {
+    int nr = std::min(kGemmNR, nc - jr);
+    for (int p = 0; p < kc; p++) {
+      const T* src = b + static_cast<std::ptrdiff_t>(p) * rsb +
+                          static_cast<std::ptrdiff_t>(jr) * csb;
+      if (csb == 1) {
+        for (int j = 0; j < nr; j++) bp[j] = src[j];
+      } else {
+        for (int j = 0; j < nr; j++) bp[j] = src[j * csb];
+      }
+      for (int j = nr; j < kGemmNR; j++) bp[j] = 0.;
+      bp += kGemmNR;
+    }
+  }
+}
+
+// Computes the MR x NR product of one packed A panel and one packed B sliver
+// in a register-resident accumulator and merges the mr x nr valid part of it
+// into C.
+template <class T, class Acc>
+void MicroKernel(int kc, Acc alpha, const Acc* ap, const Acc* bp, Acc beta,
+                 T* c, int rsc, int csc, int mr, int nr) {
+  Acc ab[kGemmMR][kGemmNR] = {};
+  for (int p = 0; p < kc; p++) {
+    for (int i = 0; i < kGemmMR; i++) {
+      const Acc a = ap[i];
+      for (int j = 0; j < kGemmNR; j++) ab[i][j] += a * bp[j];
+    }
+    ap += kGemmMR;
+    bp += kGemmNR;
+  }
+  for (int i = 0; i < mr; i++) {
+    T* row = c + static_cast<std::ptrdiff_t>(i) * rsc;
+    for (int j = 0; j < nr; j++) {
+      T& dst = row[static_cast<std::ptrdiff_t>(j) * csc];
+      if (beta == Acc(0))
+        dst = static_cast<T>(alpha * ab[i][j]);
+      else
+        dst = static_cast<T>(beta * dst + alpha * ab[i][j]);
+    }
+  }
+}
+
+template <class T, class Acc>
+void ScaleC(int m, int n, Acc beta, T* c, int rsc, int csc) {
+  for (int i = 0; i < m; i++) {
+    T* row = c + static_cast<std::ptrdiff_t>(i) * rsc;
+    for (int j = 0; j < n; j++) {
+      T& dst = row[static_cast<std::ptrdiff_t>(j) * csc];
+      dst = beta == Acc(0) ? T(0) : static_cast<T>(beta * dst);
+    }
+  }
+}
+
+// x itself when its elements are adjacent, otherwise a copy in buffer.
+template <class T>
+const T* Packed(int n, const T* x, int inc, T* buffer) {
+  if (inc == 1) return x;
+  for (int j = 0; j < n; j++)
+    buffer[j] = x[static_cast<std::ptrdiff_t>(j) * inc];
+  return buffer;
+}
+
+// The blocked product proper; C may be held in a wider type than A and B.
+template <class T, class Acc, class TC>
+void GemmBlocked(int m, int n, int k, Acc alpha, const T* a, int rsa, int csa,
+                 const T* b, int rsb, int csb, Acc beta, TC* c, int rsc,
+                 int csc) {
+  PackBuffer<Acc> b_pack(static_cast<std::size_t>(kGemmKC) *
+                         ((std::min(n, kGemmNC) + kGemmNR - 1) / kGemmNR *
+                          kGemmNR));
+  const int m_blocks = (m + kGemmMC - 1) / kGemmMC;
+  const int threads = ThreadPool::Instance().GetThreadCount();
+
+  for (int jc = 0; jc < n; jc += kGemmNC) {
+    int nc = std::min(kGemmNC, n - jc);
+    int slivers = (nc + kGemmNR - 1) / kGemmNR;
+    // Split the columns as well when there are too few row blocks to keep
+    // every thread busy; each task then repacks its own A block.
+    int groups = std::min(slivers, std::max(1, 2 * threads / m_blocks));
+    for (int pc = 0; pc < k; pc += kGemmKC) {
+      int kc = std::min(kGemmKC, k - pc);
+      Acc beta_pc = pc == 0 ? beta : Acc(1);
+      PackB(kc, nc,
+            b + static_cast<std::ptrdiff_t>(pc) * rsb +
+                static_cast<std::ptrdiff_t>(jc) * csb,
+            rsb, csb, b_pack.data());
+      std::ptrdiff_t task_work = static_cast<std::ptrdiff_t>(kGemmMC) * kc *
+                                 (slivers / groups + 1) * kGemmNR;
+      ParallelFor(
+          static_cast<std::ptrdiff_t>(m_blocks) * groups,
+          ParallelGrain(task_work),
+          [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+            PackBuffer<Acc> a_pack(static_cast<std::size_t>(kGemmMC) * kc);
+            for (std::ptrdiff_t task = begin; task < end; task++) {
+              int ic = static_cast<int>(task / groups) * kGemmMC;
+              int group = static_cast<int>(task % groups);
+              int mc = std::min(kGemmMC, m - ic);
+              int jr_begin = slivers * group / groups * kGemmNR;
+              int jr_end = std::min(nc, slivers * (group + 1) / groups *
+                                            kGemmNR);
+              PackA(mc, kc,
+                    a + static_cast<std::ptrdiff_t>(ic) * rsa +
+                        static_cast<std::ptrdiff_t>(pc) * csa,
+                    rsa, csa, a_pack.data());
+              for (int jr = jr_begin; jr < jr_end; jr += kGemmNR) {
+                int nr = std::min(kGemmNR, nc - jr);
+                for (int ir = 0; ir < mc; ir += kGemmMR) {
+                  int mr = std::min(kGemmMR, mc - ir);
+                  TC* c_tile =
+                      c + static_cast<std::ptrdiff_t>(ic + ir) * rsc +
+                      static_cast<std::ptrdiff_t>(jc + jr) * csc;
+                  MicroKernel(kc, alpha, a_pack.data() + ir * kc,
+                              b_pack.data() + jr * kc, beta_pc, c_tile, rsc,
+                              csc, mr, nr);
+                }
+              }
+            }
+          });
+    }
+  }
+}
+
+}  // namespace
+
+template <class T, class Acc>
+void Gemm(int m, int n, int k, typename GemmScalar<Acc>::Type alpha,
+          const T* a, int rsa, int csa, const T* b, int rsb, int csb,
+          typename GemmScalar<Acc>::Type beta, T* c, int rsc, int csc) {
+  if (m <= 0 || n <= 0) return;
+  if (k <= 0 || alpha == Acc(0)) {
+    if (beta != Acc(1)) ScaleC(m, n, beta, c, rsc, csc);
+    return;
+  }
+  if constexpr (std::is_same_v<T, Acc>) {
+    if (n == 1) {
+      Gemv<T>(m, k, alpha, a, rsa, csa, b, rsb, beta, c, rsc);
+      return;
+    }
+    if (m == 1) {
+      Gemv<T>(n, k, alpha, b, csb, rsb, a, csa, beta, c, csc);
+      return;
+    }
+    if (k == 1) {
+      if (beta != Acc(1)) ScaleC(m, n, beta, c, rsc, csc);
+      Ger<T>(m, n, alpha, a, rsa, b, csb, c, rsc, csc);
+      return;
+    }
+  }
+  if (std::is_same<T, Acc>::value || k <= kGemmKC) {
+    GemmBlocked(m, n, k, alpha, a, rsa, csa, b, rsb, csb, beta, c, rsc, csc);
+    return;
+  }
+  // A wider accumulator would be rounded to T after every KC panel, so the
+  // whole C is kept in Acc and rounded once.
+  std::vector<Acc> wide(static_cast<std::size_t>(m) * n);
+  if (beta != Acc(0)) {
+    for (int i = 0; i < m; i++) {
+      for (int j = 0; j < n; j++) {
+        wide[static_cast<std::size_t>(i) * n + j] =
+            beta * c[static_cast<std::ptrdiff_t>(i) * rsc +
+                     static_cast<std::ptrdiff_t>(j) * csc];
+      }
+    }
+  }
+  GemmBlocked(m, n, k, alpha, a, rsa, csa, b, rsb, csb, Acc(1), wide.data(),
+              n, 1);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      c[static_cast<std::ptrdiff_t>(i) * rsc +
+        static_cast<std::ptrdiff_t>(j) * csc] =
+          static_cast<T>(wide[static_cast<std::size_t>(i) * n + j]);
+    }
+  }
+}
+
+template <class T>
+void Gemv(int m, int n, T alpha, const T* a, int rsa, int csa, const T* x,
+          int incx, T beta, T* y, int incy) {
+  if (m <= 0) return;
+  if (n <= 0 || alpha == T(0)) {
+    if (beta != T(1)) ScaleC(m, 1, beta, y, incy, 1);
+    return;
+  }
+  const BasicSimdKernels<T>& simd = Simd<T>();
+  if (csa != 1 && rsa == 1) {
+    // Column-major A: each task adds every column to its own rows of y,
+    // kept contiguous in a per-thread copy when incy is not 1.
+    ParallelFor(m, ParallelGrain(2 * static_cast<std::ptrdiff_t>(n)),
+                [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                  const int rows = static_cast<int>(end - begin);
+                  PackBuffer<T> y_pack(incy == 1 ? 0 : rows);
+                  T* block = y + begin * incy;
+                  T* sum = incy == 1 ? block : y_pack.data();
+                  if (beta == T(0)) {
+                    simd.fill(sum, rows, T(0));
+                  } else {
+                    Packed(rows, block, incy, sum);
+                    if (beta != T(1)) simd.scale(sum, beta, sum, rows);
+                  }
+                  for (int j = 0; j < n; j++) {
+                    simd.axpy(alpha * x[static_cast<std::ptrdiff_t>(j) * incx],
+                              a + static_cast<std::ptrdiff_t>(j) * csa + begin,
+                              sum, rows);
+                  }
+                  if (incy == 1) return;
+                  for (int i = 0; i < rows; i++)
+                    block[static_cast<std::ptrdiff_t>(i) * incy] = sum[i];
+                });
+    return;
+  }
+  PackBuffer<T> x_pack(incx == 1 ? 0 : n);
+  const T* xs = Packed(n, x, incx, x_pack.data());
+  ParallelFor(m, ParallelGrain(2 * static_cast<std::ptrdiff_t>(n)),
+              [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                for (std::ptrdiff_t i = begin; i < end; i++) {
+                  T& dst = y[i * incy];
+                  for (int pc = 0; pc < n; pc += kGemmKC) {
+                    const int kc = std::min(kGemmKC, n - pc);
+                    const T* row = a + i * rsa +
+                                   static_cast<std::ptrdiff_t>(pc) * csa;
+                    T sum = T(0);
+                    if (csa == 1) {
+                      sum = simd.dot(row, xs + pc, kc);
+                    } else {
+                      for (int j = 0; j < kc; j++) {
+                        sum += row[static_cast<std::ptrdiff_t>(j) * csa] *
+                               xs[pc + j];
+                      }
+                    }
+                    const T beta_pc = pc == 0 ? beta : T(1);
+                    dst = beta_pc == T(0) ? alpha * sum
+                                          : beta_pc * dst + alpha * sum;
+                  }
+                }
+              });
+}
+
+template <class T>
+void Ger(int m, int n, T alpha, const T* x, int incx, const T* y, int incy,
+         T* a, int rsa, int csa) {
+  if (m <= 0 || n <= 0 || alpha == T(0)) return;
+  const BasicSimdKernels<T>& simd = Simd<T>();
+  if (csa != 1 && rsa == 1) {
+    PackBuffer<T> x_pack(incx == 1 ? 0 : m);
+    const T* xs = Packed(m, x, incx, x_pack.data());
+    ParallelFor(n, ParallelGrain(2 * static_cast<std::ptrdiff_t>(m)),
+                [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                  for (std::ptrdiff_t j = begin; j < end; j++)
+                    simd.axpy(alpha * y[j * incy], xs, a + j * csa, m);
+                });
+    return;
+  }
+  PackBuffer<T> y_pack(incy == 1 ? 0 : n);
+  const T* ys = Packed(n, y, incy, y_pack.data());
+  ParallelFor(m, ParallelGrain(2 * static_cast<std::ptrdiff_t>(n)),
+              [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                for (std::ptrdiff_t i = begin; i < end; i++) {
+                  T* row = a + i * rsa;
+                  const T scale = alpha * x[i * incx];
+                  if (csa == 1) {
+                    simd.axpy(scale, ys, row, n);
+                    continue;
+                  }
+                  for (int j = 0; j < n; j++)
+                    row[static_cast<std::ptrdiff_t>(j) * csa] += scale * ys[j];
+                }
+              });
+}
+
+template void Gemm<float, float>(int, int, int, float, const float*, int, int,
+                                 const float*, int, int, float, float*, int,
+                                 int);
+template void Gemm<double, double>(int, int, int, double, const double*, int,
+                                   int, const double*, int, int, double,
+                                   double*, int, int);
+template void Gemm<long double, long double>(int, int, int, long double,
+                                             const long double*, int, int,
+                                             const long double*, int, int,
+                                             long double, long double*, int,
+                                             int);
+template void Gemm<float, double>(int, int, int, double, const float*, int,
+                                  int, const float*, int, int, double, float*,
+                                  int, int);
+
+template void Gemv<float>(int, int, float, const float*, int, int,
+                          const float*, int, float, float*, int);
+template void Gemv<double>(int, int, double, const double*, int, int,
+                           const double*, int, double, double*, int);
+template void Gemv<long double>(int, int, long double, const long double*,
+                                int, int, const long double*, int,
+                                long double, long double*, int);
+template void Ger<float>(int, int, float, const float*, int, const float*,
+                         int, float*, int, int);
+template void Ger<double>(int, int, double, const double*, int,
+                          const double*, int, double*, int, int);
+template void Ger<long double>(int, int, long double, const long double*, int,
+                               const long double*, int, long double*, int,
+                               int);
+
+}  // namespace s21
@@ -0,0 +1,86 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_GEMM_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_GEMM_H
+
+namespace s21 {
+
+// Blocking parameters of the packed GEMM (GotoBLAS layout): an MR x NR tile
+// of C lives in registers, a KC x NR sliver of B stays in L1, an MC x KC
+// block of A in L2 and a KC x NC panel of B in L3.
+constexpr int kGemmMR = 4;
+constexpr int kGemmNR = 8;
+constexpr int kGemmKC = 256;
+constexpr int kGemmMC = 96;
+constexpr int kGemmNC = 2048;
+
+// C := alpha * A * B + beta * C, where A is m x k, B is k x n and C is m x n.
+// Every operand is addressed through a row stride and a column stride, so a
+// transposed operand is passed by swapping its strides. When beta is 0, C is
+// not read. The panels of A and B are packed in Acc and the products are
+// accumulated in it, so Gemm<float, double> reads and writes float matrices
+// with double accumulation and rounds each element of C once. alpha and
+// beta take no part in deduction, so Acc is T unless it is named explicitly.
+// With Acc equal to T, a C of one row or column goes to Gemv and k == 1 to
+// Ger, which need no packing.
+template <class T>
+struct GemmScalar {
+  using Type = T;
+};
+
+template <class T, class Acc = T>
+void Gemm(int m, int n, int k, typename GemmScalar<Acc>::Type alpha,
+          const T* a, int rsa, int csa, const T* b, int rsb, int csb,
+          typename GemmScalar<Acc>::Type beta, T* c, int rsc, int csc);
+
+extern template void Gemm<float, float>(int, int, int, float, const float*,
+                                        int, int, const float*, int, int,
+                                        float, float*, int, int);
+extern template void Gemm<double, double>(int, int, int, double,
+                                          const double*, int, int,
+                                          const double*, int, int, double,
+                                          double*, int, int);
+extern template void Gemm<long double, long double>(
+    int, int, int, long double, const long double*, int, int,
+    const long double*, int, int, long double, long double*, int, int);
+extern template void Gemm<float, double>(int, int, int, double, const float*,
+                                         int, int, const float*, int, int,
+                                         double, float*, int, int);
+
+// y := alpha * A * x + beta * y for an m x n A, an n-element x and an
+// m-element y, whose consecutive elements are incx and incy apart. When
+// beta is 0, y is not read. Rows of A are reduced in kGemmKC panels, each
+// merged into y like a panel of the blocked GEMM, with the dot kernel when
+// the column stride is 1; a column-major A adds its columns to y with axpy.
+// Either way a product split in k at multiples of kGemmKC and accumulated
+// through beta = 1 gives the same bits. Rows of y are split across the
+// thread pool, and each element is summed in the same order whatever the
+// thread count.
+template <class T>
+void Gemv(int m, int n, T alpha, const T* a, int rsa, int csa, const T* x,
+          int incx, T beta, T* y, int incy);
+
+// A := A + alpha * x * y^T for an m x n A, an m-element x and an n-element
+// y (GER). Each row, or each column when A is column-major, gets one axpy.
+template <class T>
+void Ger(int m, int n, T alpha, const T* x, int incx, const T* y, int incy,
+         T* a, int rsa, int csa);
+
+extern template void Gemv<float>(int, int, float, const float*, int, int,
+                                 const float*, int, float, float*, int);
+extern template void Gemv<double>(int, int, double, const double*, int, int,
+                                  const double*, int, double, double*, int);
+extern template void Gemv<long double>(int, int, long double,
+                                       const long double*, int, int,
+                                       const long double*, int, long double,
+                                       long double*, int);
+extern template void Ger<float>(int, int, float, const float*, int,
+                                const float*, int, float*, int, int);
+extern template void Ger<double>(int, int, double, const double*, int,
+                                 const double*, int, double*, int, int);
+extern template void Ger<long double>(int, int, long double,
+                                      const long double*, int,
+                                      const long double*, int, long double*,
+                                      int, int);
+
+}  // namespace s21
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_GEMM_H
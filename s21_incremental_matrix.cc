@@ -0,0 +1,164 @@
+#include "s21_incremental_matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+template <class T>
+S21BasicIncrementalMatrix<T>::S21BasicIncrementalMatrix(
+    S21BasicMatrixView<const T> matrix)
+    : matrix_(matrix),
+      lu_(matrix_),
+      determinant_(lu_.Determinant()),
+      condition_(ConditionEstimate()),
+      updates_(0),
+      factorizations_(1) {}
+
+template <class T>
+int S21BasicIncrementalMatrix<T>::GetSize() const noexcept {
+  return lu_.GetSize();
+}
+
+template <class T>
+const S21BasicMatrix<T>& S21BasicIncrementalMatrix<T>::GetMatrix()
+    const noexcept {
+  return matrix_;
+}
+
+template <class T>
+const S21BasicLU<T>& S21BasicIncrementalMatrix<T>::GetLU() const noexcept {
+  return lu_;
+}
+
+template <class T>
+int S21BasicIncrementalMatrix<T>::GetFactorizations() const noexcept {
+  return factorizations_;
+}
+
+template <class T>
+T S21BasicIncrementalMatrix<T>::ConditionEstimate() const noexcept {
+  const S21BasicMatrixView<const T> factors = lu_.GetFactors().View();
+  T largest = 0, smallest = std::numeric_limits<T>::infinity();
+  for (int i = 0; i < GetSize(); i++) {
+    const T pivot = std::abs(factors.Row(i)[i]);
+    largest = std::max(largest, pivot);
+    smallest = std::min(smallest, pivot);
+  }
+  if (smallest == 0) return std::numeric_limits<T>::infinity();
+  return largest / smallest;
+}
+
+template <class T>
+void S21BasicIncrementalMatrix<T>::Update(S21BasicMatrixView<const T> u,
+                                          S21BasicMatrixView<const T> v) {
+  if (u.Empty() || v.Empty()) throw std::out_of_range("Invalid matrix");
+  const int size = GetSize();
+  if (u.GetRows() != size || v.GetRows() != size ||
+      v.GetCols() != u.GetCols())
+    throw std::invalid_argument("Sizes are not equal");
+  s21::Gemm<T>(1, u, v.Transposed(), 1, matrix_);
+  _Update(u, v);
+}
+
+template <class T>
+void S21BasicIncrementalMatrix<T>::SetRow(int i,
+                                          S21BasicMatrixView<const T> row) {
+  const int size = GetSize();
+  if (i < 0 || i >= size) throw std::out_of_range("Invalid index");
+  if (row.GetRows() != 1 || row.GetCols() != size)
+    throw std::invalid_argument("Sizes are not equal");
+  S21BasicMatrix<T> unit(size, 1), delta(size, 1);
+  unit(i, 0) = 1;
+  for (int j = 0; j < size; j++) {
+    delta(j, 0) = row(0, j) - matrix_(i, j);
+    matrix_(i, j) = row(0, j);
+  }
+  _Update(unit, delta);
+}
+
+template <class T>
+void S21BasicIncrementalMatrix<T>::SetCol(int j,
+                                          S21BasicMatrixView<const T> col) {
+  const int size = GetSize();
+  if (j < 0 || j >= size) throw std::out_of_range("Invalid index");
+  if (col.GetRows() != size || col.GetCols() != 1)
+    throw std::invalid_argument("Sizes are not equal");
+  S21BasicMatrix<T> delta(size, 1), unit(size, 1);
+  for (int i = 0; i < size; i++) {
+    delta(i, 0) = col(i, 0) - matrix_(i, j);
+    matrix_(i, j) = col(i, 0);
+  }
+  unit(j, 0) = 1;
+  _Update(delta, unit);
+}
+
+template <class T>
+void S21BasicIncrementalMatrix<T>::_Update(S21BasicMatrixView<const T> u,
+                                           S21BasicMatrixView<const T> v) {
+  if (lu_.IsSingular()) {
+    Refactorize();
+    return;
+  }
+  const int size = GetSize(), rank = u.GetCols();
+  const S21BasicMatrixView<const T> vt = v.Transposed();
+
+  // A^-1 U from the inverse when there is one, and the capacitance matrix.
+  S21BasicMatrix<T> solved =
+      inverse_ ? S21BasicMatrix<T>(size, rank) : lu_.Solve(u);
+  if (inverse_) s21::Gemm<T>(1, *inverse_, u, 0, solved);
+  S21BasicMatrix<T> capacitance(rank, rank);
+  s21::Gemm<T>(1, vt, solved, 0, capacitance);
+  for (int i = 0; i < rank; i++) capacitance(i, i) += 1;
+  const S21BasicLU<T> capacitance_lu(capacitance);
+  determinant_ *= capacitance_lu.Determinant();
+
+  updates_ += rank;
+  bool current = !capacitance_lu.IsSingular() && updates_ < size;
+  for (int j = 0; current && j < rank; j++)
+    current = lu_.Update(u.ColRange(j, j + 1), v.ColRange(j, j + 1));
+  if (!current || ConditionEstimate() > kConditionDrift * condition_) {
+    Refactorize();
+    return;
+  }
+  if (inverse_) {
+    S21BasicMatrix<T> projected(rank, size);
+    s21::Gemm<T>(1, vt, *inverse_, 0, projected);
+    s21::Gemm<T>(-1, solved, capacitance_lu.Solve(projected), 1, *inverse_);
+  }
+}
+
+template <class T>
+void S21BasicIncrementalMatrix<T>::Refactorize() {
+  lu_ = S21BasicLU<T>(matrix_);
+  determinant_ = lu_.Determinant();
+  condition_ = ConditionEstimate();
+  updates_ = 0;
+  factorizations_++;
+  if (!inverse_) return;
+  if (lu_.IsSingular()) {
+    inverse_.reset();
+  } else {
+    inverse_ = lu_.Inverse();
+  }
+}
+
+template <class T>
+T S21BasicIncrementalMatrix<T>::Determinant() const noexcept {
+  return determinant_;
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicIncrementalMatrix<T>::Solve(
+    S21BasicMatrixView<const T> b) const {
+  return lu_.Solve(b);
+}
+
+template <class T>
+const S21BasicMatrix<T>& S21BasicIncrementalMatrix<T>::Inverse() {
+  if (!inverse_) inverse_ = lu_.Inverse();
+  return *inverse_;
+}
+
+template class S21BasicIncrementalMatrix<float>;
+template class S21BasicIncrementalMatrix<double>;
+template class S21BasicIncrementalMatrix<long double>;
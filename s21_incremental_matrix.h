@@ -0,0 +1,73 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_INCREMENTAL_MATRIX_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_INCREMENTAL_MATRIX_H
+
+#include <optional>
+
+#include "s21_lu.h"
+#include "s21_matrix.h"
+
+// A square matrix that keeps its LU factorization, its determinant and,
+// once asked for, its inverse current under low-rank changes. Changing k
+// rows, columns or rank-1 terms costs O(n^2 k) rather than the O(n^3) of a
+// new factorization:
+//   - the factors follow by S21BasicLU::Update,
+//   - the determinant by the matrix determinant lemma,
+//     det(A + U V^T) = det(I + V^T A^-1 U) det(A),
+//   - the inverse by the Sherman-Morrison-Woodbury formula,
+//     (A + U V^T)^-1 = A^-1 - A^-1 U (I + V^T A^-1 U)^-1 V^T A^-1.
+// Rounding errors of the updates accumulate, so the matrix is factored
+// again from scratch when an LU update loses stability, when the capacitance
+// matrix I + V^T A^-1 U is singular, when the condition estimate has grown
+// kConditionDrift times since the last factorization, or after n rank-1
+// updates, which keeps the amortized cost of a step at O(n^2).
+template <class T>
+class S21BasicIncrementalMatrix {
+ public:
+  static constexpr int kConditionDrift = 1000;
+
+  explicit S21BasicIncrementalMatrix(S21BasicMatrixView<const T> matrix);
+
+  int GetSize() const noexcept;
+  const S21BasicMatrix<T>& GetMatrix() const noexcept;
+  const S21BasicLU<T>& GetLU() const noexcept;
+  // Full factorizations so far, the one of the constructor included.
+  int GetFactorizations() const noexcept;
+  // max |u_ii| / min |u_ii| over the pivots of U, a cheap lower bound of
+  // the condition number; infinite for a singular matrix.
+  T ConditionEstimate() const noexcept;
+
+  // A += U * V^T for n x k U and V.
+  void Update(S21BasicMatrixView<const T> u, S21BasicMatrixView<const T> v);
+  // Replaces row i (a 1 x n view) or column j (an n x 1 view) of A.
+  void SetRow(int i, S21BasicMatrixView<const T> row);
+  void SetCol(int j, S21BasicMatrixView<const T> col);
+  void Refactorize();
+
+  T Determinant() const noexcept;
+  S21BasicMatrix<T> Solve(S21BasicMatrixView<const T> b) const;
+  // Computed by the factors on the first call, then kept current. Throws
+  // for a singular matrix.
+  const S21BasicMatrix<T>& Inverse();
+
+ private:
+  S21BasicMatrix<T> matrix_;
+  S21BasicLU<T> lu_;
+  std::optional<S21BasicMatrix<T>> inverse_;
+  T determinant_;
+  // ConditionEstimate() at the last factorization.
+  T condition_;
+  int updates_;
+  int factorizations_;
+
+  // Brings the factors, the determinant and the inverse up to date with
+  // matrix_, which has just had U * V^T added.
+  void _Update(S21BasicMatrixView<const T> u, S21BasicMatrixView<const T> v);
+};
+
+using S21IncrementalMatrix = S21BasicIncrementalMatrix<double>;
+
+extern template class S21BasicIncrementalMatrix<float>;
+extern template class S21BasicIncrementalMatrix<double>;
+extern template class S21BasicIncrementalMatrix<long double>;
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_INCREMENTAL_MATRIX_H
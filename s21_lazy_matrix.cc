@@ -0,0 +1,517 @@
+#include "s21_lazy_matrix.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_view.h"
+#include "s21_simd.h"
+#include "s21_strassen.h"
+#include "s21_thread_pool.h"
+
+namespace s21 {
+
+template <class T>
+struct LazyNode {
+  enum class Kind { kMatrix, kTranspose, kScale, kSum, kDifference, kProduct };
+
+  Kind kind;
+  int rows;
+  int cols;
+  const S21BasicMatrix<T>* matrix;
+  T num;
+  std::shared_ptr<const LazyNode> lhs;
+  std::shared_ptr<const LazyNode> rhs;
+};
+
+}  // namespace s21
+
+namespace {
+
+template <class T>
+using Node = s21::LazyNode<T>;
+template <class T>
+using ConstView = S21BasicMatrixView<const T>;
+template <class T>
+using View = S21BasicMatrixView<T>;
+
+template <class T>
+struct Sum;
+
+// A recorded matrix, or a sum that is materialized to take part in a
+// product, read as it is or transposed.
+template <class T>
+struct Factor {
+  const S21BasicMatrix<T>* matrix;
+  std::shared_ptr<const Sum<T>> sum;
+  bool transposed;
+  int rows;
+  int cols;
+  // Identifies the matrix or the sum; Key() adds the transposition.
+  std::string base;
+
+  std::string Key() const { return transposed ? base + "'" : base; }
+  Factor Flipped() const {
+    Factor flipped = *this;
+    flipped.transposed = !transposed;
+    std::swap(flipped.rows, flipped.cols);
+    return flipped;
+  }
+};
+
+// coef * F1 * ... * Fk; a transposed term adds its value to the transpose
+// of the sum, which is how a chain and its transpose share one key.
+template <class T>
+struct Term {
+  T coef;
+  std::vector<Factor<T>> factors;
+  bool transposed;
+  std::string key;
+};
+
+template <class T>
+struct Sum {
+  int rows;
+  int cols;
+  std::vector<Term<T>> terms;
+  std::string key;
+};
+
+template <class T>
+std::string ChainKey(const std::vector<Factor<T>>& factors, int begin,
+                     int end) {
+  std::string key;
+  for (int i = begin; i < end; i++) {
+    if (i > begin) key += '*';
+    key += factors[i].Key();
+  }
+  return key;
+}
+
+// The key under which the product of [begin, end) and its transpose are
+// both kept: the smaller of its chain key and that of the turned-around
+// chain; flipped tells which one it is.
+template <class T>
+std::string SharedKey(const std::vector<Factor<T>>& factors, int begin,
+                      int end, bool* flipped = nullptr) {
+  std::string key = ChainKey(factors, begin, end);
+  std::string turned;
+  for (int i = end - 1; i >= begin; i--) {
+    if (i < end - 1) turned += '*';
+    turned += factors[i].Flipped().Key();
+  }
+  const bool smaller = turned < key;
+  if (flipped != nullptr) *flipped = smaller;
+  return smaller ? turned : key;
+}
+
+template <class T>
+std::string CoefKey(T coef) {
+  char buffer[64];
+  std::snprintf(buffer, sizeof(buffer), "%La",
+                static_cast<long double>(coef));
+  return buffer;
+}
+
+// Keys a sum by the coefficients and chains of its terms.
+template <class T>
+void KeySum(Sum<T>& sum) {
+  sum.key.clear();
+  for (const Term<T>& term : sum.terms) {
+    if (!sum.key.empty()) sum.key += '+';
+    sum.key += CoefKey(term.coef) + (term.transposed ? "^[" : "[") +
+               term.key + ']';
+  }
+}
+
+// Keys the chain of a term, turned around when its transpose has the
+// smaller key, and merges terms with equal chains.
+template <class T>
+void Finish(Sum<T>& sum) {
+  std::vector<Term<T>> terms;
+  for (Term<T>& term : sum.terms) {
+    const int count = static_cast<int>(term.factors.size());
+    term.key = ChainKey(term.factors, 0, count);
+    std::vector<Factor<T>> flipped;
+    for (int i = count - 1; i >= 0; i--)
+      flipped.push_back(term.factors[i].Flipped());
+    std::string flipped_key = ChainKey(flipped, 0, count);
+    if (flipped_key < term.key) {
+      term.factors = std::move(flipped);
+      term.key = std::move(flipped_key);
+      term.transposed = !term.transposed;
+    }
+    auto same = std::find_if(terms.begin(), terms.end(), [&](const Term<T>& t) {
+      return t.key == term.key && t.transposed == term.transposed;
+    });
+    if (same != terms.end()) {
+      same->coef += term.coef;
+    } else {
+      terms.push_back(std::move(term));
+    }
+  }
+  sum.terms = std::move(terms);
+  KeySum(sum);
+}
+
+// Turns sum into its transpose, which has the same terms added the other
+// way round.
+template <class T>
+void FlipSum(Sum<T>& sum) {
+  for (Term<T>& term : sum.terms) term.transposed = !term.transposed;
+  std::swap(sum.rows, sum.cols);
+  KeySum(sum);
+}
+
+// Rewrites the graph of node, or of its transpose, as a sum of terms.
+template <class T>
+Sum<T> Canonical(const Node<T>& node, bool transposed) {
+  using Kind = typename Node<T>::Kind;
+  const int rows = transposed ? node.cols : node.rows;
+  const int cols = transposed ? node.rows : node.cols;
+  switch (node.kind) {
+    case Kind::kMatrix: {
+      const std::string base =
+          'm' + std::to_string(reinterpret_cast<std::uintptr_t>(node.matrix));
+      Factor<T> factor{node.matrix, nullptr, transposed, rows, cols, base};
+      return {rows, cols, {{T(1), {factor}, false, ""}}, ""};
+    }
+    case Kind::kTranspose:
+      return Canonical(*node.lhs, !transposed);
+    case Kind::kScale: {
+      Sum<T> sum = Canonical(*node.lhs, transposed);
+      for (Term<T>& term : sum.terms) term.coef *= node.num;
+      return sum;
+    }
+    case Kind::kSum:
+    case Kind::kDifference: {
+      Sum<T> sum = Canonical(*node.lhs, transposed);
+      Sum<T> other = Canonical(*node.rhs, transposed);
+      for (Term<T>& term : other.terms) {
+        if (node.kind == Kind::kDifference) term.coef = -term.coef;
+        sum.terms.push_back(std::move(term));
+      }
+      return sum;
+    }
+    case Kind::kProduct:
+      break;
+  }
+  // (L R)^T = R^T L^T. A side with one term joins the chain; a sum is
+  // not distributed but becomes one factor, kept like a chain under the
+  // smaller key of it and its transpose.
+  Term<T> product{T(1), {}, false, ""};
+  for (const Node<T>* side : {transposed ? node.rhs.get() : node.lhs.get(),
+                              transposed ? node.lhs.get() : node.rhs.get()}) {
+    Sum<T> sum = Canonical(*side, transposed);
+    if (sum.terms.size() == 1) {
+      product.coef *= sum.terms[0].coef;
+      for (Factor<T>& factor : sum.terms[0].factors)
+        product.factors.push_back(std::move(factor));
+    } else {
+      Finish(sum);
+      const int sum_rows = sum.rows, sum_cols = sum.cols;
+      Sum<T> flipped = sum;
+      FlipSum(flipped);
+      const bool turned = flipped.key < sum.key;
+      if (turned) sum = std::move(flipped);
+      const std::string base = '(' + sum.key + ')';
+      product.factors.push_back(
+          {nullptr, std::make_shared<const Sum<T>>(std::move(sum)), turned,
+           sum_rows, sum_cols, base});
+    }
+  }
+  return {rows, cols, {std::move(product)}, ""};
+}
+
+// Evaluates canonical sums, or with execute off only counts their flops.
+// Results of sub-chains and of materialized sums are kept by key, so each
+// is computed once per evaluation.
+template <class T>
+class Planner {
+ public:
+  explicit Planner(bool execute) : execute_(execute) {}
+
+  double GetFlops() const noexcept { return flops_; }
+
+  // Chains used more than once are computed once and added where used;
+  // the others are computed straight into the sum.
+  void Count(const Sum<T>& sum) {
+    for (const Term<T>& term : sum.terms) {
+      if (term.factors.size() > 1) uses_[term.key]++;
+      for (const Factor<T>& factor : term.factors) {
+        if (factor.sum && counted_.insert(factor.base).second)
+          Count(*factor.sum);
+      }
+    }
+  }
+
+  void Into(const Sum<T>& sum, View<T> out) {
+    bool first = true;
+    for (const Term<T>& term : sum.terms) {
+      const View<T> target = execute_ && term.transposed ? out.Transposed()
+                                                         : out;
+      const T beta = first ? T(0) : T(1);
+      first = false;
+      if (term.factors.size() == 1) {
+        _Accumulate(term.coef, _Factor(term.factors[0]), beta, target);
+        continue;
+      }
+      const Chain chain = _Plan(term.factors);
+      if (uses_[term.key] > 1 || done_.count(term.key)) {
+        _Accumulate(term.coef, _Chain(chain, 0, chain.count), beta, target);
+      } else {
+        _Product(chain, 0, chain.count, term.coef, beta, target);
+      }
+    }
+  }
+
+ private:
+  struct Chain {
+    const std::vector<Factor<T>>* factors;
+    int count;
+    std::vector<int> dims;
+    // split[i * (count + 1) + j]: where the product of [i, j) divides.
+    std::vector<int> split;
+
+    int Split(int i, int j) const { return split[i * (count + 1) + j]; }
+  };
+
+  bool execute_;
+  double flops_ = 0;
+  std::unordered_map<std::string, int> uses_;
+  std::unordered_set<std::string> counted_;
+  std::unordered_set<std::string> done_;
+  std::unordered_map<std::string, S21BasicMatrix<T>> cache_;
+
+  // The matrix-chain dynamic program. Products already computed cost
+  // nothing, and so does a sub-chain that the split has computed once
+  // already, as in (A B) (A B).
+  Chain _Plan(const std::vector<Factor<T>>& factors) const {
+    const int count = static_cast<int>(factors.size());
+    Chain chain{&factors, count, {}, {}};
+    for (const Factor<T>& factor : factors) chain.dims.push_back(factor.rows);
+    chain.dims.push_back(factors.back().cols);
+    const int width = count + 1;
+    chain.split.assign(width * width, 0);
+    for (int length = 2; length <= count; length++) {
+      for (int i = 0; i + length <= count; i++) {
+        const int j = i + length;
+        double best = std::numeric_limits<double>::infinity();
+        if (done_.count(SharedKey(factors, i, j))) best = 0;
+        for (int s = i + 1; s < j; s++) {
+          std::unordered_set<std::string> seen;
+          const double candidate = _Cost(chain, i, s, seen) +
+                                   _Cost(chain, s, j, seen) +
+                                   static_cast<double>(chain.dims[i]) *
+                                       chain.dims[s] * chain.dims[j];
+          if (candidate < best || chain.split[i * width + j] == 0) {
+            if (candidate < best) best = candidate;
+            chain.split[i * width + j] = s;
+          }
+        }
+      }
+    }
+    return chain;
+  }
+
+  // Multiplications of the planned product of [begin, end), less the
+  // sub-chains in seen or computed before; adds the ones it computes to
+  // seen.
+  double _Cost(const Chain& chain, int begin, int end,
+               std::unordered_set<std::string>& seen) const {
+    if (end - begin == 1) return 0;
+    const std::string key = SharedKey(*chain.factors, begin, end);
+    if (done_.count(key) || !seen.insert(key).second) return 0;
+    const int split = chain.Split(begin, end);
+    return _Cost(chain, begin, split, seen) + _Cost(chain, split, end, seen) +
+           static_cast<double>(chain.dims[begin]) * chain.dims[split] *
+               chain.dims[end];
+  }
+
+  // out = alpha * F_begin * ... * F_(end-1) + beta * out.
+  void _Product(const Chain& chain, int begin, int end, T alpha, T beta,
+                View<T> out) {
+    const int split = chain.Split(begin, end);
+    const ConstView<T> a = _Chain(chain, begin, split);
+    const ConstView<T> b = _Chain(chain, split, end);
+    const int m = chain.dims[begin], k = chain.dims[split],
+              n = chain.dims[end];
+    flops_ += 2. * m * n * k;
+    if (!execute_) return;
+    if (alpha == T(1) && beta == T(0)) {
+      s21::Multiply<T>(s21::GetMulAlgorithm(), m, n, k, a.data(), a.stride(),
+                       a.col_stride(), b.data(), b.stride(), b.col_stride(),
+                       out.data(), out.stride(), out.col_stride());
+    } else {
+      s21::Gemm<T>(alpha, a, b, beta, out);
+    }
+  }
+
+  ConstView<T> _Chain(const Chain& chain, int begin, int end) {
+    if (end - begin == 1) return _Factor((*chain.factors)[begin]);
+    bool flipped = false;
+    const std::string key = SharedKey(*chain.factors, begin, end, &flipped);
+    if (flipped) {
+      return _Keep(key, chain.dims[end], chain.dims[begin], [&](View<T> out) {
+               _Product(chain, begin, end, T(1), T(0), out.Transposed());
+             }).Transposed();
+    }
+    return _Keep(key, chain.dims[begin], chain.dims[end], [&](View<T> out) {
+      _Product(chain, begin, end, T(1), T(0), out);
+    });
+  }
+
+  ConstView<T> _Factor(const Factor<T>& factor) {
+    ConstView<T> view;
+    if (factor.matrix != nullptr) {
+      view = factor.matrix->View();
+    } else {
+      const Sum<T>& sum = *factor.sum;
+      view = _Keep(factor.base, sum.rows, sum.cols,
+                   [&](View<T> out) { Into(sum, out); });
+    }
+    return factor.transposed ? view.Transposed() : view;
+  }
+
+  // The result under key, computed by compute on first use.
+  template <class F>
+  ConstView<T> _Keep(const std::string& key, int rows, int cols, F compute) {
+    if (done_.insert(key).second) {
+      if (execute_) {
+        S21BasicMatrix<T>& result =
+            cache_.emplace(key, S21BasicMatrix<T>(rows, cols)).first->second;
+        compute(result.View());
+      } else {
+        compute(View<T>());
+      }
+    }
+    if (!execute_) return ConstView<T>();
+    return cache_.at(key).View();
+  }
+
+  // out = coef * a + beta * out for beta 0 or 1.
+  void _Accumulate(T coef, ConstView<T> a, T beta, View<T> out) {
+    if (!execute_) return;
+    if (beta == T(0)) {
+      s21::Scale<T>(a, coef, out);
+      return;
+    }
+    const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+    const int cols = out.GetCols();
+    const bool contiguous = a.col_stride() == 1 && out.col_stride() == 1;
+    s21::ParallelFor(
+        out.GetRows(), s21::ParallelGrain(cols),
+        [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (int i = static_cast<int>(begin); i < end; i++) {
+            if (contiguous) {
+              simd.axpy(coef, a.Row(i), out.Row(i), cols);
+            } else {
+              for (int j = 0; j < cols; j++) out(i, j) += coef * a(i, j);
+            }
+          }
+        });
+  }
+};
+
+}  // namespace
+
+template <class T>
+S21BasicLazyMatrix<T>::S21BasicLazyMatrix(const S21BasicMatrix<T>& matrix)
+    : node_(std::make_shared<const s21::LazyNode<T>>(s21::LazyNode<T>{
+          s21::LazyNode<T>::Kind::kMatrix, matrix.GetRows(),
+          matrix.GetCols(), &matrix, T(0), nullptr, nullptr})) {
+  if (matrix.data() == nullptr || matrix.GetRows() < 1 ||
+      matrix.GetCols() < 1)
+    throw std::out_of_range("Invalid matrix");
+}
+
+template <class T>
+S21BasicLazyMatrix<T>::S21BasicLazyMatrix(
+    std::shared_ptr<const s21::LazyNode<T>> node)
+    : node_(std::move(node)) {}
+
+template <class T>
+int S21BasicLazyMatrix<T>::GetRows() const noexcept {
+  return node_->rows;
+}
+
+template <class T>
+int S21BasicLazyMatrix<T>::GetCols() const noexcept {
+  return node_->cols;
+}
+
+template <class T>
+S21BasicLazyMatrix<T> S21BasicLazyMatrix<T>::operator+(
+    const S21BasicLazyMatrix& other) const {
+  if (GetRows() != other.GetRows() || GetCols() != other.GetCols())
+    throw std::invalid_argument("Sizes are not equal");
+  return S21BasicLazyMatrix(std::make_shared<const s21::LazyNode<T>>(
+      s21::LazyNode<T>{s21::LazyNode<T>::Kind::kSum, GetRows(), GetCols(),
+                       nullptr, T(0), node_, other.node_}));
+}
+
+template <class T>
+S21BasicLazyMatrix<T> S21BasicLazyMatrix<T>::operator-(
+    const S21BasicLazyMatrix& other) const {
+  if (GetRows() != other.GetRows() || GetCols() != other.GetCols())
+    throw std::invalid_argument("Sizes are not equal");
+  return S21BasicLazyMatrix(std::make_shared<const s21::LazyNode<T>>(
+      s21::LazyNode<T>{s21::LazyNode<T>::Kind::kDifference, GetRows(),
+                       GetCols(), nullptr, T(0), node_, other.node_}));
+}
+
+template <class T>
+S21BasicLazyMatrix<T> S21BasicLazyMatrix<T>::operator*(
+    const S21BasicLazyMatrix& other) const {
+  if (GetCols() != other.GetRows())
+    throw std::invalid_argument(
+        "Columns first matrix not equal rows second matrix");
+  return S21BasicLazyMatrix(std::make_shared<const s21::LazyNode<T>>(
+      s21::LazyNode<T>{s21::LazyNode<T>::Kind::kProduct, GetRows(),
+                       other.GetCols(), nullptr, T(0), node_, other.node_}));
+}
+
+template <class T>
+S21BasicLazyMatrix<T> S21BasicLazyMatrix<T>::operator*(const T num) const {
+  return S21BasicLazyMatrix(std::make_shared<const s21::LazyNode<T>>(
+      s21::LazyNode<T>{s21::LazyNode<T>::Kind::kScale, GetRows(), GetCols(),
+                       nullptr, num, node_, nullptr}));
+}
+
+template <class T>
+S21BasicLazyMatrix<T> S21BasicLazyMatrix<T>::Transpose() const {
+  return S21BasicLazyMatrix(std::make_shared<const s21::LazyNode<T>>(
+      s21::LazyNode<T>{s21::LazyNode<T>::Kind::kTranspose, GetCols(),
+                       GetRows(), nullptr, T(0), node_, nullptr}));
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicLazyMatrix<T>::Evaluate() const {
+  Sum<T> sum = Canonical(*node_, false);
+  Finish(sum);
+  Planner<T> planner(true);
+  planner.Count(sum);
+  S21BasicMatrix<T> result(GetRows(), GetCols());
+  planner.Into(sum, result.View());
+  return result;
+}
+
+template <class T>
+double S21BasicLazyMatrix<T>::Flops() const {
+  Sum<T> sum = Canonical(*node_, false);
+  Finish(sum);
+  Planner<T> planner(false);
+  planner.Count(sum);
+  planner.Into(sum, View<T>());
+  return planner.GetFlops();
+}
+
+template class S21BasicLazyMatrix<float>;
+template class S21BasicLazyMatrix<double>;
+template class S21BasicLazyMatrix<long double>;
@@ -0,0 +1,83 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_LAZY_MATRIX_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_LAZY_MATRIX_H
+
+#include <memory>
+
+#include "s21_matrix.h"
+
+namespace s21 {
+
+template <class T>
+struct LazyNode;
+
+}  // namespace s21
+
+// Opt-in deferred evaluation. Operations on S21BasicLazyMatrix only record
+// a graph, and Evaluate() plans all of it before calling the kernels:
+//   - transposes are pushed down to the matrices and become GEMM strides,
+//   - scalars are gathered into the alpha of the GEMM that computes each
+//     term of a sum, and the terms accumulate through its beta,
+//   - each product chain is ordered by the matrix-chain dynamic program on
+//     the shapes, so A * B * v costs two matrix-vector products instead of
+//     a matrix product,
+//   - equal terms, sub-chains and sums are computed once, also when one is
+//     the transpose of the other, and so are repeats inside one chain.
+// The eager S21BasicMatrix operators are unaffected. The graph refers to
+// the recorded matrices, which must outlive it and stay unchanged until it
+// is evaluated.
+template <class T>
+class S21BasicLazyMatrix {
+ public:
+  // Implicit, so that matrices mix into lazy expressions: in
+  // S21LazyMatrix(a) * b * v only the first operand needs wrapping. The
+  // eager expressions of S21BasicMatrix (a.Transpose(), a * 2.) do not mix
+  // in; use the lazy operations instead.
+  S21BasicLazyMatrix(const S21BasicMatrix<T>& matrix);
+  S21BasicLazyMatrix(S21BasicMatrix<T>&&) = delete;
+
+  int GetRows() const noexcept;
+  int GetCols() const noexcept;
+
+  S21BasicLazyMatrix operator+(const S21BasicLazyMatrix& other) const;
+  S21BasicLazyMatrix operator-(const S21BasicLazyMatrix& other) const;
+  S21BasicLazyMatrix operator*(const S21BasicLazyMatrix& other) const;
+  S21BasicLazyMatrix operator*(const T num) const;
+  S21BasicLazyMatrix Transpose() const;
+
+  friend S21BasicLazyMatrix operator+(const S21BasicMatrix<T>& lhs,
+                                      const S21BasicLazyMatrix& rhs) {
+    return S21BasicLazyMatrix(lhs) + rhs;
+  }
+  friend S21BasicLazyMatrix operator-(const S21BasicMatrix<T>& lhs,
+                                      const S21BasicLazyMatrix& rhs) {
+    return S21BasicLazyMatrix(lhs) - rhs;
+  }
+  friend S21BasicLazyMatrix operator*(const S21BasicMatrix<T>& lhs,
+                                      const S21BasicLazyMatrix& rhs) {
+    return S21BasicLazyMatrix(lhs) * rhs;
+  }
+
+  S21BasicMatrix<T> Evaluate() const;
+  // Flops of the products Evaluate() runs, 2 m n k each, after ordering and
+  // common subexpressions; additions are not counted.
+  double Flops() const;
+
+ private:
+  std::shared_ptr<const s21::LazyNode<T>> node_;
+
+  explicit S21BasicLazyMatrix(std::shared_ptr<const s21::LazyNode<T>> node);
+};
+
+template <class T>
+S21BasicLazyMatrix<T> operator*(const T num,
+                                const S21BasicLazyMatrix<T>& matrix) {
+  return matrix * num;
+}
+
+using S21LazyMatrix = S21BasicLazyMatrix<double>;
+
+extern template class S21BasicLazyMatrix<float>;
+extern template class S21BasicLazyMatrix<double>;
+extern template class S21BasicLazyMatrix<long double>;
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_LAZY_MATRIX_H
@@ -0,0 +1,254 @@
+#include "s21_lu.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "s21_gemm.h"
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+#include "s21_triangular.h"
+
+namespace {
+
+template <class T>
+T* RowOf(S21BasicMatrix<T>& matrix, int i) {
+  return matrix.data() + static_cast<std::size_t>(i) * matrix.stride();
+}
+
+template <class T>
+const T* RowOf(const S21BasicMatrix<T>& matrix, int i) {
+  return matrix.data() + static_cast<std::size_t>(i) * matrix.stride();
+}
+
+template <class T>
+T* RowOf(S21BasicMatrixView<T> matrix, int i) {
+  return matrix.Row(i);
+}
+
+}  // namespace
+
+template <class T>
+S21BasicLU<T>::S21BasicLU(S21BasicMatrixView<const T> matrix)
+    : lu_(matrix),
+      size_(matrix.GetRows()),
+      sign_(1),
+      singular_(false),
+      tolerance_(0) {
+  if (matrix.GetRows() != matrix.GetCols())
+    throw std::invalid_argument("Matrix is not square");
+  pivots_.resize(size_);
+  sign_ = _Factorize(lu_, pivots_.data(), tolerance_, singular_);
+}
+
+template <class T>
+T S21BasicLU<T>::DeterminantInPlace(S21BasicMatrixView<T> matrix) {
+  if (matrix.Empty()) throw std::out_of_range("Invalid matrix");
+  if (matrix.GetRows() != matrix.GetCols())
+    throw std::invalid_argument("Matrix is not square");
+  if (matrix.col_stride() != 1)
+    return S21BasicLU(matrix).Determinant();
+  std::vector<int> pivots(matrix.GetRows());
+  T tolerance = 0;
+  bool singular = false;
+  T det = _Factorize(matrix, pivots.data(), tolerance, singular);
+  for (int i = 0; i < matrix.GetRows(); i++) det *= RowOf(matrix, i)[i];
+  return det;
+}
+
+template <class T>
+int S21BasicLU<T>::_Factorize(S21BasicMatrixView<T> a, int* pivots,
+                              T& tolerance, bool& singular) {
+  const int size = a.GetRows();
+  T max_abs = 0;
+  for (int i = 0; i < size; i++) {
+    pivots[i] = i;
+    const T* row = RowOf(a, i);
+    for (int j = 0; j < size; j++)
+      max_abs = std::max(max_abs, std::abs(row[j]));
+  }
+  tolerance = max_abs * size * std::numeric_limits<T>::epsilon();
+  int sign = 1;
+  for (int k = 0; k < size; k += kBlock) {
+    int nb = std::min(kBlock, size - k);
+    sign *= _FactorPanel(a, k, nb, tolerance, pivots, singular);
+    _UpdateTrailing(a, k, nb);
+  }
+  return sign;
+}
+
+// Unblocked right-looking elimination of columns [k, k + nb). Row swaps are
+// applied to whole rows, so the part of the matrix right of the panel stays
+// consistent with the pivot order. Returns the sign of the swaps.
+template <class T>
+int S21BasicLU<T>::_FactorPanel(S21BasicMatrixView<T> a, int k, int nb,
+                                T tolerance, int* pivots, bool& singular) {
+  const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+  const int size = a.GetRows();
+  const int end = k + nb;
+  int sign = 1;
+  for (int j = k; j < end; j++) {
+    int pivot_row = j;
+    T pivot_abs = std::abs(RowOf(a, j)[j]);
+    for (int i = j + 1; i < size; i++) {
+      T candidate = std::abs(RowOf(a, i)[j]);
+      if (candidate > pivot_abs) {
+        pivot_abs = candidate;
+        pivot_row = i;
+      }
+    }
+    if (pivot_row != j) {
+      std::swap_ranges(RowOf(a, j), RowOf(a, j) + size, RowOf(a, pivot_row));
+      std::swap(pivots[j], pivots[pivot_row]);
+      sign = -sign;
+    }
+    if (pivot_abs <= tolerance) singular = true;
+    if (pivot_abs == 0) continue;
+
+    const T* pivot = RowOf(a, j);
+    s21::ParallelFor(size - j - 1, s21::ParallelGrain(end - j),
+                     [&](std::ptrdiff_t begin, std::ptrdiff_t stop) {
+                       for (int i = j + 1 + begin; i < j + 1 + stop; i++) {
+                         T* row = RowOf(a, i);
+                         T l = row[j] /= pivot[j];
+                         if (l != 0)
+                           simd.axpy(-l, pivot + j + 1, row + j + 1,
+                                     end - j - 1);
+                       }
+                     });
+  }
+  return sign;
+}
+
+// Computes U12 = L11^-1 * A12 and A22 -= L21 * U12, the latter through the
+// blocked GEMM where almost all of the flops are spent.
+template <class T>
+void S21BasicLU<T>::_UpdateTrailing(S21BasicMatrixView<T> a, int k, int nb) {
+  const int end = k + nb;
+  const int rest = a.GetRows() - end;
+  if (rest <= 0) return;
+  const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+  s21::ParallelFor(rest, s21::ParallelGrain(nb * nb / 2),
+                   [&](std::ptrdiff_t begin, std::ptrdiff_t stop) {
+                     for (int r = k; r < end; r++) {
+                       const T* source = RowOf(a, r) + end;
+                       for (int i = r + 1; i < end; i++) {
+                         T* row = RowOf(a, i);
+                         if (row[r] != 0)
+                           simd.axpy(-row[r], source + begin,
+                                     row + end + begin, stop - begin);
+                       }
+                     }
+                   });
+  const int stride = a.stride();
+  s21::Gemm<T>(rest, rest, nb, -1, RowOf(a, end) + k, stride, 1,
+               RowOf(a, k) + end, stride, 1, 1, RowOf(a, end) + end, stride,
+               1);
+}
+
+template <class T>
+int S21BasicLU<T>::GetSize() const noexcept {
+  return size_;
+}
+
+template <class T>
+const S21BasicMatrix<T>& S21BasicLU<T>::GetFactors() const noexcept {
+  return lu_;
+}
+
+template <class T>
+const std::vector<int>& S21BasicLU<T>::GetPivots() const noexcept {
+  return pivots_;
+}
+
+template <class T>
+bool S21BasicLU<T>::IsSingular() const noexcept {
+  return singular_;
+}
+
+template <class T>
+T S21BasicLU<T>::Determinant() const noexcept {
+  T det = sign_;
+  for (int i = 0; i < size_; i++) det *= RowOf(lu_, i)[i];
+  return det;
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicLU<T>::Solve(S21BasicMatrixView<const T> b) const {
+  if (b.Empty()) throw std::out_of_range("Invalid matrix");
+  if (b.GetRows() != size_) throw std::invalid_argument("Sizes are not equal");
+  if (singular_) throw std::invalid_argument("Determinant equals 0");
+
+  const int cols = b.GetCols();
+  S21BasicMatrix<T> x(size_, cols);
+  for (int i = 0; i < size_; i++) {
+    const T* source = RowOf(b, pivots_[i]);
+    T* target = RowOf(x, i);
+    for (int j = 0; j < cols; j++) {
+      target[j] = source[static_cast<std::ptrdiff_t>(j) * b.col_stride()];
+    }
+  }
+  s21::TriangularSolve<T>(s21::Triangle::kLower, s21::Diagonal::kUnit, lu_,
+                          x);
+  s21::TriangularSolve<T>(s21::Triangle::kUpper, s21::Diagonal::kNonUnit,
+                          lu_, x);
+  return x;
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicLU<T>::Inverse() const {
+  S21BasicMatrix<T> identity(size_, size_);
+  for (int i = 0; i < size_; i++) RowOf(identity, i)[i] = 1;
+  return Solve(identity);
+}
+
+// L * U + w * z^T with w = P * u splits into the first row and column of
+// the new factors and the rank-1 update L22 * U22 + w' * z'^T of the rest,
+// where w' = w2 - w1 * L21 and z' = z2 - (z1 / d) * U12', d the new pivot.
+// Column i of L only needs scalars of step i, so the steps run by rows:
+// row i of L is finished, which yields w_i, before row i of U, and every
+// access is contiguous.
+template <class T>
+bool S21BasicLU<T>::Update(S21BasicMatrixView<const T> u,
+                           S21BasicMatrixView<const T> v) {
+  if (u.Empty() || v.Empty()) throw std::out_of_range("Invalid matrix");
+  if (u.GetRows() != size_ || v.GetRows() != size_ || u.GetCols() != 1 ||
+      v.GetCols() != 1)
+    throw std::invalid_argument("Sizes are not equal");
+  const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+  // z, then per step: the L scale pivot / d, the L shift z_i / d and w_i.
+  std::vector<T> z(size_), scale(size_), shift(size_), w(size_);
+  for (int i = 0; i < size_; i++) z[i] = v(i, 0);
+  const T roundoff = size_ * std::numeric_limits<T>::epsilon();
+  singular_ = true;
+  bool singular = false;
+  for (int i = 0; i < size_; i++) {
+    T* row = RowOf(lu_, i);
+    T wi = u(pivots_[i], 0);
+    for (int j = 0; j < i; j++) {
+      const T old = row[j];
+      row[j] = old * scale[j] + wi * shift[j];
+      wi -= w[j] * old;
+      if (!(std::abs(row[j]) <= kMaxMultiplier)) return false;
+    }
+    const T pivot = row[i], zi = z[i];
+    const T d = pivot + wi * zi;
+    if (!(std::abs(d) > roundoff * (std::abs(pivot) + std::abs(wi * zi))))
+      return false;
+    if (std::abs(d) <= tolerance_) singular = true;
+    const int rest = size_ - i - 1;
+    simd.axpy(wi, z.data() + i + 1, row + i + 1, rest);
+    simd.axpy(-zi / d, row + i + 1, z.data() + i + 1, rest);
+    row[i] = d;
+    scale[i] = pivot / d;
+    shift[i] = zi / d;
+    w[i] = wi;
+  }
+  singular_ = singular;
+  return true;
+}
+
+template class S21BasicLU<float>;
+template class S21BasicLU<double>;
+template class S21BasicLU<long double>;
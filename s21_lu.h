@@ -0,0 +1,66 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_LU_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_LU_H
+
+#include <vector>
+
+#include "s21_matrix.h"
+
+// LU factorization with partial pivoting, P * A = L * U. L (unit diagonal)
+// and U are stored packed in one matrix; the factorization is computed once
+// and can then be reused for any number of determinants and solves.
+template <class T>
+class S21BasicLU {
+ public:
+  explicit S21BasicLU(S21BasicMatrixView<const T> matrix);
+
+  int GetSize() const noexcept;
+  const S21BasicMatrix<T>& GetFactors() const noexcept;
+  // Row i of P * A is row GetPivots()[i] of A.
+  const std::vector<int>& GetPivots() const noexcept;
+  // True when some pivot is negligible relative to the largest element of A.
+  bool IsSingular() const noexcept;
+
+  T Determinant() const noexcept;
+  S21BasicMatrix<T> Solve(S21BasicMatrixView<const T> b) const;
+  S21BasicMatrix<T> Inverse() const;
+
+  // Refactors P * (A + u * v^T) for n x 1 u and v in O(n^2), keeping the
+  // pivot order (Bennett's algorithm). Without fresh pivoting a multiplier
+  // can grow: Update returns false when one exceeds kMaxMultiplier or a
+  // pivot cancels to rounding, and the factors are then invalid (reported
+  // singular) until the matrix is factored again.
+  bool Update(S21BasicMatrixView<const T> u, S21BasicMatrixView<const T> v);
+
+  // Determinant of a square view with unit column stride, factoring it in
+  // place: the elements are overwritten and nothing is allocated beyond the
+  // pivot order.
+  static T DeterminantInPlace(S21BasicMatrixView<T> matrix);
+
+ private:
+  static constexpr int kBlock = 64;
+  static constexpr int kMaxMultiplier = 1000;
+
+  S21BasicMatrix<T> lu_;
+  std::vector<int> pivots_;
+  int size_;
+  int sign_;
+  bool singular_;
+  // Pivots at or below it are negligible; fixed at the factorization.
+  T tolerance_;
+
+  // Factors a in place and records the row order in pivots; returns the
+  // sign of the permutation.
+  static int _Factorize(S21BasicMatrixView<T> a, int* pivots, T& tolerance,
+                        bool& singular);
+  static int _FactorPanel(S21BasicMatrixView<T> a, int k, int nb,
+                          T tolerance, int* pivots, bool& singular);
+  static void _UpdateTrailing(S21BasicMatrixView<T> a, int k, int nb);
+};
+
+using S21LU = S21BasicLU<double>;
+
+extern template class S21BasicLU<float>;
+extern template class S21BasicLU<double>;
+extern template class S21BasicLU<long double>;
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_LU_H
@@ -1,8 +1,36 @@
 #include "s21_matrix.h"
 
-S21Matrix::S21Matrix() : rows_(3), cols_(3) { CreateMatrix(rows_, cols_); }
-
-S21Matrix::S21Matrix(int rows, int cols) {
+#include <algorithm>
+#include <new>
+#include <utility>
+
+#include "s21_cholesky.h"
+#include "s21_gemm.h"
+#include "s21_lu.h"
+#include "s21_memory.h"
+#include "s21_profile.h"
+#include "s21_qr.h"
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+#include "s21_transpose.h"
+
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix() : S21BasicMatrix(3, 3) {}
+
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols)
+    : S21BasicMatrix(rows, cols, GetDefaultResource()) {}
+
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols,
+                                  std::pmr::memory_resource* resource)
+    : resource_(resource),
+      matrix_(nullptr),
+      capacity_(0),
+      rows_(0),
+      cols_(0),
+      stride_(0),
+      refs_(nullptr) {
   if (rows > 0 && cols > 0) {
     rows_ = rows;
     cols_ = cols;
@@ -12,44 +40,186 @@ S21Matrix::S21Matrix(int rows, int cols) {
   }
 }
 
-S21Matrix::S21Matrix(const S21Matrix& other)
-    : rows_(other.rows_), cols_(other.cols_) {
-  matrix_ = new double*[other.rows_];
-  for (int i = 0; i < other.rows_; i++) {
-    matrix_[i] = new double[other.cols_];
-  }
-  for (int i = 0; i < other.rows_; i++) {
-    for (int j = 0; j < other.cols_; j++) {
-      matrix_[i][j] = other.matrix_[i][j];
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix& other)
+    : resource_(GetDefaultResource()),
+      matrix_(nullptr),
+      capacity_(0),
+      rows_(0),
+      cols_(0),
+      stride_(0),
+      refs_(nullptr) {
+  S21_PROFILE_SCOPE(kCopy, 0);
+  if (_CanShare(other)) {
+    _Share(other);
+  } else if (other.matrix_ != nullptr) {
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    CreateMatrix(rows_, cols_);
+    for (int i = 0; i < rows_; i++) {
+      std::copy(other._Row(i), other._Row(i) + cols_, _Row(i));
     }
+    S21_PROFILE_COPIED(sizeof(T) * rows_ * cols_);
   }
 }
 
-S21Matrix::S21Matrix(S21Matrix&& other) noexcept
-    : matrix_(other.matrix_), rows_(other.rows_), cols_(other.cols_) {
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrixView<const T> view)
+    : S21BasicMatrix(view.GetRows(), view.GetCols()) {
+  S21_PROFILE_SCOPE(kCopy, 0);
+  s21::Copy<T>(view, View());
+  S21_PROFILE_COPIED(sizeof(T) * rows_ * cols_);
+}
+
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix&& other) noexcept
+    : resource_(other.resource_),
+      matrix_(other.matrix_),
+      capacity_(other.capacity_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(other.stride_),
+      refs_(other.refs_) {
   other.cols_ = 0;
   other.rows_ = 0;
+  other.stride_ = 0;
+  other.capacity_ = 0;
   other.matrix_ = nullptr;
+  other.refs_ = nullptr;
 }
 
-S21Matrix::~S21Matrix() {
-  for (int i = 0; i < rows_; i++) {
-    delete[] matrix_[i];
+template <class T>
+S21BasicMatrix<T>::~S21BasicMatrix() { FreeMatrix(); }
+
+// Rows are padded to a whole number of cache lines once they are long enough
+// for the padding to be cheap, so every row starts 64-byte aligned.
+template <class T>
+int S21BasicMatrix<T>::_Stride(int cols) noexcept {
+  const int line = static_cast<int>(kAlignment / sizeof(T));
+  return cols < line ? cols : (cols + line - 1) / line * line;
+}
+
+namespace {
+
+using RefCount = std::atomic<long>;
+
+std::pmr::memory_resource*& DefaultResource() noexcept {
+  thread_local std::pmr::memory_resource* resource =
+      S21AlignedResource::Instance();
+  return resource;
+}
+
+bool& CopyOnWrite() noexcept {
+  thread_local bool enabled = false;
+  return enabled;
+}
+
+}  // namespace
+
+template <class T>
+void S21BasicMatrix<T>::CreateMatrix(int rows, int columns) {
+  stride_ = _Stride(columns);
+  std::size_t count = static_cast<std::size_t>(rows) * stride_;
+  matrix_ = static_cast<T*>(
+      resource_->allocate(count * sizeof(T), kAlignment));
+  capacity_ = count;
+  if (CopyOnWrite()) {
+    try {
+      refs_ = new (resource_->allocate(sizeof(RefCount), alignof(RefCount)))
+          RefCount(1);
+    } catch (...) {
+      FreeMatrix();
+      throw;
+    }
+  }
+  S21_PROFILE_ALLOCATED(count * sizeof(T));
+  std::fill(matrix_, matrix_ + count, T(0));
+}
+
+// A shared buffer is freed by the last of its owners.
+template <class T>
+void S21BasicMatrix<T>::FreeMatrix() noexcept {
+  if (matrix_ != nullptr &&
+      (refs_ == nullptr ||
+       refs_->fetch_sub(1, std::memory_order_acq_rel) == 1)) {
+    resource_->deallocate(matrix_, capacity_ * sizeof(T), kAlignment);
+    if (refs_ != nullptr) {
+      refs_->~RefCount();
+      resource_->deallocate(refs_, sizeof(RefCount), alignof(RefCount));
+    }
   }
-  delete[] matrix_;
   rows_ = 0;
   cols_ = 0;
+  stride_ = 0;
+  capacity_ = 0;
   matrix_ = nullptr;
+  refs_ = nullptr;
 }
 
-void S21Matrix::CreateMatrix(int rows, int columns) {
-  matrix_ = new double*[rows];
-  for (int i = 0; i < rows; i++) {
-    matrix_[i] = new double[columns]();
+// A copy shares only a counted buffer of its own resource, so copies and
+// assignments keep the resource they would have without copy-on-write.
+template <class T>
+bool S21BasicMatrix<T>::_CanShare(const S21BasicMatrix& other) const noexcept {
+  return other.refs_ != nullptr && other.resource_ == resource_ &&
+         GetCopyOnWrite();
+}
+
+// Takes a reference to the buffer of other; this matrix owns nothing.
+template <class T>
+void S21BasicMatrix<T>::_Share(const S21BasicMatrix& other) noexcept {
+  other.refs_->fetch_add(1, std::memory_order_relaxed);
+  matrix_ = other.matrix_;
+  capacity_ = other.capacity_;
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  stride_ = other.stride_;
+  refs_ = other.refs_;
+}
+
+// Gives a shared matrix a private copy of its buffer before it is written.
+template <class T>
+void S21BasicMatrix<T>::_Detach() {
+  if (!IsShared()) return;
+  S21BasicMatrix copy(rows_, cols_, resource_);
+  for (int i = 0; i < rows_; i++) {
+    std::copy(_Row(i), _Row(i) + cols_, copy._Row(i));
   }
+  S21_PROFILE_COPIED(sizeof(T) * rows_ * cols_);
+  *this = std::move(copy);
 }
 
-bool S21Matrix::_CheckMatrix(const S21Matrix& other) const noexcept {
+template <class T>
+bool S21BasicMatrix<T>::IsShared() const noexcept {
+  return refs_ != nullptr && refs_->load(std::memory_order_acquire) > 1;
+}
+
+template <class T>
+bool S21BasicMatrix<T>::GetCopyOnWrite() noexcept {
+  return CopyOnWrite();
+}
+
+template <class T>
+bool S21BasicMatrix<T>::SetCopyOnWrite(bool enabled) noexcept {
+  return std::exchange(CopyOnWrite(), enabled);
+}
+
+template <class T>
+std::pmr::memory_resource* S21BasicMatrix<T>::GetDefaultResource() noexcept {
+  return DefaultResource();
+}
+
+template <class T>
+std::pmr::memory_resource* S21BasicMatrix<T>::SetDefaultResource(
+    std::pmr::memory_resource* resource) noexcept {
+  std::pmr::memory_resource* previous = DefaultResource();
+  DefaultResource() = resource != nullptr ? resource
+                                          : S21AlignedResource::Instance();
+  return previous;
+}
+
+template <class T>
+bool S21BasicMatrix<T>::_CheckMatrix(
+    const S21BasicMatrix& other) const noexcept {
   bool res = NO_PROBLEMO;
   if (matrix_ == nullptr || other.matrix_ == nullptr) res = FAILURE;
   if (rows_ < 1 || cols_ < 1 || other.rows_ < 1 || other.cols_ < 1)
@@ -57,321 +227,500 @@ bool S21Matrix::_CheckMatrix(const S21Matrix& other) const noexcept {
   return res;
 }
 
-void S21Matrix::_FillMatrix(double val) noexcept {
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] = i + j + val;
-    }
-  }
+template <class T>
+void S21BasicMatrix<T>::_FillMatrix(T val) {
+  _Detach();
+  const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+  s21::ParallelFor(rows_, s21::ParallelGrain(cols_),
+                   [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                     for (int i = begin; i < end; i++) {
+                       simd.ramp(_Row(i), cols_, i, val);
+                     }
+                   });
 }
 
-bool S21Matrix::EqMatrix(const S21Matrix& other) const noexcept {
-  int res = NO_PROBLEMO;
-  res = _CheckMatrix(other);
-  if (res != FAILURE && rows_ == other.rows_ && cols_ == other.cols_) {
-    for (int i = 0; i < rows_ && res != FAILURE; i++) {
-      for (int j = 0; j < cols_ && res != FAILURE; j++) {
-        if (fabs(matrix_[i][j] - other.matrix_[i][j]) > 1e-7) res = FAILURE;
-      }
-    }
-  } else {
-    res = FAILURE;
-  }
-  return res;
+template <class T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrix& other) const noexcept {
+  return EqMatrix(other, S21Tolerance<T>::kEqual);
 }
 
-void S21Matrix::SumMatrix(const S21Matrix& other) {
-  if (rows_ != other.rows_ || cols_ != other.cols_) {
-    throw std::invalid_argument("Sizes are not equal");
-  }
-  char plus = '+';
-  _SumAndSubMatrix(plus, other);
+template <class T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrix& other,
+                                 T tolerance) const noexcept {
+  return EqMatrix(other.View(), tolerance);
 }
 
-void S21Matrix::SubMatrix(const S21Matrix& other) {
-  if (rows_ != other.rows_ || cols_ != other.cols_) {
+template <class T>
+bool S21BasicMatrix<T>::EqMatrix(
+    S21BasicMatrixView<const T> other) const noexcept {
+  return EqMatrix(other, S21Tolerance<T>::kEqual);
+}
+
+template <class T>
+bool S21BasicMatrix<T>::EqMatrix(S21BasicMatrixView<const T> other,
+                                 T tolerance) const noexcept {
+  return s21::Equal<T>(View(), other, tolerance);
+}
+
+template <class T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix& other) {
+  SumMatrix(other.View());
+}
+
+template <class T>
+void S21BasicMatrix<T>::SumMatrix(S21BasicMatrixView<const T> other) {
+  S21_PROFILE_SCOPE(kSum, static_cast<double>(rows_) * cols_);
+  if (rows_ != other.GetRows() || cols_ != other.GetCols()) {
     throw std::invalid_argument("Sizes are not equal");
   }
-  char minus = '-';
-  _SumAndSubMatrix(minus, other);
+  _Detach();
+  s21::Add<T>(View(), other, View());
 }
 
-void S21Matrix::_SumAndSubMatrix(char plus_or_minus, const S21Matrix& other) {
-  bool res = _CheckMatrix(other);
-  if (res) {
-    S21Matrix result(rows_, cols_);
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < cols_; j++) {
-        if (plus_or_minus == '-')
-          result.matrix_[i][j] = matrix_[i][j] - other.matrix_[i][j];
-        else {
-          result.matrix_[i][j] = matrix_[i][j] + other.matrix_[i][j];
-        }
-      }
-    }
-    *this = result;
-  } else {
-    throw std::out_of_range("Invalid matrix");
+template <class T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix& other) {
+  SubMatrix(other.View());
+}
+
+template <class T>
+void S21BasicMatrix<T>::SubMatrix(S21BasicMatrixView<const T> other) {
+  S21_PROFILE_SCOPE(kSub, static_cast<double>(rows_) * cols_);
+  if (rows_ != other.GetRows() || cols_ != other.GetCols()) {
+    throw std::invalid_argument("Sizes are not equal");
   }
+  _Detach();
+  s21::Sub<T>(View(), other, View());
 }
 
-void S21Matrix::MulNumber(const double num) {
+template <class T>
+void S21BasicMatrix<T>::MulNumber(const T num) {
+  S21_PROFILE_SCOPE(kMulNumber, static_cast<double>(rows_) * cols_);
   if (matrix_ != nullptr || cols_ > 0 || rows_ > 0) {
-    S21Matrix result(rows_, cols_);
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < cols_; j++) {
-        result.matrix_[i][j] = matrix_[i][j] * num;
-      }
-    }
-    *this = result;
+    _Detach();
+    const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+    s21::ParallelFor(rows_, s21::ParallelGrain(cols_),
+                     [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                       for (int i = begin; i < end; i++) {
+                         simd.scale(_Row(i), num, _Row(i), cols_);
+                       }
+                     });
   } else {
     throw std::out_of_range("Invalid matrix");
   }
 }
 
-void S21Matrix::MulMatrix(const S21Matrix& other) {
-  bool res = _CheckMatrix(other);
+template <class T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix& other) {
+  MulMatrix(other.View());
+}
+
+template <class T>
+void S21BasicMatrix<T>::MulMatrix(S21BasicMatrixView<const T> other) {
+  MulMatrix(other, s21::GetMulAlgorithm());
+}
+
+template <class T>
+void S21BasicMatrix<T>::MulMatrix(S21BasicMatrixView<const T> other,
+                                  s21::MulAlgorithm algorithm) {
+  S21_PROFILE_SCOPE(kMulMatrix, 2. * rows_ * cols_ * other.GetCols());
+  if (cols_ != other.GetRows())
+    throw std::invalid_argument(
+        "Columns first matrix not equal rows second matrix");
+  if (matrix_ == nullptr || other.Empty())
+    throw std::out_of_range("Invalid matrix");
+  S21BasicMatrix result(rows_, other.GetCols());
+  s21::Multiply<T>(algorithm, rows_, other.GetCols(), cols_, matrix_, stride_,
+                   1, other.data(), other.stride(), other.col_stride(),
+                   result.matrix_, result.stride_, 1);
+  *this = std::move(result);
+}
+
+template <class T>
+void S21BasicMatrix<T>::MulMatrixMixed(const S21BasicMatrix& other) {
+  S21_PROFILE_SCOPE(kMulMatrix, 2. * rows_ * cols_ * other.cols_);
+  using Acc = typename S21Accumulator<T>::Type;
+  if (!_CheckMatrix(other)) throw std::out_of_range("Invalid matrix");
   if (cols_ != other.rows_)
     throw std::invalid_argument(
         "Columns first matrix not equal rows second matrix");
-  else if (res) {
-    S21Matrix result(rows_, other.cols_);
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < other.cols_; j++) {
-        for (int n = 0; n < other.rows_; n++) {
-          result.matrix_[i][j] += matrix_[i][n] * other.matrix_[n][j];
-        }
-      }
-    }
-    *this = result;
-  } else {
+  S21BasicMatrix result(rows_, other.cols_);
+  s21::Gemm<T, Acc>(rows_, other.cols_, cols_, 1, matrix_, stride_, 1,
+                    other.matrix_, other.stride_, 1, 0, result.matrix_,
+                    result.stride_, 1);
+  *this = std::move(result);
+}
+
+template <class T>
+void S21BasicMatrix<T>::Gemm(T alpha, S21BasicMatrixView<const T> a,
+                             S21BasicMatrixView<const T> b, T beta,
+                             S21BasicMatrixView<T> c) {
+  s21::Gemm<T>(alpha, a, b, beta, c);
+}
+
+template <class T>
+S21TransposeExpr<S21MatrixLeaf<T>> S21BasicMatrix<T>::Transpose() const {
+  if (matrix_ == nullptr || cols_ < 1 || rows_ < 1) {
     throw std::out_of_range("Invalid matrix");
   }
+  return S21TransposeExpr<S21MatrixLeaf<T>>(S21MatrixLeaf(*this));
 }
 
-S21Matrix S21Matrix::Transpose() {
+// Square matrices swap mirrored tiles. Rectangular ones are packed to a
+// dense layout, permuted by cycle-following and re-padded when the new rows
+// still fit in the buffer, so peak memory never grows.
+template <class T>
+void S21BasicMatrix<T>::TransposeInPlace() {
+  S21_PROFILE_SCOPE(kTranspose, 0);
   if (matrix_ == nullptr || cols_ < 1 || rows_ < 1) {
     throw std::out_of_range("Invalid matrix");
   }
-  S21Matrix result(cols_, rows_);
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      result.matrix_[j][i] = matrix_[i][j];
+  _Detach();
+  if (rows_ == cols_) {
+    s21::TransposeSquareInPlace(rows_, matrix_, stride_);
+    return;
+  }
+  for (int i = 1; i < rows_; i++) {
+    std::copy(_Row(i), _Row(i) + cols_,
+              matrix_ + static_cast<std::size_t>(i) * cols_);
+  }
+  s21::TransposeDenseInPlace(rows_, cols_, matrix_);
+  std::swap(rows_, cols_);
+  stride_ = cols_;
+  const int padded = _Stride(cols_);
+  if (padded != cols_ &&
+      static_cast<std::size_t>(rows_) * padded <= capacity_) {
+    for (int i = rows_ - 1; i > 0; i--) {
+      const T* row = matrix_ + static_cast<std::size_t>(i) * cols_;
+      T* target = matrix_ + static_cast<std::size_t>(i) * padded;
+      std::copy_backward(row, row + cols_, target + cols_);
     }
+    stride_ = padded;
   }
-  return result;
 }
 
-double S21Matrix::Determinant() {
-  double det = 0.;
+template <class T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(
+    const S21TransposeExpr<S21MatrixLeaf<T>>& expr) {
+  S21_PROFILE_SCOPE(kTranspose, 0);
+  if (expr.Inner().data() == matrix_) {
+    TransposeInPlace();
+  } else if (matrix_ != nullptr && !IsShared() && expr.GetRows() == rows_ &&
+             expr.GetCols() == cols_) {
+    _Evaluate(expr);
+  } else {
+    S21BasicMatrix result(expr);
+    *this = std::move(result);
+  }
+  return *this;
+}
+
+template <class T>
+void S21BasicMatrix<T>::_Evaluate(
+    const S21TransposeExpr<S21MatrixLeaf<T>>& node) {
+  const S21MatrixLeaf<T>& source = node.Inner();
+  s21::Transpose(source.GetRows(), source.GetCols(), source.data(),
+                 source.stride(), matrix_, stride_);
+}
+
+template <class T>
+T S21BasicMatrix<T>::Determinant() {
+  S21_PROFILE_SCOPE(kDeterminant, 2. / 3 * rows_ * rows_ * rows_);
   if (rows_ != cols_)
     throw std::invalid_argument("Matrix is not square");
   else if (matrix_ == nullptr || cols_ < 1 || rows_ < 1)
     throw std::out_of_range("Invalid matrix");
-  det = _Matrix_Determinant(*this, rows_, cols_);
-  return det;
-}
-
-double S21Matrix::_Matrix_Determinant(const S21Matrix& other, int row,
-                                      int column) {
-  double det = 0;
-  if (column == 2 && row == 2) {
-    det += other.matrix_[0][0] * other.matrix_[1][1] -
-           other.matrix_[0][1] * other.matrix_[1][0];
-  } else if (column == 1 && row == 1) {
-    det += other.matrix_[0][0];
-  } else if (column > 2 && row > 2) {
-    S21Matrix new_matrix(row, column);
-    for (int i = 0; i < column; i++) {
-      int matrix_i = 0;
-      for (int j = 1; j < row; j++) {
-        int matrix_j = 0;
-        for (int k = 0; k < row; k++) {
-          if (k != i) {
-            new_matrix.matrix_[matrix_i][matrix_j] = other.matrix_[j][k];
-            matrix_j++;
-          }
-        }
-        matrix_i++;
-      }
-      det += other.matrix_[0][i] * pow(-1, i) *
-             _Matrix_Determinant(new_matrix, row - 1, column - 1);
-    }
-  }
-  return det;
+  return S21BasicLU<T>(*this).Determinant();
 }
 
-S21Matrix S21Matrix::CalcComplements() {
+// The factorization runs on a copy converted to the accumulation type.
+template <class T>
+typename S21Accumulator<T>::Type S21BasicMatrix<T>::DeterminantMixed() const {
+  S21_PROFILE_SCOPE(kDeterminant, 2. / 3 * rows_ * rows_ * rows_);
+  using Acc = typename S21Accumulator<T>::Type;
   if (rows_ != cols_)
     throw std::invalid_argument("Matrix is not square");
   else if (matrix_ == nullptr || cols_ < 1 || rows_ < 1)
     throw std::out_of_range("Invalid matrix");
-  S21Matrix new_matrix(rows_, cols_);
-  S21Matrix result(rows_, cols_);
+  return S21BasicLU<Acc>(S21BasicMatrix<Acc>(*this)).Determinant();
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements() {
+  S21_PROFILE_SCOPE(kComplements, 2. / 3 * rows_ * rows_ * (rows_ - 1.) *
+                                      (rows_ - 1.) * (rows_ - 1.));
+  if (rows_ != cols_)
+    throw std::invalid_argument("Matrix is not square");
+  else if (matrix_ == nullptr || cols_ < 1 || rows_ < 1)
+    throw std::out_of_range("Invalid matrix");
+  S21BasicMatrix result(rows_, cols_);
+  if (rows_ == 1) {
+    result._Row(0)[0] = 1;
+    return result;
+  }
+  // The minor without row i and column j is up to four blocks of this
+  // matrix, copied straight into the buffer the factorization works in.
+  const int n = rows_ - 1;
+  S21BasicMatrix minor_matrix(n, n);
+  const S21BasicMatrixView<const T> source = std::as_const(*this).View();
+  const S21BasicMatrixView<T> target = minor_matrix.View();
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
-      int matrix_i = 0;
-      for (int x = 0; x < cols_; x++) {
-        if (x == i) {
-          continue;
-        }
-        int matrix_j = 0;
-        for (int y = 0; y < rows_; y++) {
-          if (y != j) {
-            new_matrix.matrix_[matrix_i][matrix_j] = matrix_[x][y];
-            matrix_j++;
-          }
-        }
-        matrix_i++;
-      }
-      result.matrix_[i][j] =
-          _Matrix_Determinant(new_matrix, rows_ - 1, cols_ - 1) *
-          pow(-1, i + j);
+      const int below = n - i, right = n - j;
+      if (i > 0 && j > 0)
+        s21::Copy<T>(source.Block(0, 0, i, j), target.Block(0, 0, i, j));
+      if (i > 0 && right > 0)
+        s21::Copy<T>(source.Block(0, j + 1, i, right),
+                     target.Block(0, j, i, right));
+      if (below > 0 && j > 0)
+        s21::Copy<T>(source.Block(i + 1, 0, below, j),
+                     target.Block(i, 0, below, j));
+      if (below > 0 && right > 0)
+        s21::Copy<T>(source.Block(i + 1, j + 1, below, right),
+                     target.Block(i, j, below, right));
+      T minor = S21BasicLU<T>::DeterminantInPlace(target);
+      result._Row(i)[j] = (i + j) % 2 ? -minor : minor;
     }
   }
   return result;
 }
 
-S21Matrix S21Matrix::InverseMatrix() {
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix() {
+  S21_PROFILE_SCOPE(kInverse, 2. * rows_ * rows_ * rows_);
   if (matrix_ == nullptr || cols_ < 1 || rows_ < 1)
     throw std::out_of_range("Invalid matrix");
-  double det = 0;
-  det = Determinant();
-  if (det == 0) throw std::invalid_argument("Determinant equals 0");
-
-  S21Matrix temp(rows_, cols_);
-  temp = CalcComplements();
-  temp = temp.Transpose();
-  for (int i = 0; i < cols_; i++) {
-    for (int j = 0; j < rows_; j++) {
-      temp.matrix_[i][j] /= det;
-    }
-  }
-  return temp;
+  S21BasicLU<T> lu(*this);
+  if (lu.IsSingular()) throw std::invalid_argument("Determinant equals 0");
+  return lu.Inverse();
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Solve(const S21BasicMatrix& b) {
+  return Solve(b.View());
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Solve(S21BasicMatrixView<const T> b) {
+  S21_PROFILE_SCOPE(kSolve, 2. / 3 * rows_ * rows_ * rows_ +
+                                2. * rows_ * rows_ * b.GetCols());
+  if (matrix_ == nullptr || cols_ < 1 || rows_ < 1)
+    throw std::out_of_range("Invalid matrix");
+  return S21BasicLU<T>(*this).Solve(b);
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::SolveCholesky(const S21BasicMatrix& b) {
+  return SolveCholesky(b.View());
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::SolveCholesky(
+    S21BasicMatrixView<const T> b) {
+  S21_PROFILE_SCOPE(kSolve, 1. / 3 * rows_ * rows_ * rows_ +
+                                2. * rows_ * rows_ * b.GetCols());
+  if (matrix_ == nullptr || cols_ < 1 || rows_ < 1)
+    throw std::out_of_range("Invalid matrix");
+  return S21BasicCholesky<T>(*this).Solve(b);
 }
 
-int S21Matrix::GetRows() const noexcept { return rows_; }
-int S21Matrix::GetCols() const noexcept { return cols_; }
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::SolveLeastSquares(
+    const S21BasicMatrix& b) {
+  return SolveLeastSquares(b.View());
+}
 
-void S21Matrix::SetRows(int rows) {
-  S21Matrix result(rows, cols_);
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::SolveLeastSquares(
+    S21BasicMatrixView<const T> b) {
+  S21_PROFILE_SCOPE(kSolve, 2. * rows_ * cols_ * cols_ -
+                                2. / 3 * cols_ * cols_ * cols_ +
+                                4. * rows_ * cols_ * b.GetCols());
+  if (matrix_ == nullptr || cols_ < 1 || rows_ < 1)
+    throw std::out_of_range("Invalid matrix");
+  return S21BasicQR<T>(*this).Solve(b);
+}
+
+template <class T>
+int S21BasicMatrix<T>::GetRows() const noexcept { return rows_; }
+template <class T>
+int S21BasicMatrix<T>::GetCols() const noexcept { return cols_; }
+
+// Like std::vector, the buffer only ever grows and does so geometrically, so
+// a sequence of SetRows/SetCols calls that adds one row or column at a time
+// reallocates O(log n) times. Shrinking keeps the leading rows and columns.
+template <class T>
+void S21BasicMatrix<T>::SetRows(int rows) {
+  if (matrix_ == nullptr || rows < 1) throw std::out_of_range("Invalid matrix");
+  _Detach();
+  const std::size_t needed = static_cast<std::size_t>(rows) * stride_;
+  if (needed > capacity_) _Reallocate(stride_, std::max(needed, 2 * capacity_));
   if (rows > rows_) {
-    for (int i = 0; i < rows; i++) {
-      for (int j = 0; j < cols_; j++) {
-        if (i >= rows_)
-          result.matrix_[i][j] = 0;
-        else
-          result.matrix_[i][j] = matrix_[i][j];
+    std::fill(_Row(rows_), _Row(rows), T(0));
+  }
+  rows_ = rows;
+}
+
+template <class T>
+void S21BasicMatrix<T>::SetCols(int cols) {
+  if (matrix_ == nullptr || cols < 1) throw std::out_of_range("Invalid matrix");
+  _Detach();
+  if (cols > stride_) {
+    const int stride = _Stride(std::max(cols, 2 * stride_));
+    const std::size_t needed = static_cast<std::size_t>(rows_) * stride;
+    if (needed <= capacity_) {
+      for (int i = rows_ - 1; i > 0; i--) {
+        const T* row = _Row(i);
+        std::copy_backward(row, row + cols_,
+                           matrix_ + static_cast<std::size_t>(i) * stride +
+                               cols_);
       }
+      stride_ = stride;
+    } else {
+      _Reallocate(stride, std::max(needed, 2 * capacity_));
     }
   }
-  *this = result;
-}
-void S21Matrix::SetCols(int cols) {
-  S21Matrix result(rows_, cols);
   if (cols > cols_) {
     for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < cols; j++) {
-        if (j >= cols_)
-          result.matrix_[i][j] = 0;
-        else
-          result.matrix_[i][j] = matrix_[i][j];
-      }
+      std::fill(_Row(i) + cols_, _Row(i) + cols, T(0));
     }
   }
-  *this = result;
+  cols_ = cols;
 }
 
-S21Matrix& S21Matrix::operator=(const S21Matrix& other) {
+// Moves the rows to a new buffer of capacity elements with the given stride.
+template <class T>
+void S21BasicMatrix<T>::_Reallocate(int stride, std::size_t capacity) {
+  T* buffer = static_cast<T*>(
+      resource_->allocate(capacity * sizeof(T), kAlignment));
+  S21_PROFILE_ALLOCATED(capacity * sizeof(T));
+  std::fill(buffer, buffer + capacity, T(0));
   for (int i = 0; i < rows_; i++) {
-    delete[] matrix_[i];
-  }
-  delete[] matrix_;
-  cols_ = other.cols_;
-  rows_ = other.rows_;
-  matrix_ = new double*[other.rows_];
-  for (int i = 0; i < other.rows_; i++) {
-    matrix_[i] = new double[other.cols_];
+    std::copy(_Row(i), _Row(i) + cols_,
+              buffer + static_cast<std::size_t>(i) * stride);
   }
-  for (int i = 0; i < other.rows_; i++) {
-    for (int j = 0; j < other.cols_; j++) {
-      matrix_[i][j] = other.matrix_[i][j];
+  S21_PROFILE_COPIED(sizeof(T) * rows_ * cols_);
+  resource_->deallocate(matrix_, capacity_ * sizeof(T), kAlignment);
+  matrix_ = buffer;
+  capacity_ = capacity;
+  stride_ = stride;
+}
+
+// The existing buffer is reused whenever the copy fits into it; a new one is
+// allocated from this matrix's resource otherwise.
+template <class T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(const S21BasicMatrix& other) {
+  S21_PROFILE_SCOPE(kCopy, 0);
+  if (other.matrix_ == nullptr) {
+    FreeMatrix();
+  } else if (_CanShare(other)) {
+    if (refs_ != other.refs_) {
+      FreeMatrix();
+      _Share(other);
     }
+  } else if (this != &other) {
+    int stride = other.cols_ <= stride_ ? stride_ : _Stride(other.cols_);
+    if (matrix_ != nullptr && !IsShared() &&
+        static_cast<std::size_t>(other.rows_) * stride <= capacity_) {
+      rows_ = other.rows_;
+      cols_ = other.cols_;
+      stride_ = stride;
+      for (int i = 0; i < rows_; i++) {
+        std::copy(other._Row(i), other._Row(i) + cols_, _Row(i));
+      }
+    } else {
+      S21BasicMatrix copy(other.rows_, other.cols_, resource_);
+      for (int i = 0; i < other.rows_; i++) {
+        std::copy(other._Row(i), other._Row(i) + other.cols_, copy._Row(i));
+      }
+      *this = std::move(copy);
+    }
+    S21_PROFILE_COPIED(sizeof(T) * rows_ * cols_);
   }
   return *this;
 }
 
-S21Matrix& S21Matrix::operator=(S21Matrix&& other) noexcept {
-  for (int i = 0; i < rows_; i++) {
-    delete[] matrix_[i];
+template <class T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(
+    S21BasicMatrix&& other) noexcept {
+  if (this != &other) {
+    FreeMatrix();
+    resource_ = other.resource_;
+    cols_ = other.cols_;
+    rows_ = other.rows_;
+    stride_ = other.stride_;
+    capacity_ = other.capacity_;
+    matrix_ = other.matrix_;
+    refs_ = other.refs_;
+    other.cols_ = 0;
+    other.rows_ = 0;
+    other.stride_ = 0;
+    other.capacity_ = 0;
+    other.matrix_ = nullptr;
+    other.refs_ = nullptr;
   }
-  delete[] matrix_;
-  cols_ = other.cols_;
-  rows_ = other.rows_;
-  matrix_ = other.matrix_;
-  other.cols_ = 0;
-  other.rows_ = 0;
-  other.matrix_ = nullptr;
   return *this;
 }
 
-double& S21Matrix::operator()(int i, int j) {
+template <class T>
+T& S21BasicMatrix<T>::operator()(int i, int j) {
   if (i >= rows_ || j >= cols_ || i < 0 || j < 0) {
     throw std::out_of_range("Invalid index");
   }
-  return matrix_[i][j];
+  _Detach();
+  return _Row(i)[j];
 }
 
-S21Matrix S21Matrix::operator+(const S21Matrix& other) const {
-  S21Matrix result(*this);
-  result.SumMatrix(other);
-  return result;
+template <class T>
+T* S21BasicMatrix<T>::data() {
+  _Detach();
+  return matrix_;
+}
+template <class T>
+const T* S21BasicMatrix<T>::data() const noexcept { return matrix_; }
+template <class T>
+int S21BasicMatrix<T>::stride() const noexcept { return stride_; }
+template <class T>
+std::pmr::memory_resource* S21BasicMatrix<T>::GetResource() const noexcept {
+  return resource_;
+}
+template <class T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::View() {
+  return S21BasicMatrixView<T>(*this);
+}
+template <class T>
+S21BasicMatrixView<const T> S21BasicMatrix<T>::View() const noexcept {
+  return S21BasicMatrixView<const T>(*this);
 }
 
-S21Matrix& S21Matrix::operator+=(const S21Matrix& other) {
+template <class T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(const S21BasicMatrix& other) {
   SumMatrix(other);
   return *this;
 }
 
-S21Matrix S21Matrix::operator-(const S21Matrix& other) const {
-  S21Matrix result(*this);
-  result.SubMatrix(other);
-  return result;
-}
-
-S21Matrix& S21Matrix::operator-=(const S21Matrix& other) {
+template <class T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(const S21BasicMatrix& other) {
   SubMatrix(other);
   return *this;
 }
 
-S21Matrix S21Matrix::operator*(const S21Matrix& other) const {
-  S21Matrix result(*this);
-  result.MulMatrix(other);
-  return result;
-}
-
-S21Matrix& S21Matrix::operator*=(const S21Matrix& other) {
+template <class T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(const S21BasicMatrix& other) {
   MulMatrix(other);
   return *this;
 }
 
-S21Matrix S21Matrix::operator*(const double num) const {
-  S21Matrix result(*this);
-  result.MulNumber(num);
-  return result;
-}
-
-S21Matrix operator*(const double num, const S21Matrix& other) {
-  S21Matrix result(other);
-  result.MulNumber(num);
-  return result;
-}
-
-S21Matrix& S21Matrix::operator*=(const double num) {
+template <class T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(const T num) {
   MulNumber(num);
   return *this;
 }
 
-bool S21Matrix::operator==(const S21Matrix& other) const noexcept {
+template <class T>
+bool S21BasicMatrix<T>::operator==(const S21BasicMatrix& other) const noexcept {
   return EqMatrix(other);
-}
\ No newline at end of file
+}
+
+template class S21BasicMatrix<float>;
+template class S21BasicMatrix<double>;
+template class S21BasicMatrix<long double>;
@@ -3,59 +3,238 @@
 
 #include <math.h>
 
+#include <atomic>
+#include <cstddef>
 #include <iostream>
+#include <memory_resource>
+#include <string>
+
+#include "s21_strassen.h"
 
 #define NO_PROBLEMO 1
 #define FAILURE 0
 
-class S21Matrix {
+// Base of every lazily evaluated matrix expression (see s21_matrix_expr.h).
+template <class Derived>
+class S21Expression {
  public:
-  S21Matrix();
-  S21Matrix(int rows, int cols);
-  S21Matrix(S21Matrix&& other) noexcept;
-  S21Matrix(const S21Matrix& other);
-  S21Matrix& operator=(const S21Matrix& other);
-  S21Matrix& operator=(S21Matrix&& other) noexcept;
-  ~S21Matrix();
-
-  S21Matrix operator+(const S21Matrix& other) const;
-  S21Matrix operator-(const S21Matrix& other) const;
-  S21Matrix operator*(const S21Matrix& other) const;
-  S21Matrix operator*(const double num) const;
-  friend S21Matrix operator*(const double num, const S21Matrix& other);
-  S21Matrix& operator+=(const S21Matrix& other);
-  S21Matrix& operator-=(const S21Matrix& other);
-  S21Matrix& operator*=(const S21Matrix& other);
-  S21Matrix& operator*=(const double num);
-  bool operator==(const S21Matrix& other) const noexcept;
-  double& operator()(int i, int j);
-
-  void _FillMatrix(double val) noexcept;
-  bool _CheckMatrix(const S21Matrix& other) const noexcept;
+  const Derived& Self() const noexcept {
+    return static_cast<const Derived&>(*this);
+  }
+};
+
+template <class E>
+class S21TransposeExpr;
+template <class T>
+class S21MatrixLeaf;
+template <class T>
+class S21BasicMatrixView;
+
+// Absolute per-element tolerance of EqMatrix and operator== for each element
+// type, a few hundred ulps of a value around 1.
+template <class T>
+struct S21Tolerance;
+
+template <>
+struct S21Tolerance<float> {
+  static constexpr float kEqual = 1e-4f;
+};
+
+template <>
+struct S21Tolerance<double> {
+  static constexpr double kEqual = 1e-7;
+};
+
+template <>
+struct S21Tolerance<long double> {
+  static constexpr long double kEqual = 1e-10L;
+};
+
+// Type the mixed-precision operations accumulate in.
+template <class T>
+struct S21Accumulator {
+  using Type = T;
+};
+
+template <>
+struct S21Accumulator<float> {
+  using Type = double;
+};
+
+// Dense row-major matrix of float, double or long double; S21Matrix is the
+// double one. Every kernel (SIMD, GEMM, LU, transpose) exists for each of
+// the three types.
+template <class T>
+class S21BasicMatrix : public S21Expression<S21BasicMatrix<T>> {
+ public:
+  using Scalar = T;
+
+  S21BasicMatrix();
+  S21BasicMatrix(int rows, int cols);
+  // Allocates the buffer from resource, which must outlive the matrix.
+  S21BasicMatrix(int rows, int cols, std::pmr::memory_resource* resource);
+  S21BasicMatrix(S21BasicMatrix&& other) noexcept;
+  S21BasicMatrix(const S21BasicMatrix& other);
+  // Element-wise conversion from another element type.
+  template <class U>
+  explicit S21BasicMatrix(const S21BasicMatrix<U>& other);
+  template <class E>
+  S21BasicMatrix(const S21Expression<E>& expr);
+  // Copies the elements of a view into a new matrix.
+  explicit S21BasicMatrix(S21BasicMatrixView<const T> view);
+  S21BasicMatrix& operator=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator=(S21BasicMatrix&& other) noexcept;
+  template <class E>
+  S21BasicMatrix& operator=(const S21Expression<E>& expr);
+  S21BasicMatrix& operator=(const S21TransposeExpr<S21MatrixLeaf<T>>& expr);
+  ~S21BasicMatrix();
+
+  S21BasicMatrix& operator+=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator-=(const S21BasicMatrix& other);
+  template <class E>
+  S21BasicMatrix& operator+=(const S21Expression<E>& expr);
+  template <class E>
+  S21BasicMatrix& operator-=(const S21Expression<E>& expr);
+  S21BasicMatrix& operator*=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator*=(const T num);
+  bool operator==(const S21BasicMatrix& other) const noexcept;
+  T& operator()(int i, int j);
+
+  T* data();
+  const T* data() const noexcept;
+  int stride() const noexcept;
+  std::pmr::memory_resource* GetResource() const noexcept;
+  // The whole matrix as a view; slice it with Block, RowRange, ColRange and
+  // Transposed.
+  S21BasicMatrixView<T> View();
+  S21BasicMatrixView<const T> View() const noexcept;
+
+  // Resource used by matrices created on this thread without an explicit
+  // one. SetDefaultResource returns the previous resource. The setting is
+  // shared by all element types.
+  static std::pmr::memory_resource* GetDefaultResource() noexcept;
+  static std::pmr::memory_resource* SetDefaultResource(
+      std::pmr::memory_resource* resource) noexcept;
+
+  // Copy-on-write, off by default. Buffers allocated on this thread while it
+  // is on carry an atomic reference count, and copies of such a matrix made
+  // while it is on share the buffer in O(1) when they would use the same
+  // memory resource. The first mutating call on a shared matrix
+  // (operator(), data(), a mutable View(), SumMatrix, SetRows, assignment of
+  // an expression, ...) copies the buffer for itself, so a pointer or view
+  // taken before a later copy still writes to the shared buffer. Read-only
+  // copies may be used from several threads. The setting is shared by all
+  // element types; SetCopyOnWrite returns the previous one.
+  static bool GetCopyOnWrite() noexcept;
+  static bool SetCopyOnWrite(bool enabled) noexcept;
+  // True while another matrix shares the buffer.
+  bool IsShared() const noexcept;
+
+  void _FillMatrix(T val);
+  bool _CheckMatrix(const S21BasicMatrix& other) const noexcept;
 
   int GetRows() const noexcept;
   int GetCols() const noexcept;
+  // Resize the matrix itself; a RowRange or ColRange view works on part of
+  // it without touching the buffer.
   void SetRows(int rows);
   void SetCols(int cols);
-  bool EqMatrix(const S21Matrix& other) const noexcept;
-  void SumMatrix(const S21Matrix& other);
-  void SubMatrix(const S21Matrix& other);
-  void MulNumber(const double num);
-  void MulMatrix(const S21Matrix& other);
-  double Determinant();
+  // Uses S21Tolerance<T>::kEqual unless a tolerance is given.
+  bool EqMatrix(const S21BasicMatrix& other) const noexcept;
+  bool EqMatrix(const S21BasicMatrix& other, T tolerance) const noexcept;
+  bool EqMatrix(S21BasicMatrixView<const T> other) const noexcept;
+  bool EqMatrix(S21BasicMatrixView<const T> other, T tolerance) const noexcept;
+  void SumMatrix(const S21BasicMatrix& other);
+  void SumMatrix(S21BasicMatrixView<const T> other);
+  void SubMatrix(const S21BasicMatrix& other);
+  void SubMatrix(S21BasicMatrixView<const T> other);
+  void MulNumber(const T num);
+  // Products use s21::GetMulAlgorithm() unless an algorithm is given; see
+  // s21_strassen.h for when Strassen-Winograd pays off and its accuracy.
+  void MulMatrix(const S21BasicMatrix& other);
+  void MulMatrix(S21BasicMatrixView<const T> other);
+  void MulMatrix(S21BasicMatrixView<const T> other,
+                 s21::MulAlgorithm algorithm);
+  // c := alpha * a * b + beta * c on matrices or views of them.
+  static void Gemm(T alpha, S21BasicMatrixView<const T> a,
+                   S21BasicMatrixView<const T> b, T beta,
+                   S21BasicMatrixView<T> c);
+  T Determinant();
 
-  S21Matrix Transpose();
-  S21Matrix CalcComplements();
-  S21Matrix InverseMatrix();
+  // Mixed precision: the product is accumulated and the determinant
+  // factorized in S21Accumulator<T>::Type (double for float matrices) while
+  // the operands stay in T.
+  void MulMatrixMixed(const S21BasicMatrix& other);
+  typename S21Accumulator<T>::Type DeterminantMixed() const;
+
+  S21TransposeExpr<S21MatrixLeaf<T>> Transpose() const;
+  void TransposeInPlace();
+  S21BasicMatrix CalcComplements();
+  S21BasicMatrix InverseMatrix();
+  // A x = b for every column of b, through LU with partial pivoting. To
+  // reuse a factorization across calls, keep the S21BasicLU, S21BasicCholesky
+  // or S21BasicQR itself.
+  S21BasicMatrix Solve(const S21BasicMatrix& b);
+  S21BasicMatrix Solve(S21BasicMatrixView<const T> b);
+  // A x = b through Cholesky for a symmetric positive definite matrix, of
+  // which only the lower triangle is read; half the flops of Solve.
+  S21BasicMatrix SolveCholesky(const S21BasicMatrix& b);
+  S21BasicMatrix SolveCholesky(S21BasicMatrixView<const T> b);
+  // x minimizing |A x - b| through Householder QR, for rows >= cols.
+  S21BasicMatrix SolveLeastSquares(const S21BasicMatrix& b);
+  S21BasicMatrix SolveLeastSquares(S21BasicMatrixView<const T> b);
+
+  // Binary file in the format of s21_matrix_file.h. Load checks the header
+  // and the checksum; S21BasicMappedMatrix opens a file without reading it.
+  void Save(const std::string& path) const;
+  static S21BasicMatrix Load(const std::string& path);
 
  private:
-  double** matrix_;
+  static constexpr std::size_t kAlignment = 64;
+
+  std::pmr::memory_resource* resource_;
+  T* matrix_;
+  std::size_t capacity_;
   int rows_;
   int cols_;
+  int stride_;
+  // Reference count of a copy-on-write buffer, null for a private one.
+  std::atomic<long>* refs_;
   void CreateMatrix(int rows, int columns);
+  void FreeMatrix() noexcept;
+  bool _CanShare(const S21BasicMatrix& other) const noexcept;
+  void _Share(const S21BasicMatrix& other) noexcept;
+  void _Detach();
+  static int _Stride(int cols) noexcept;
+  void _Reallocate(int stride, std::size_t capacity);
+  T* _Row(int i) const noexcept {
+    return matrix_ + static_cast<std::size_t>(i) * stride_;
+  }
 
-  double _Matrix_Determinant(const S21Matrix& other, int row, int column);
-  void _SumAndSubMatrix(char plus_or_minus, const S21Matrix& other);
+  template <class E>
+  void _Evaluate(const E& node);
+  void _Evaluate(const S21TransposeExpr<S21MatrixLeaf<T>>& node);
 };
 
-#endif
\ No newline at end of file
+using S21Matrix = S21BasicMatrix<double>;
+using S21FloatMatrix = S21BasicMatrix<float>;
+using S21LongDoubleMatrix = S21BasicMatrix<long double>;
+
+extern template class S21BasicMatrix<float>;
+extern template class S21BasicMatrix<double>;
+extern template class S21BasicMatrix<long double>;
+
+template <class T>
+template <class U>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix<U>& other)
+    : S21BasicMatrix(other.GetRows(), other.GetCols()) {
+  for (int i = 0; i < rows_; i++) {
+    const U* row = other.data() + static_cast<std::size_t>(i) * other.stride();
+    for (int j = 0; j < cols_; j++) _Row(i)[j] = static_cast<T>(row[j]);
+  }
+}
+
+#include "s21_matrix_expr.h"
+#include "s21_matrix_view.h"
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_H
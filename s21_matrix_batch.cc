@@ -0,0 +1,441 @@
+#include "s21_matrix_batch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Calls body(begin, end) on runs of at most block matrices, spread over the
+// pool when a matrix costs work_per_matrix operations.
+template <class Body>
+void ForEachLaneBlock(int count, int block, std::ptrdiff_t work_per_matrix,
+                      const Body& body) {
+  std::ptrdiff_t grain =
+      std::max<std::ptrdiff_t>(block, s21::ParallelGrain(work_per_matrix));
+  s21::ParallelFor(count, grain,
+                   [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                     for (std::ptrdiff_t b = begin; b < end; b += block) {
+                       body(static_cast<int>(b),
+                            static_cast<int>(std::min(end, b + block)));
+                     }
+                   });
+}
+
+// Working copy of the square matrices [begin, end) of a batch, interleaved
+// with a lane count of end - begin so one element of all of them is a short
+// contiguous run.
+template <class T>
+class LaneTile {
+ public:
+  LaneTile(int size, int width)
+      : size_(size),
+        width_(width),
+        data_(static_cast<std::size_t>(size) * size * width) {}
+
+  T* At(int i, int j) noexcept {
+    return data_.data() +
+           (static_cast<std::size_t>(i) * size_ + j) * width_;
+  }
+
+  void Load(const S21BasicMatrixBatch<T>& batch, int begin) {
+    for (int i = 0; i < size_; i++) {
+      for (int j = 0; j < size_; j++) {
+        const T* lane = batch.Lane(i, j) + begin;
+        std::copy(lane, lane + width_, At(i, j));
+      }
+    }
+  }
+
+  void Store(S21BasicMatrixBatch<T>& batch, int begin) {
+    for (int i = 0; i < size_; i++) {
+      for (int j = 0; j < size_; j++) {
+        std::copy(At(i, j), At(i, j) + width_, batch.Lane(i, j) + begin);
+      }
+    }
+  }
+
+  // Exchanges rows r and s of matrix l from column first on.
+  void SwapRows(int l, int r, int s, int first) noexcept {
+    for (int j = first; j < size_; j++) std::swap(At(r, j)[l], At(s, j)[l]);
+  }
+
+  // Row of the largest |element| of column k of matrix l among rows k..size.
+  int PivotRow(int l, int k) noexcept {
+    int pivot_row = k;
+    T pivot_abs = std::abs(At(k, k)[l]);
+    for (int i = k + 1; i < size_; i++) {
+      T candidate = std::abs(At(i, k)[l]);
+      if (candidate > pivot_abs) {
+        pivot_abs = candidate;
+        pivot_row = i;
+      }
+    }
+    return pivot_row;
+  }
+
+ private:
+  int size_;
+  int width_;
+  std::vector<T> data_;
+};
+
+}  // namespace
+
+template <class T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(int count, int rows, int cols)
+    : S21BasicMatrixBatch(count, rows, cols,
+                          S21BasicMatrix<T>::GetDefaultResource()) {}
+
+template <class T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(
+    int count, int rows, int cols, std::pmr::memory_resource* resource)
+    : count_(count), rows_(rows), cols_(cols), stride_(0), data_(resource) {
+  if (count < 1 || rows < 1 || cols < 1)
+    throw std::out_of_range("Invalid matrix");
+  stride_ = _LaneStride(count);
+  data_.resize(static_cast<std::size_t>(stride_) * rows * cols);
+}
+
+template <class T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(
+    const std::vector<S21BasicMatrix<T>>& matrices)
+    : S21BasicMatrixBatch(static_cast<int>(matrices.size()),
+                          matrices.empty() ? 0 : matrices[0].GetRows(),
+                          matrices.empty() ? 0 : matrices[0].GetCols()) {
+  for (int index = 0; index < count_; index++) Set(index, matrices[index]);
+}
+
+template <class T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(const S21BasicMatrixBatch& other)
+    : count_(other.count_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(other.stride_),
+      data_(other.data_, S21BasicMatrix<T>::GetDefaultResource()) {}
+
+template <class T>
+S21BasicMatrixBatch<T>& S21BasicMatrixBatch<T>::operator+=(
+    const S21BasicMatrixBatch& other) {
+  SumBatch(other);
+  return *this;
+}
+
+template <class T>
+S21BasicMatrixBatch<T>& S21BasicMatrixBatch<T>::operator-=(
+    const S21BasicMatrixBatch& other) {
+  SubBatch(other);
+  return *this;
+}
+
+template <class T>
+S21BasicMatrixBatch<T>& S21BasicMatrixBatch<T>::operator*=(
+    const S21BasicMatrixBatch& other) {
+  MulBatch(other);
+  return *this;
+}
+
+template <class T>
+S21BasicMatrixBatch<T>& S21BasicMatrixBatch<T>::operator*=(const T num) {
+  MulNumber(num);
+  return *this;
+}
+
+template <class T>
+bool S21BasicMatrixBatch<T>::operator==(
+    const S21BasicMatrixBatch& other) const noexcept {
+  return EqBatch(other);
+}
+
+template <class T>
+T& S21BasicMatrixBatch<T>::operator()(int index, int i, int j) {
+  _CheckIndex(index, i, j);
+  return Lane(i, j)[index];
+}
+
+template <class T>
+T S21BasicMatrixBatch<T>::operator()(int index, int i, int j) const {
+  _CheckIndex(index, i, j);
+  return Lane(i, j)[index];
+}
+
+template <class T>
+int S21BasicMatrixBatch<T>::GetCount() const noexcept {
+  return count_;
+}
+
+template <class T>
+int S21BasicMatrixBatch<T>::GetRows() const noexcept {
+  return rows_;
+}
+
+template <class T>
+int S21BasicMatrixBatch<T>::GetCols() const noexcept {
+  return cols_;
+}
+
+template <class T>
+int S21BasicMatrixBatch<T>::LaneStride() const noexcept {
+  return stride_;
+}
+
+template <class T>
+T* S21BasicMatrixBatch<T>::Lane(int i, int j) noexcept {
+  return data_.data() + (static_cast<std::size_t>(i) * cols_ + j) * stride_;
+}
+
+template <class T>
+const T* S21BasicMatrixBatch<T>::Lane(int i, int j) const noexcept {
+  return data_.data() + (static_cast<std::size_t>(i) * cols_ + j) * stride_;
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicMatrixBatch<T>::Get(int index) const {
+  _CheckIndex(index, 0, 0);
+  S21BasicMatrix<T> result(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    T* row = result.data() + static_cast<std::size_t>(i) * result.stride();
+    for (int j = 0; j < cols_; j++) row[j] = Lane(i, j)[index];
+  }
+  return result;
+}
+
+template <class T>
+void S21BasicMatrixBatch<T>::Set(int index, const S21BasicMatrix<T>& matrix) {
+  _CheckIndex(index, 0, 0);
+  if (matrix.data() == nullptr) throw std::out_of_range("Invalid matrix");
+  if (matrix.GetRows() != rows_ || matrix.GetCols() != cols_)
+    throw std::invalid_argument("Sizes are not equal");
+  for (int i = 0; i < rows_; i++) {
+    const T* row =
+        matrix.data() + static_cast<std::size_t>(i) * matrix.stride();
+    for (int j = 0; j < cols_; j++) Lane(i, j)[index] = row[j];
+  }
+}
+
+template <class T>
+bool S21BasicMatrixBatch<T>::EqBatch(
+    const S21BasicMatrixBatch& other) const noexcept {
+  return EqBatch(other, S21Tolerance<T>::kEqual);
+}
+
+// Lane by lane, so the padding between lanes is never compared.
+template <class T>
+bool S21BasicMatrixBatch<T>::EqBatch(const S21BasicMatrixBatch& other,
+                                     T tolerance) const noexcept {
+  if (!_SameShape(other)) return false;
+  const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) {
+      if (!simd.equal(Lane(i, j), other.Lane(i, j), count_, tolerance))
+        return false;
+    }
+  }
+  return true;
+}
+
+template <class T>
+void S21BasicMatrixBatch<T>::SumBatch(const S21BasicMatrixBatch& other) {
+  _SumAndSubBatch('+', other);
+}
+
+template <class T>
+void S21BasicMatrixBatch<T>::SubBatch(const S21BasicMatrixBatch& other) {
+  _SumAndSubBatch('-', other);
+}
+
+// The whole batch, padding included, is one contiguous array, so
+// element-wise operations are a single kernel call per thread.
+template <class T>
+void S21BasicMatrixBatch<T>::_SumAndSubBatch(
+    char plus_or_minus, const S21BasicMatrixBatch& other) {
+  if (!_SameShape(other)) throw std::invalid_argument("Sizes are not equal");
+  const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+  auto kernel = plus_or_minus == '+' ? simd.add : simd.sub;
+  T* out = data_.data();
+  const T* in = other.data_.data();
+  s21::ParallelFor(data_.size(), s21::ParallelGrain(1),
+                   [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                     kernel(out + begin, in + begin, out + begin,
+                            end - begin);
+                   });
+}
+
+template <class T>
+void S21BasicMatrixBatch<T>::MulNumber(const T num) {
+  const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+  T* out = data_.data();
+  s21::ParallelFor(data_.size(), s21::ParallelGrain(1),
+                   [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                     simd.scale(out + begin, num, out + begin, end - begin);
+                   });
+}
+
+// C(i, j) += A(i, p) * B(p, j) for a run of matrices at a time. For small
+// shapes the run is what the vector registers are filled with.
+template <class T>
+void S21BasicMatrixBatch<T>::MulBatch(const S21BasicMatrixBatch& other) {
+  if (count_ != other.count_)
+    throw std::invalid_argument("Sizes are not equal");
+  if (cols_ != other.rows_)
+    throw std::invalid_argument(
+        "Columns first matrix not equal rows second matrix");
+  const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+  S21BasicMatrixBatch result(count_, rows_, other.cols_,
+                             data_.get_allocator().resource());
+  ForEachLaneBlock(
+      count_, kLaneBlock, 2 * static_cast<std::ptrdiff_t>(rows_) * cols_ *
+                              other.cols_,
+      [&](int begin, int end) {
+        for (int i = 0; i < rows_; i++) {
+          for (int j = 0; j < other.cols_; j++) {
+            T* c = result.Lane(i, j) + begin;
+            for (int p = 0; p < cols_; p++) {
+              simd.mul_add(Lane(i, p) + begin, other.Lane(p, j) + begin, c,
+                           end - begin);
+            }
+          }
+        }
+      });
+  *this = std::move(result);
+}
+
+// Right-looking elimination with partial pivoting, row by row of a
+// LaneTile. The operations are those of S21LU, so the determinants of
+// matrices up to its 64-column panel are bit-identical to S21Matrix ones.
+template <class T>
+std::vector<T> S21BasicMatrixBatch<T>::DeterminantBatch() const {
+  if (rows_ != cols_) throw std::invalid_argument("Matrix is not square");
+  const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+  const int n = rows_;
+  std::vector<T> result(count_);
+  ForEachLaneBlock(
+      count_, kLaneBlock, 2 * static_cast<std::ptrdiff_t>(n) * n * n / 3,
+      [&](int begin, int end) {
+        const int width = end - begin;
+        LaneTile<T> tile(n, width);
+        tile.Load(*this, begin);
+        std::vector<T> det(width, T(1)), pivot(width);
+        for (int k = 0; k < n; k++) {
+          for (int l = 0; l < width; l++) {
+            int pivot_row = tile.PivotRow(l, k);
+            if (pivot_row != k) {
+              tile.SwapRows(l, k, pivot_row, k);
+              det[l] = -det[l];
+            }
+            T value = tile.At(k, k)[l];
+            det[l] *= value;
+            // A zero pivot means a zero column below it; 1 keeps the lane
+            // free of NaNs.
+            pivot[l] = value != 0 ? value : T(1);
+          }
+          for (int i = k + 1; i < n; i++) {
+            T* factor = tile.At(i, k);
+            simd.div(factor, pivot.data(), factor, width);
+            for (int j = k + 1; j < n; j++) {
+              simd.mul_sub(factor, tile.At(k, j), tile.At(i, j), width);
+            }
+          }
+        }
+        std::copy(det.begin(), det.end(), result.begin() + begin);
+      });
+  return result;
+}
+
+// Gauss-Jordan on [A | I] with the pivot test of S21LU: a pivot no larger
+// than n * epsilon * max|A| marks the matrix as singular.
+template <class T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::InverseBatch() const {
+  if (rows_ != cols_) throw std::invalid_argument("Matrix is not square");
+  const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+  const int n = rows_;
+  S21BasicMatrixBatch result(count_, n, n, data_.get_allocator().resource());
+  ForEachLaneBlock(
+      count_, kLaneBlock, 2 * static_cast<std::ptrdiff_t>(n) * n * n,
+      [&](int begin, int end) {
+        const int width = end - begin;
+        LaneTile<T> tile(n, width), inverse(n, width);
+        tile.Load(*this, begin);
+        for (int i = 0; i < n; i++) {
+          std::fill(inverse.At(i, i), inverse.At(i, i) + width, T(1));
+        }
+        std::vector<T> tolerance(width, T(0)), pivot(width), factor(width);
+        for (int i = 0; i < n; i++) {
+          for (int j = 0; j < n; j++) {
+            for (int l = 0; l < width; l++) {
+              tolerance[l] = std::max(tolerance[l], std::abs(tile.At(i, j)[l]));
+            }
+          }
+        }
+        for (int l = 0; l < width; l++) {
+          tolerance[l] *= n * std::numeric_limits<T>::epsilon();
+        }
+        for (int k = 0; k < n; k++) {
+          for (int l = 0; l < width; l++) {
+            int pivot_row = tile.PivotRow(l, k);
+            if (pivot_row != k) {
+              tile.SwapRows(l, k, pivot_row, k);
+              inverse.SwapRows(l, k, pivot_row, 0);
+            }
+            if (std::abs(tile.At(k, k)[l]) <= tolerance[l])
+              throw std::invalid_argument("Determinant equals 0");
+          }
+          std::copy(tile.At(k, k), tile.At(k, k) + width, pivot.begin());
+          for (int j = k + 1; j < n; j++) {
+            simd.div(tile.At(k, j), pivot.data(), tile.At(k, j), width);
+          }
+          for (int j = 0; j < n; j++) {
+            simd.div(inverse.At(k, j), pivot.data(), inverse.At(k, j), width);
+          }
+          for (int i = 0; i < n; i++) {
+            if (i == k) continue;
+            std::copy(tile.At(i, k), tile.At(i, k) + width, factor.begin());
+            for (int j = k + 1; j < n; j++) {
+              simd.mul_sub(factor.data(), tile.At(k, j), tile.At(i, j),
+                           width);
+            }
+            for (int j = 0; j < n; j++) {
+              simd.mul_sub(factor.data(), inverse.At(k, j), inverse.At(i, j),
+                           width);
+            }
+          }
+        }
+        inverse.Store(result, begin);
+      });
+  return result;
+}
+
+template <class T>
+bool S21BasicMatrixBatch<T>::_SameShape(
+    const S21BasicMatrixBatch& other) const noexcept {
+  return count_ == other.count_ && rows_ == other.rows_ &&
+         cols_ == other.cols_;
+}
+
+// Lanes are padded to whole cache lines, and by one more line when that
+// would make the stride a multiple of 4 KB: the lanes a kernel reads
+// together would otherwise all map to the same cache sets.
+template <class T>
+int S21BasicMatrixBatch<T>::_LaneStride(int count) noexcept {
+  constexpr int kLine = 64 / sizeof(T) > 0 ? 64 / sizeof(T) : 1;
+  int stride = (count + kLine - 1) / kLine * kLine;
+  if (stride * sizeof(T) % 4096 == 0) stride += kLine;
+  return stride;
+}
+
+template <class T>
+void S21BasicMatrixBatch<T>::_CheckIndex(int index, int i, int j) const {
+  if (index < 0 || index >= count_ || i < 0 || i >= rows_ || j < 0 ||
+      j >= cols_)
+    throw std::out_of_range("Invalid index");
+}
+
+template class S21BasicMatrixBatch<float>;
+template class S21BasicMatrixBatch<double>;
+template class S21BasicMatrixBatch<long double>;
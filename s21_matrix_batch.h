@@ -0,0 +1,85 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_BATCH_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_BATCH_H
+
+#include <memory_resource>
+#include <vector>
+
+#include "s21_matrix.h"
+
+// count matrices of one rows x cols shape stored interleaved (structure of
+// arrays): element (i, j) of every matrix is contiguous, at
+// Lane(i, j)[index], and consecutive lanes are LaneStride() apart. A batched
+// operation validates the shapes once and runs each SIMD kernel across the
+// matrices rather than along a row, so small matrices fill whole registers.
+// Runs of matrices go to different threads.
+template <class T>
+class S21BasicMatrixBatch {
+ public:
+  S21BasicMatrixBatch(int count, int rows, int cols);
+  // Allocates the buffer from resource, which must outlive the batch.
+  S21BasicMatrixBatch(int count, int rows, int cols,
+                      std::pmr::memory_resource* resource);
+  // Packs matrices of equal shape.
+  explicit S21BasicMatrixBatch(const std::vector<S21BasicMatrix<T>>& matrices);
+  S21BasicMatrixBatch(const S21BasicMatrixBatch& other);
+  S21BasicMatrixBatch(S21BasicMatrixBatch&& other) noexcept = default;
+  S21BasicMatrixBatch& operator=(const S21BasicMatrixBatch& other) = default;
+  S21BasicMatrixBatch& operator=(S21BasicMatrixBatch&& other) = default;
+  ~S21BasicMatrixBatch() = default;
+
+  S21BasicMatrixBatch& operator+=(const S21BasicMatrixBatch& other);
+  S21BasicMatrixBatch& operator-=(const S21BasicMatrixBatch& other);
+  S21BasicMatrixBatch& operator*=(const S21BasicMatrixBatch& other);
+  S21BasicMatrixBatch& operator*=(const T num);
+  bool operator==(const S21BasicMatrixBatch& other) const noexcept;
+  T& operator()(int index, int i, int j);
+  T operator()(int index, int i, int j) const;
+
+  int GetCount() const noexcept;
+  int GetRows() const noexcept;
+  int GetCols() const noexcept;
+  int LaneStride() const noexcept;
+  T* Lane(int i, int j) noexcept;
+  const T* Lane(int i, int j) const noexcept;
+
+  S21BasicMatrix<T> Get(int index) const;
+  void Set(int index, const S21BasicMatrix<T>& matrix);
+
+  // The S21BasicMatrix operations, applied to every matrix of the batch.
+  bool EqBatch(const S21BasicMatrixBatch& other) const noexcept;
+  bool EqBatch(const S21BasicMatrixBatch& other, T tolerance) const noexcept;
+  void SumBatch(const S21BasicMatrixBatch& other);
+  void SubBatch(const S21BasicMatrixBatch& other);
+  void MulNumber(const T num);
+  void MulBatch(const S21BasicMatrixBatch& other);
+  // Partial pivoting is done per matrix. InverseBatch throws when any of
+  // the matrices is singular.
+  std::vector<T> DeterminantBatch() const;
+  S21BasicMatrixBatch InverseBatch() const;
+
+ private:
+  // Matrices handled together by one pass of the factorizations; their
+  // working copies stay in L2.
+  static constexpr int kLaneBlock = 64;
+
+  int count_;
+  int rows_;
+  int cols_;
+  int stride_;
+  std::pmr::vector<T> data_;
+
+  static int _LaneStride(int count) noexcept;
+
+  bool _SameShape(const S21BasicMatrixBatch& other) const noexcept;
+  void _SumAndSubBatch(char plus_or_minus, const S21BasicMatrixBatch& other);
+  void _CheckIndex(int index, int i, int j) const;
+};
+
+using S21MatrixBatch = S21BasicMatrixBatch<double>;
+using S21FloatMatrixBatch = S21BasicMatrixBatch<float>;
+
+extern template class S21BasicMatrixBatch<float>;
+extern template class S21BasicMatrixBatch<double>;
+extern template class S21BasicMatrixBatch<long double>;
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_BATCH_H
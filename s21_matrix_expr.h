@@ -0,0 +1,316 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_EXPR_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_EXPR_H
+
+// Expression templates for the element-wise S21Matrix operators. A + B - C * 2
+// builds a tree of small nodes instead of matrices and is computed in one
+// fused loop when it is assigned to an S21Matrix. Nodes refer to their
+// matrix operands, so an expression must be assigned within the statement
+// that builds it; do not keep it in an auto variable.
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix.h"
+#include "s21_strassen.h"
+#include "s21_thread_pool.h"
+
+// Every node provides GetRows(), GetCols(), Coeff(i, j) and two aliasing
+// queries for assignment: Aliases(p) tells whether the node reads the buffer
+// at p at all, Reorders(p) whether it reads it at positions other than the
+// one being written, which makes evaluation in place unsafe.
+
+// Every node also names its element type as Scalar; the operands of a node
+// must agree on it.
+
+// Matrix operand of an expression.
+template <class T>
+class S21MatrixLeaf : public S21Expression<S21MatrixLeaf<T>> {
+ public:
+  using Scalar = T;
+
+  explicit S21MatrixLeaf(const S21BasicMatrix<T>& matrix)
+      : data_(matrix.data()),
+        rows_(matrix.GetRows()),
+        cols_(matrix.GetCols()),
+        stride_(matrix.stride()) {
+    if (data_ == nullptr || rows_ < 1 || cols_ < 1)
+      throw std::out_of_range("Invalid matrix");
+  }
+
+  int GetRows() const noexcept { return rows_; }
+  int GetCols() const noexcept { return cols_; }
+  int stride() const noexcept { return stride_; }
+  const T* data() const noexcept { return data_; }
+  T Coeff(int i, int j) const noexcept {
+    return data_[static_cast<std::size_t>(i) * stride_ + j];
+  }
+  bool Aliases(const void* p) const noexcept { return p == data_; }
+  bool Reorders(const void*) const noexcept { return false; }
+
+ private:
+  const T* data_;
+  int rows_;
+  int cols_;
+  int stride_;
+};
+
+// How an operand is held inside a node: matrices as leaves, nodes by value.
+template <class E>
+struct S21ExprNode {
+  using Type = E;
+  static const E& Wrap(const E& expr) noexcept { return expr; }
+};
+
+template <class T>
+struct S21ExprNode<S21BasicMatrix<T>> {
+  using Type = S21MatrixLeaf<T>;
+  static S21MatrixLeaf<T> Wrap(const S21BasicMatrix<T>& matrix) {
+    return S21MatrixLeaf<T>(matrix);
+  }
+};
+
+template <class E>
+using S21ExprScalar = typename S21ExprNode<E>::Type::Scalar;
+
+struct S21Plus {
+  template <class T>
+  static T Apply(T a, T b) noexcept {
+    return a + b;
+  }
+};
+
+struct S21Minus {
+  template <class T>
+  static T Apply(T a, T b) noexcept {
+    return a - b;
+  }
+};
+
+template <class L, class R, class Op>
+class S21BinaryExpr : public S21Expression<S21BinaryExpr<L, R, Op>> {
+  static_assert(std::is_same<typename L::Scalar, typename R::Scalar>::value,
+                "Element types of the operands differ");
+
+ public:
+  using Scalar = typename L::Scalar;
+
+  S21BinaryExpr(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs) {
+    if (lhs.GetRows() != rhs.GetRows() || lhs.GetCols() != rhs.GetCols())
+      throw std::invalid_argument("Sizes are not equal");
+  }
+
+  int GetRows() const noexcept { return lhs_.GetRows(); }
+  int GetCols() const noexcept { return lhs_.GetCols(); }
+  Scalar Coeff(int i, int j) const noexcept {
+    return Op::Apply(lhs_.Coeff(i, j), rhs_.Coeff(i, j));
+  }
+  bool Aliases(const void* p) const noexcept {
+    return lhs_.Aliases(p) || rhs_.Aliases(p);
+  }
+  bool Reorders(const void* p) const noexcept {
+    return lhs_.Reorders(p) || rhs_.Reorders(p);
+  }
+
+ private:
+  L lhs_;
+  R rhs_;
+};
+
+template <class E>
+class S21ScaleExpr : public S21Expression<S21ScaleExpr<E>> {
+ public:
+  using Scalar = typename E::Scalar;
+
+  S21ScaleExpr(const E& expr, Scalar num) : expr_(expr), num_(num) {}
+
+  int GetRows() const noexcept { return expr_.GetRows(); }
+  int GetCols() const noexcept { return expr_.GetCols(); }
+  Scalar Coeff(int i, int j) const noexcept {
+    return expr_.Coeff(i, j) * num_;
+  }
+  bool Aliases(const void* p) const noexcept { return expr_.Aliases(p); }
+  bool Reorders(const void* p) const noexcept { return expr_.Reorders(p); }
+
+ private:
+  E expr_;
+  Scalar num_;
+};
+
+template <class E>
+class S21TransposeExpr : public S21Expression<S21TransposeExpr<E>> {
+ public:
+  using Scalar = typename E::Scalar;
+
+  explicit S21TransposeExpr(const E& expr) : expr_(expr) {}
+
+  const E& Inner() const noexcept { return expr_; }
+  int GetRows() const noexcept { return expr_.GetCols(); }
+  int GetCols() const noexcept { return expr_.GetRows(); }
+  Scalar Coeff(int i, int j) const noexcept { return expr_.Coeff(j, i); }
+  bool Aliases(const void* p) const noexcept { return expr_.Aliases(p); }
+  bool Reorders(const void* p) const noexcept { return expr_.Aliases(p); }
+
+ private:
+  E expr_;
+};
+
+template <class L, class R>
+S21BinaryExpr<typename S21ExprNode<L>::Type, typename S21ExprNode<R>::Type,
+              S21Plus>
+operator+(const S21Expression<L>& lhs, const S21Expression<R>& rhs) {
+  return {S21ExprNode<L>::Wrap(lhs.Self()), S21ExprNode<R>::Wrap(rhs.Self())};
+}
+
+template <class L, class R>
+S21BinaryExpr<typename S21ExprNode<L>::Type, typename S21ExprNode<R>::Type,
+              S21Minus>
+operator-(const S21Expression<L>& lhs, const S21Expression<R>& rhs) {
+  return {S21ExprNode<L>::Wrap(lhs.Self()), S21ExprNode<R>::Wrap(rhs.Self())};
+}
+
+// The scalar is taken in the element type of the expression, so 2. scales
+// a float matrix as well.
+template <class E>
+S21ScaleExpr<typename S21ExprNode<E>::Type> operator*(
+    const S21Expression<E>& expr, const S21ExprScalar<E> num) {
+  return {S21ExprNode<E>::Wrap(expr.Self()), num};
+}
+
+template <class E>
+S21ScaleExpr<typename S21ExprNode<E>::Type> operator*(
+    const S21ExprScalar<E> num, const S21Expression<E>& expr) {
+  return {S21ExprNode<E>::Wrap(expr.Self()), num};
+}
+
+// A GEMM operand as pointer and strides. Matrices and transposed matrices
+// are used where they are; any other expression is evaluated first.
+template <class T>
+class S21GemmOperand {
+ public:
+  explicit S21GemmOperand(const S21BasicMatrix<T>& matrix)
+      : S21GemmOperand(S21MatrixLeaf<T>(matrix)) {}
+  explicit S21GemmOperand(const S21MatrixLeaf<T>& leaf)
+      : data_(leaf.data()),
+        rows_(leaf.GetRows()),
+        cols_(leaf.GetCols()),
+        rs_(leaf.stride()),
+        cs_(1) {}
+  explicit S21GemmOperand(const S21TransposeExpr<S21MatrixLeaf<T>>& expr)
+      : data_(expr.Inner().data()),
+        rows_(expr.GetRows()),
+        cols_(expr.GetCols()),
+        rs_(1),
+        cs_(expr.Inner().stride()) {}
+  template <class E>
+  explicit S21GemmOperand(const S21Expression<E>& expr) : storage_(expr) {
+    data_ = storage_->data();
+    rows_ = storage_->GetRows();
+    cols_ = storage_->GetCols();
+    rs_ = storage_->stride();
+    cs_ = 1;
+  }
+
+  const T* data() const noexcept { return data_; }
+  int GetRows() const noexcept { return rows_; }
+  int GetCols() const noexcept { return cols_; }
+  int RowStride() const noexcept { return rs_; }
+  int ColStride() const noexcept { return cs_; }
+
+ private:
+  std::optional<S21BasicMatrix<T>> storage_;
+  const T* data_;
+  int rows_;
+  int cols_;
+  int rs_;
+  int cs_;
+};
+
+// Matrix products are evaluated eagerly with s21::GetMulAlgorithm(); their
+// result takes part in the surrounding expression as an ordinary matrix.
+template <class L, class R>
+S21BasicMatrix<S21ExprScalar<L>> operator*(const S21Expression<L>& lhs,
+                                           const S21Expression<R>& rhs) {
+  using T = S21ExprScalar<L>;
+  static_assert(std::is_same<T, S21ExprScalar<R>>::value,
+                "Element types of the operands differ");
+  S21GemmOperand<T> a(lhs.Self()), b(rhs.Self());
+  if (a.GetCols() != b.GetRows())
+    throw std::invalid_argument(
+        "Columns first matrix not equal rows second matrix");
+  S21BasicMatrix<T> result(a.GetRows(), b.GetCols());
+  s21::Multiply<T>(s21::GetMulAlgorithm(), a.GetRows(), b.GetCols(),
+                   a.GetCols(), a.data(), a.RowStride(), a.ColStride(),
+                   b.data(), b.RowStride(), b.ColStride(), result.data(),
+                   result.stride(), 1);
+  return result;
+}
+
+template <class T>
+template <class E>
+S21BasicMatrix<T>::S21BasicMatrix(const S21Expression<E>& expr)
+    : resource_(GetDefaultResource()),
+      matrix_(nullptr),
+      capacity_(0),
+      rows_(0),
+      cols_(0),
+      stride_(0),
+      refs_(nullptr) {
+  static_assert(std::is_same<T, S21ExprScalar<E>>::value,
+                "Element types differ; convert with the explicit constructor");
+  const auto& node = S21ExprNode<E>::Wrap(expr.Self());
+  rows_ = node.GetRows();
+  cols_ = node.GetCols();
+  CreateMatrix(rows_, cols_);
+  _Evaluate(node);
+}
+
+// The existing buffer is reused when the shape matches, no other matrix
+// shares it and the expression does not read this matrix out of place.
+template <class T>
+template <class E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(const S21Expression<E>& expr) {
+  static_assert(std::is_same<T, S21ExprScalar<E>>::value,
+                "Element types differ; convert with the explicit constructor");
+  const auto& node = S21ExprNode<E>::Wrap(expr.Self());
+  if (matrix_ != nullptr && !IsShared() && node.GetRows() == rows_ &&
+      node.GetCols() == cols_ && !node.Reorders(matrix_)) {
+    _Evaluate(node);
+  } else {
+    S21BasicMatrix result(expr);
+    *this = std::move(result);
+  }
+  return *this;
+}
+
+template <class T>
+template <class E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(
+    const S21Expression<E>& expr) {
+  return *this = *this + expr;
+}
+
+template <class T>
+template <class E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(
+    const S21Expression<E>& expr) {
+  return *this = *this - expr;
+}
+
+template <class T>
+template <class E>
+void S21BasicMatrix<T>::_Evaluate(const E& node) {
+  s21::ParallelFor(rows_, s21::ParallelGrain(cols_),
+                   [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                     for (int i = begin; i < end; i++) {
+                       T* out = _Row(i);
+                       for (int j = 0; j < cols_; j++) {
+                         out[j] = node.Coeff(i, j);
+                       }
+                     }
+                   });
+}
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_EXPR_H
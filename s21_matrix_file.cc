@@ -0,0 +1,493 @@
+#include "s21_matrix_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include "s21_profile.h"
+
+namespace {
+
+constexpr char kMagic[8] = {'S', '2', '1', 'M', 'A', 'T', 'R', 'X'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::size_t kAlignment = 64;
+
+struct FileHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t dtype;
+  std::uint32_t element_size;
+  std::uint32_t alignment;
+  std::uint64_t rows;
+  std::uint64_t cols;
+  std::uint64_t stride;
+  std::uint64_t data_offset;
+  std::uint64_t checksum;
+};
+
+static_assert(sizeof(FileHeader) == 64, "the header is 64 bytes");
+
+std::size_t ElementSize(S21MatrixDtype dtype) noexcept {
+  switch (dtype) {
+    case S21MatrixDtype::kFloat:
+      return sizeof(float);
+    case S21MatrixDtype::kDouble:
+      return sizeof(double);
+    case S21MatrixDtype::kLongDouble:
+      return sizeof(long double);
+  }
+  return 0;
+}
+
+// The row padding of S21BasicMatrix: whole cache lines once a row is at
+// least one line long.
+template <class T>
+int RowStride(int cols) noexcept {
+  const int line = static_cast<int>(kAlignment / sizeof(T));
+  return cols < line ? cols : (cols + line - 1) / line * line;
+}
+
+[[noreturn]] void ThrowSystemError(const char* what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+[[noreturn]] void ThrowInvalidFile() {
+  throw std::invalid_argument("Invalid matrix file");
+}
+
+// Closes the descriptor when the scope ends.
+class FileDescriptor {
+ public:
+  explicit FileDescriptor(int fd) noexcept : fd_(fd) {}
+  FileDescriptor(const FileDescriptor&) = delete;
+  FileDescriptor& operator=(const FileDescriptor&) = delete;
+  ~FileDescriptor() {
+    if (fd_ >= 0) close(fd_);
+  }
+  int Get() const noexcept { return fd_; }
+
+ private:
+  int fd_;
+};
+
+int OpenForReading(const std::string& path) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) ThrowSystemError("Cannot open matrix file");
+  return fd;
+}
+
+// Validates the header and checks that the file holds all of the data.
+S21MatrixFileInfo ReadInfo(int fd) {
+  FileHeader header;
+  struct stat status;
+  if (fstat(fd, &status) != 0) ThrowSystemError("Cannot read matrix file");
+  const std::size_t file_size = status.st_size;
+  if (file_size < sizeof(header)) ThrowInvalidFile();
+  s21::ReadFile(fd, &header, sizeof(header), 0);
+  const S21MatrixDtype dtype = static_cast<S21MatrixDtype>(header.dtype);
+  const std::uint64_t int_max = std::numeric_limits<int>::max();
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion || ElementSize(dtype) == 0 ||
+      header.element_size != ElementSize(dtype) || header.rows < 1 ||
+      header.cols < 1 || header.rows > int_max || header.stride > int_max ||
+      header.stride < header.cols || header.data_offset < sizeof(header) ||
+      header.alignment != kAlignment || header.data_offset % kAlignment != 0)
+    ThrowInvalidFile();
+  const std::uint64_t data_bytes =
+      header.rows * header.stride * header.element_size;
+  if (data_bytes / header.rows / header.element_size != header.stride ||
+      file_size < header.data_offset ||
+      file_size - header.data_offset < data_bytes)
+    ThrowInvalidFile();
+  S21MatrixFileInfo info;
+  info.version = header.version;
+  info.dtype = dtype;
+  info.rows = static_cast<int>(header.rows);
+  info.cols = static_cast<int>(header.cols);
+  info.stride = static_cast<int>(header.stride);
+  info.data_offset = header.data_offset;
+  info.checksum = header.checksum;
+  return info;
+}
+
+template <class T>
+S21MatrixFileInfo ReadInfoOf(int fd) {
+  S21MatrixFileInfo info = ReadInfo(fd);
+  if (info.dtype != s21::DtypeOf<T>())
+    throw std::invalid_argument("Matrix file has another element type");
+  return info;
+}
+
+template <class T>
+std::size_t DataBytes(const S21MatrixFileInfo& info) noexcept {
+  return static_cast<std::size_t>(info.rows) * info.stride * sizeof(T);
+}
+
+}  // namespace
+
+namespace s21 {
+
+void ReadFile(int fd, void* data, std::size_t bytes, std::size_t offset) {
+  char* target = static_cast<char*>(data);
+  while (bytes > 0) {
+    ssize_t done = pread(fd, target, bytes, offset);
+    if (done < 0 && errno == EINTR) continue;
+    if (done < 0) ThrowSystemError("Cannot read matrix file");
+    if (done == 0) ThrowInvalidFile();
+    target += done;
+    bytes -= done;
+    offset += done;
+  }
+}
+
+void WriteFile(int fd, const void* data, std::size_t bytes,
+               std::size_t offset) {
+  const char* source = static_cast<const char*>(data);
+  while (bytes > 0) {
+    ssize_t done = pwrite(fd, source, bytes, offset);
+    if (done < 0 && errno == EINTR) continue;
+    if (done < 0) ThrowSystemError("Cannot write matrix file");
+    source += done;
+    bytes -= done;
+    offset += done;
+  }
+}
+
+}  // namespace s21
+
+S21MatrixFileInfo S21ReadMatrixFileInfo(const std::string& path) {
+  FileDescriptor fd(OpenForReading(path));
+  return ReadInfo(fd.Get());
+}
+
+void S21Checksum::Update(const void* data, std::size_t bytes) noexcept {
+  const unsigned char* source = static_cast<const unsigned char*>(data);
+  if (tail_size_ > 0) {
+    const std::size_t take = std::min(bytes, kBlock - tail_size_);
+    std::memcpy(tail_ + tail_size_, source, take);
+    tail_size_ += take;
+    source += take;
+    bytes -= take;
+    if (tail_size_ < kBlock) return;
+    _Blocks(tail_, 1);
+    tail_size_ = 0;
+  }
+  _Blocks(source, bytes / kBlock);
+  source += bytes / kBlock * kBlock;
+  tail_size_ = bytes % kBlock;
+  std::memcpy(tail_, source, tail_size_);
+}
+
+// Word w of a block goes to lane w, so the four multiply chains run in
+// parallel.
+void S21Checksum::_Blocks(const unsigned char* source,
+                          std::size_t count) noexcept {
+  std::uint64_t lanes[kLanes];
+  std::copy(lanes_, lanes_ + kLanes, lanes);
+  for (std::size_t block = 0; block < count; block++, source += kBlock) {
+    for (int lane = 0; lane < kLanes; lane++) {
+      std::uint64_t word;
+      std::memcpy(&word, source + lane * 8, 8);
+      lanes[lane] = (lanes[lane] ^ word) * kPrime;
+    }
+  }
+  std::copy(lanes, lanes + kLanes, lanes_);
+}
+
+std::uint64_t S21Checksum::Digest() const noexcept {
+  std::uint64_t hash = kOffsetBasis;
+  for (int lane = 0; lane < kLanes; lane++) {
+    hash = (hash ^ lanes_[lane]) * kPrime;
+  }
+  for (std::size_t i = 0; i < tail_size_; i++) {
+    hash = (hash ^ tail_[i]) * kPrime;
+  }
+  return hash;
+}
+
+template <class T>
+S21BasicMappedMatrix<T>::S21BasicMappedMatrix(const std::string& path) {
+  FileDescriptor fd(OpenForReading(path));
+  info_ = ReadInfoOf<T>(fd.Get());
+  // The data offset is a multiple of the alignment, not of the page size,
+  // so the whole file up to the end of the data is mapped.
+  mapping_size_ = info_.data_offset + DataBytes<T>(info_);
+  mapping_ = mmap(nullptr, mapping_size_, PROT_READ, MAP_PRIVATE, fd.Get(), 0);
+  if (mapping_ == MAP_FAILED) {
+    mapping_ = nullptr;
+    ThrowSystemError("Cannot map matrix file");
+  }
+}
+
+template <class T>
+S21BasicMappedMatrix<T>::S21BasicMappedMatrix(
+    S21BasicMappedMatrix&& other) noexcept
+    : mapping_(other.mapping_),
+      mapping_size_(other.mapping_size_),
+      info_(other.info_) {
+  other.mapping_ = nullptr;
+  other.mapping_size_ = 0;
+  other.info_ = S21MatrixFileInfo{};
+}
+
+template <class T>
+S21BasicMappedMatrix<T>& S21BasicMappedMatrix<T>::operator=(
+    S21BasicMappedMatrix&& other) noexcept {
+  if (this != &other) {
+    _Unmap();
+    mapping_ = other.mapping_;
+    mapping_size_ = other.mapping_size_;
+    info_ = other.info_;
+    other.mapping_ = nullptr;
+    other.mapping_size_ = 0;
+    other.info_ = S21MatrixFileInfo{};
+  }
+  return *this;
+}
+
+template <class T>
+S21BasicMappedMatrix<T>::~S21BasicMappedMatrix() {
+  _Unmap();
+}
+
+template <class T>
+void S21BasicMappedMatrix<T>::_Unmap() noexcept {
+  if (mapping_ != nullptr) munmap(mapping_, mapping_size_);
+  mapping_ = nullptr;
+  mapping_size_ = 0;
+}
+
+template <class T>
+int S21BasicMappedMatrix<T>::GetRows() const noexcept {
+  return info_.rows;
+}
+
+template <class T>
+int S21BasicMappedMatrix<T>::GetCols() const noexcept {
+  return info_.cols;
+}
+
+template <class T>
+int S21BasicMappedMatrix<T>::stride() const noexcept {
+  return info_.stride;
+}
+
+template <class T>
+const T* S21BasicMappedMatrix<T>::data() const noexcept {
+  if (mapping_ == nullptr) return nullptr;
+  return reinterpret_cast<const T*>(static_cast<const char*>(mapping_) +
+                                    info_.data_offset);
+}
+
+template <class T>
+T S21BasicMappedMatrix<T>::operator()(int i, int j) const {
+  if (i >= info_.rows || j >= info_.cols || i < 0 || j < 0) {
+    throw std::out_of_range("Invalid index");
+  }
+  return data()[static_cast<std::size_t>(i) * info_.stride + j];
+}
+
+template <class T>
+S21BasicMatrixView<const T> S21BasicMappedMatrix<T>::View() const noexcept {
+  if (mapping_ == nullptr) return S21BasicMatrixView<const T>();
+  return S21BasicMatrixView<const T>(data(), info_.rows, info_.cols,
+                                     info_.stride);
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicMappedMatrix<T>::ToMatrix() const {
+  return S21BasicMatrix<T>(View());
+}
+
+template <class T>
+void S21BasicMappedMatrix<T>::Prefetch(int begin, int end) const noexcept {
+  begin = std::max(begin, 0);
+  end = std::min(end, info_.rows);
+  if (mapping_ == nullptr || begin >= end) return;
+  const std::size_t page = sysconf(_SC_PAGESIZE);
+  const std::size_t row_bytes =
+      static_cast<std::size_t>(info_.stride) * sizeof(T);
+  std::size_t first = info_.data_offset + begin * row_bytes;
+  const std::size_t last = info_.data_offset + end * row_bytes;
+  first -= first % page;
+  madvise(static_cast<char*>(mapping_) + first, last - first, MADV_WILLNEED);
+}
+
+template <class T>
+bool S21BasicMappedMatrix<T>::Verify() const noexcept {
+  if (mapping_ == nullptr) return false;
+  S21Checksum checksum;
+  checksum.Update(data(), DataBytes<T>(info_));
+  return checksum.Digest() == info_.checksum;
+}
+
+template <class T>
+S21BasicMatrixWriter<T>::S21BasicMatrixWriter(const std::string& path,
+                                              int rows, int cols)
+    : fd_(-1),
+      rows_(rows),
+      cols_(cols),
+      stride_(RowStride<T>(cols)),
+      written_(0),
+      data_offset_((sizeof(FileHeader) + kAlignment - 1) / kAlignment *
+                   kAlignment),
+      file_offset_(data_offset_) {
+  if (rows < 1 || cols < 1) throw std::out_of_range("Invalid matrix");
+  const std::size_t row_bytes = static_cast<std::size_t>(stride_) * sizeof(T);
+  chunk_.reserve(std::max(kChunkBytes, row_bytes));
+  fd_ = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd_ < 0) ThrowSystemError("Cannot open matrix file");
+  FileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.dtype = static_cast<std::uint32_t>(s21::DtypeOf<T>());
+  header.element_size = sizeof(T);
+  header.alignment = kAlignment;
+  header.rows = rows_;
+  header.cols = cols_;
+  header.stride = stride_;
+  header.data_offset = data_offset_;
+  try {
+    s21::WriteFile(fd_, &header, sizeof(header), 0);
+  } catch (...) {
+    close(fd_);
+    throw;
+  }
+}
+
+template <class T>
+S21BasicMatrixWriter<T>::~S21BasicMatrixWriter() {
+  if (fd_ < 0) return;
+  try {
+    if (written_ == rows_) {
+      Close();
+    } else {
+      _Flush();
+    }
+  } catch (...) {
+  }
+  if (fd_ >= 0) close(fd_);
+}
+
+template <class T>
+int S21BasicMatrixWriter<T>::RowsWritten() const noexcept {
+  return written_;
+}
+
+template <class T>
+void S21BasicMatrixWriter<T>::WriteRow(const T* row) {
+  WriteRows(S21BasicMatrixView<const T>(row, 1, cols_, cols_));
+}
+
+// Each row is copied into the chunk followed by zeroed padding; long double
+// rows are zeroed first so that the unused bytes of every element are too.
+template <class T>
+void S21BasicMatrixWriter<T>::WriteRows(S21BasicMatrixView<const T> rows) {
+  if (fd_ < 0 || rows.Empty()) throw std::out_of_range("Invalid matrix");
+  if (rows.GetCols() != cols_ || written_ + rows.GetRows() > rows_)
+    throw std::invalid_argument("Sizes are not equal");
+  const std::size_t row_bytes = static_cast<std::size_t>(stride_) * sizeof(T);
+  for (int i = 0; i < rows.GetRows(); i++) {
+    if (chunk_.size() + row_bytes > chunk_.capacity()) _Flush();
+    const std::size_t offset = chunk_.size();
+    chunk_.resize(offset + row_bytes);
+    T* target = reinterpret_cast<T*>(chunk_.data() + offset);
+    if constexpr (std::is_same_v<T, long double>) {
+      std::memset(target, 0, row_bytes);
+    } else {
+      std::fill(target + cols_, target + stride_, T(0));
+    }
+    const T* source = rows.Row(i);
+    if (rows.col_stride() == 1) {
+      std::copy(source, source + cols_, target);
+    } else {
+      for (int j = 0; j < cols_; j++) target[j] = rows(i, j);
+    }
+  }
+  written_ += rows.GetRows();
+}
+
+template <class T>
+void S21BasicMatrixWriter<T>::_Flush() {
+  if (chunk_.empty()) return;
+  checksum_.Update(chunk_.data(), chunk_.size());
+  s21::WriteFile(fd_, chunk_.data(), chunk_.size(), file_offset_);
+  file_offset_ += chunk_.size();
+  chunk_.clear();
+}
+
+template <class T>
+void S21BasicMatrixWriter<T>::Close() {
+  if (fd_ < 0) return;
+  if (written_ != rows_) throw std::out_of_range("Invalid matrix");
+  _Flush();
+  const std::uint64_t digest = checksum_.Digest();
+  s21::WriteFile(fd_, &digest, sizeof(digest),
+                 offsetof(FileHeader, checksum));
+  const int fd = fd_;
+  fd_ = -1;
+  if (close(fd) != 0) ThrowSystemError("Cannot write matrix file");
+}
+
+template <class T>
+void S21BasicMatrix<T>::Save(const std::string& path) const {
+  S21_PROFILE_SCOPE(kSave, 0);
+  S21BasicMatrixWriter<T> writer(path, rows_, cols_);
+  writer.WriteRows(View());
+  writer.Close();
+  S21_PROFILE_COPIED(sizeof(T) * rows_ * cols_);
+}
+
+// Rows are read straight into the matrix when the strides agree, which
+// they do for every file written by S21BasicMatrixWriter.
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Load(const std::string& path) {
+  S21_PROFILE_SCOPE(kLoad, 0);
+  FileDescriptor fd(OpenForReading(path));
+  const S21MatrixFileInfo info = ReadInfoOf<T>(fd.Get());
+  S21BasicMatrix<T> result(info.rows, info.cols);
+  S21Checksum checksum;
+  const std::size_t row_bytes =
+      static_cast<std::size_t>(info.stride) * sizeof(T);
+  if (info.stride == result.stride_) {
+    s21::ReadFile(fd.Get(), result.matrix_, DataBytes<T>(info),
+                  info.data_offset);
+    checksum.Update(result.matrix_, DataBytes<T>(info));
+  } else {
+    std::vector<T> row(info.stride);
+    for (int i = 0; i < info.rows; i++) {
+      s21::ReadFile(fd.Get(), row.data(), row_bytes,
+                    info.data_offset + i * row_bytes);
+      checksum.Update(row.data(), row_bytes);
+      std::copy(row.begin(), row.begin() + info.cols, result._Row(i));
+    }
+  }
+  if (checksum.Digest() != info.checksum)
+    throw std::invalid_argument("Matrix file checksum mismatch");
+  S21_PROFILE_COPIED(DataBytes<T>(info));
+  return result;
+}
+
+template class S21BasicMappedMatrix<float>;
+template class S21BasicMappedMatrix<double>;
+template class S21BasicMappedMatrix<long double>;
+template class S21BasicMatrixWriter<float>;
+template class S21BasicMatrixWriter<double>;
+template class S21BasicMatrixWriter<long double>;
+template void S21BasicMatrix<float>::Save(const std::string&) const;
+template void S21BasicMatrix<double>::Save(const std::string&) const;
+template void S21BasicMatrix<long double>::Save(const std::string&) const;
+template S21BasicMatrix<float> S21BasicMatrix<float>::Load(const std::string&);
+template S21BasicMatrix<double> S21BasicMatrix<double>::Load(
+    const std::string&);
+template S21BasicMatrix<long double> S21BasicMatrix<long double>::Load(
+    const std::string&);
@@ -0,0 +1,182 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_FILE_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "s21_matrix.h"
+
+// Binary matrix file, version 1. A 64-byte header
+//
+//   offset  0  char[8]   magic "S21MATRX"
+//           8  uint32    version
+//          12  uint32    dtype (S21MatrixDtype)
+//          16  uint32    element size in bytes
+//          20  uint32    alignment of the data and of every row, in bytes
+//          24  uint64    rows
+//          32  uint64    cols
+//          40  uint64    stride, elements from one row to the next
+//          48  uint64    data offset from the start of the file
+//          56  uint64    checksum of the data
+//
+// is followed at the data offset by rows * stride elements, the padding of
+// each row zeroed. Rows are padded like those of S21BasicMatrix, so a mapped
+// file has the same layout as a matrix in memory. Everything is stored in
+// the host byte order (little-endian on every supported target). The magic
+// is a byte string and reads the same on any host, but a file from a host
+// of the other order has its version byte-swapped and is rejected for it.
+// The alignment is always 64 and the data offset a multiple of it; readers
+// reject any other file, whose mapped data could be misaligned.
+enum class S21MatrixDtype : std::uint32_t {
+  kFloat = 1,
+  kDouble = 2,
+  kLongDouble = 3,
+};
+
+struct S21MatrixFileInfo {
+  std::uint32_t version;
+  S21MatrixDtype dtype;
+  int rows;
+  int cols;
+  int stride;
+  std::size_t data_offset;
+  std::uint64_t checksum;
+};
+
+namespace s21 {
+
+template <class T>
+constexpr S21MatrixDtype DtypeOf() noexcept {
+  if constexpr (std::is_same_v<T, float>) {
+    return S21MatrixDtype::kFloat;
+  } else if constexpr (std::is_same_v<T, double>) {
+    return S21MatrixDtype::kDouble;
+  } else {
+    return S21MatrixDtype::kLongDouble;
+  }
+}
+
+// pread/pwrite of exactly bytes bytes at offset, retried on EINTR and on
+// short transfers. Failures throw std::system_error; reading past the end
+// of the file throws std::invalid_argument("Invalid matrix file").
+void ReadFile(int fd, void* data, std::size_t bytes, std::size_t offset);
+void WriteFile(int fd, const void* data, std::size_t bytes,
+               std::size_t offset);
+
+}  // namespace s21
+
+// Reads and validates the header of a matrix file. Format errors throw
+// std::invalid_argument("Invalid matrix file"), failed system calls
+// std::system_error.
+S21MatrixFileInfo S21ReadMatrixFileInfo(const std::string& path);
+
+// 64-bit FNV-1a run as four interleaved lanes over 8-byte words, the lanes
+// and the bytes of the tail folded together at the end. It can be fed in
+// pieces of any size.
+class S21Checksum {
+ public:
+  void Update(const void* data, std::size_t bytes) noexcept;
+  std::uint64_t Digest() const noexcept;
+
+ private:
+  static constexpr int kLanes = 4;
+  static constexpr std::size_t kBlock = kLanes * 8;
+  static constexpr std::uint64_t kOffsetBasis = 14695981039346656037ull;
+  static constexpr std::uint64_t kPrime = 1099511628211ull;
+
+  std::uint64_t lanes_[kLanes] = {kOffsetBasis, kOffsetBasis, kOffsetBasis,
+                                  kOffsetBasis};
+  unsigned char tail_[kBlock] = {};
+  std::size_t tail_size_ = 0;
+
+  void _Blocks(const unsigned char* source, std::size_t count) noexcept;
+};
+
+// Read-only matrix backed by a private read-only mapping of a matrix file.
+// Opening reads only the header, so it takes the same time for any size;
+// the data is paged in from the file as it is touched and can be dropped by
+// the kernel under memory pressure. The file must not change while it is
+// mapped.
+template <class T>
+class S21BasicMappedMatrix {
+ public:
+  explicit S21BasicMappedMatrix(const std::string& path);
+  S21BasicMappedMatrix(S21BasicMappedMatrix&& other) noexcept;
+  S21BasicMappedMatrix& operator=(S21BasicMappedMatrix&& other) noexcept;
+  S21BasicMappedMatrix(const S21BasicMappedMatrix&) = delete;
+  S21BasicMappedMatrix& operator=(const S21BasicMappedMatrix&) = delete;
+  ~S21BasicMappedMatrix();
+
+  int GetRows() const noexcept;
+  int GetCols() const noexcept;
+  int stride() const noexcept;
+  const T* data() const noexcept;
+  T operator()(int i, int j) const;
+  S21BasicMatrixView<const T> View() const noexcept;
+  S21BasicMatrix<T> ToMatrix() const;
+
+  // Asks the kernel to start reading rows [begin, end) in the background.
+  void Prefetch(int begin, int end) const noexcept;
+  // Reads the whole data and compares its checksum with the header's.
+  bool Verify() const noexcept;
+
+ private:
+  void* mapping_ = nullptr;
+  std::size_t mapping_size_ = 0;
+  S21MatrixFileInfo info_{};
+
+  void _Unmap() noexcept;
+};
+
+// Writes a matrix file row by row without holding the matrix: rows are
+// gathered into a chunk buffer and written when it fills up, and the
+// header's checksum is filled in by Close(). Fewer rows than announced
+// leave a short file, which every reader rejects.
+template <class T>
+class S21BasicMatrixWriter {
+ public:
+  static constexpr std::size_t kChunkBytes = 1 << 20;
+
+  S21BasicMatrixWriter(const std::string& path, int rows, int cols);
+  S21BasicMatrixWriter(const S21BasicMatrixWriter&) = delete;
+  S21BasicMatrixWriter& operator=(const S21BasicMatrixWriter&) = delete;
+  // Closes the file, without the checksum when rows are missing.
+  ~S21BasicMatrixWriter();
+
+  int RowsWritten() const noexcept;
+  // Appends GetCols() elements.
+  void WriteRow(const T* row);
+  // Appends every row of the view, whose width must match.
+  void WriteRows(S21BasicMatrixView<const T> rows);
+  // Flushes the chunk and writes the header checksum. Throws
+  // std::out_of_range("Invalid matrix") when rows are missing.
+  void Close();
+
+ private:
+  int fd_;
+  int rows_;
+  int cols_;
+  int stride_;
+  int written_;
+  std::size_t data_offset_;
+  std::size_t file_offset_;
+  std::vector<unsigned char> chunk_;
+  S21Checksum checksum_;
+
+  void _Flush();
+};
+
+using S21MappedMatrix = S21BasicMappedMatrix<double>;
+using S21MatrixWriter = S21BasicMatrixWriter<double>;
+
+extern template class S21BasicMappedMatrix<float>;
+extern template class S21BasicMappedMatrix<double>;
+extern template class S21BasicMappedMatrix<long double>;
+extern template class S21BasicMatrixWriter<float>;
+extern template class S21BasicMatrixWriter<double>;
+extern template class S21BasicMatrixWriter<long double>;
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_FILE_H
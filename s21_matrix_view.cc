@@ -0,0 +1,305 @@
+#include "s21_matrix_view.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+#include "s21_gemm.h"
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+#include "s21_transpose.h"
+
+namespace {
+
+template <class T>
+void CheckView(S21BasicMatrixView<T> view) {
+  if (view.Empty()) throw std::out_of_range("Invalid matrix");
+}
+
+template <class T, class U>
+bool SameShape(S21BasicMatrixView<T> a, S21BasicMatrixView<U> b) noexcept {
+  return a.GetRows() == b.GetRows() && a.GetCols() == b.GetCols();
+}
+
+// Address of the last element of a view with non-negative strides.
+template <class T>
+const void* LastOf(S21BasicMatrixView<T> view) noexcept {
+  return view.Row(view.GetRows() - 1) +
+         static_cast<std::ptrdiff_t>(view.GetCols() - 1) * view.col_stride();
+}
+
+template <class T>
+bool RowsContiguous(S21BasicMatrixView<T> view) noexcept {
+  return view.col_stride() == 1;
+}
+
+// Whether a and b share an element. Row-major blocks of one layout are
+// placed on its grid of rows and columns, so that blocks side by side in
+// the same rows, like C21 and C22, do not count; any other pair whose
+// address ranges meet is taken to overlap.
+template <class T, class U>
+bool Overlaps(S21BasicMatrixView<T> a, S21BasicMatrixView<U> b) noexcept {
+  std::less<const void*> less;
+  if (less(LastOf(a), b.data()) || less(LastOf(b), a.data())) return false;
+  const std::ptrdiff_t stride = a.stride();
+  if (sizeof(T) != sizeof(U) || b.stride() != stride ||
+      !RowsContiguous(a) || !RowsContiguous(b) || stride < a.GetCols() ||
+      stride < b.GetCols())
+    return true;
+  const std::ptrdiff_t bytes =
+      static_cast<std::ptrdiff_t>(reinterpret_cast<std::uintptr_t>(b.data()) -
+                                  reinterpret_cast<std::uintptr_t>(a.data()));
+  if (bytes % static_cast<std::ptrdiff_t>(sizeof(T)) != 0) return true;
+  const std::ptrdiff_t offset = bytes / static_cast<std::ptrdiff_t>(sizeof(T));
+  // b starts in row first_row, column first_col of the grid of a.
+  std::ptrdiff_t first_row = offset / stride, first_col = offset % stride;
+  if (first_col < 0) {
+    first_row--;
+    first_col += stride;
+  }
+  if (first_col + b.GetCols() > stride) return true;
+  return first_row < a.GetRows() && first_row + b.GetRows() > 0 &&
+         first_col < a.GetCols();
+}
+
+template <class T, class U>
+bool SameElements(S21BasicMatrixView<T> a, S21BasicMatrixView<U> b) noexcept {
+  return static_cast<const void*>(a.data()) ==
+             static_cast<const void*>(b.data()) &&
+         a.stride() == b.stride() && a.col_stride() == b.col_stride();
+}
+
+// Applies row(i) to every row of an n-column layout on the thread pool.
+template <class Body>
+void ForEachRow(int rows, int cols, const Body& row) {
+  s21::ParallelFor(rows, s21::ParallelGrain(cols),
+                   [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                     for (int i = begin; i < end; i++) row(i);
+                   });
+}
+
+// out = op(a, b) where kernel works on contiguous rows and op on elements.
+// When all three views are transposed row-major blocks, their transposes
+// are processed instead so the SIMD kernels still apply.
+template <class T, class Kernel, class Op>
+void ElementWise(S21BasicMatrixView<const T> a, S21BasicMatrixView<const T> b,
+                 S21BasicMatrixView<T> out, Kernel kernel, Op op) {
+  CheckView(a);
+  CheckView(b);
+  CheckView(out);
+  if (!SameShape(a, b) || !SameShape(a, out))
+    throw std::invalid_argument("Sizes are not equal");
+  // An input that overlaps out other than element for element, such as the
+  // transpose of out, would see elements already written; it is read from
+  // a copy instead.
+  for (S21BasicMatrixView<const T> input : {a, b}) {
+    if (!Overlaps(input, out) || SameElements(input, out)) continue;
+    S21BasicMatrix<T> copy(input);
+    if (SameElements(a, input)) a = copy.View();
+    if (SameElements(b, input)) b = copy.View();
+    ElementWise<T>(a, b, out, kernel, op);
+    return;
+  }
+  if (!RowsContiguous(out) && out.stride() == 1 && a.stride() == 1 &&
+      b.stride() == 1) {
+    a = a.Transposed();
+    b = b.Transposed();
+    out = out.Transposed();
+  }
+  const int cols = out.GetCols();
+  if (RowsContiguous(a) && RowsContiguous(b) && RowsContiguous(out)) {
+    ForEachRow(out.GetRows(), cols,
+               [&](int i) { kernel(a.Row(i), b.Row(i), out.Row(i), cols); });
+  } else {
+    ForEachRow(out.GetRows(), cols, [&](int i) {
+      for (int j = 0; j < cols; j++) out(i, j) = op(a(i, j), b(i, j));
+    });
+  }
+}
+
+}  // namespace
+
+namespace s21 {
+
+template <class T>
+void Copy(S21BasicMatrixView<const T> a, S21BasicMatrixView<T> out) {
+  CheckView(a);
+  CheckView(out);
+  if (!SameShape(a, out)) throw std::invalid_argument("Sizes are not equal");
+  const bool same = a.data() == out.data() && a.stride() == out.stride() &&
+                    a.col_stride() == out.col_stride();
+  if (same) return;
+  if (Overlaps(a, out)) {
+    S21BasicMatrix<T> copy(a.GetRows(), a.GetCols());
+    Copy<T>(a, copy);
+    Copy<T>(copy, out);
+    return;
+  }
+  const int cols = out.GetCols();
+  if (RowsContiguous(out) && !RowsContiguous(a) && a.stride() == 1) {
+    s21::Transpose(a.GetCols(), a.GetRows(), a.data(), a.col_stride(),
+                   out.data(), out.stride());
+  } else if (RowsContiguous(a) && RowsContiguous(out)) {
+    ForEachRow(out.GetRows(), cols, [&](int i) {
+      std::copy(a.Row(i), a.Row(i) + cols, out.Row(i));
+    });
+  } else {
+    ForEachRow(out.GetRows(), cols, [&](int i) {
+      for (int j = 0; j < cols; j++) out(i, j) = a(i, j);
+    });
+  }
+}
+
+template <class T>
+void Fill(S21BasicMatrixView<T> out, T val) {
+  CheckView(out);
+  if (!RowsContiguous(out) && out.stride() == 1) out = out.Transposed();
+  const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+  const int cols = out.GetCols();
+  ForEachRow(out.GetRows(), cols, [&](int i) {
+    if (RowsContiguous(out)) {
+      simd.fill(out.Row(i), cols, val);
+    } else {
+      for (int j = 0; j < cols; j++) out(i, j) = val;
+    }
+  });
+}
+
+template <class T>
+void Add(S21BasicMatrixView<const T> a, S21BasicMatrixView<const T> b,
+         S21BasicMatrixView<T> out) {
+  ElementWise(a, b, out, s21::Simd<T>().add, std::plus<T>());
+}
+
+template <class T>
+void Sub(S21BasicMatrixView<const T> a, S21BasicMatrixView<const T> b,
+         S21BasicMatrixView<T> out) {
+  ElementWise(a, b, out, s21::Simd<T>().sub, std::minus<T>());
+}
+
+template <class T>
+void Scale(S21BasicMatrixView<const T> a, T num, S21BasicMatrixView<T> out) {
+  const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+  ElementWise(
+      a, a, out,
+      [&](const T* row, const T*, T* target, int cols) {
+        simd.scale(row, num, target, cols);
+      },
+      [&](T value, T) { return value * num; });
+}
+
+template <class T>
+bool Equal(S21BasicMatrixView<const T> a, S21BasicMatrixView<const T> b,
+           T tolerance) noexcept {
+  if (a.Empty() || b.Empty() || !SameShape(a, b)) return false;
+  if (!RowsContiguous(a) && a.stride() == 1 && b.stride() == 1) {
+    a = a.Transposed();
+    b = b.Transposed();
+  }
+  const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+  const int cols = a.GetCols();
+  const bool contiguous = RowsContiguous(a) && RowsContiguous(b);
+  std::atomic<bool> equal(true);
+  auto compare = [&](std::ptrdiff_t begin, std::ptrdiff_t end) noexcept {
+    for (int i = begin; i < end && equal; i++) {
+      if (contiguous) {
+        if (!simd.equal(a.Row(i), b.Row(i), cols, tolerance)) equal = false;
+        continue;
+      }
+      const T* x = a.Row(i);
+      const T* y = b.Row(i);
+      for (int j = 0; j < cols; j++) {
+        T difference = x[0] - y[0];
+        x += a.col_stride();
+        y += b.col_stride();
+        if (difference > tolerance || -difference > tolerance) equal = false;
+      }
+    }
+  };
+  // compare throws nothing, so an exception can only come from setting up
+  // the parallel loop, before any row is compared; the comparison then runs
+  // here without allocating.
+  try {
+    s21::ParallelFor(a.GetRows(), s21::ParallelGrain(cols), compare);
+  } catch (...) {
+    compare(0, a.GetRows());
+  }
+  return equal;
+}
+
+template <class T>
+void Gemm(T alpha, S21BasicMatrixView<const T> a,
+          S21BasicMatrixView<const T> b, T beta, S21BasicMatrixView<T> c) {
+  CheckView(a);
+  CheckView(b);
+  CheckView(c);
+  if (a.GetCols() != b.GetRows())
+    throw std::invalid_argument(
+        "Columns first matrix not equal rows second matrix");
+  if (c.GetRows() != a.GetRows() || c.GetCols() != b.GetCols())
+    throw std::invalid_argument("Sizes are not equal");
+  if (Overlaps(a, c) || Overlaps(b, c)) {
+    S21BasicMatrix<T> result(c.GetRows(), c.GetCols());
+    if (beta != 0) Copy<T>(c, result);
+    Gemm<T>(alpha, a, b, beta, result);
+    Copy<T>(result, c);
+    return;
+  }
+  s21::Gemm<T>(c.GetRows(), c.GetCols(), a.GetCols(), alpha, a.data(),
+               a.stride(), a.col_stride(), b.data(), b.stride(),
+               b.col_stride(), beta, c.data(), c.stride(), c.col_stride());
+}
+
+template void Copy<float>(S21BasicMatrixView<const float>,
+                          S21BasicMatrixView<float>);
+template void Copy<double>(S21BasicMatrixView<const double>,
+                           S21BasicMatrixView<double>);
+template void Copy<long double>(S21BasicMatrixView<const long double>,
+                                S21BasicMatrixView<long double>);
+template void Fill<float>(S21BasicMatrixView<float>, float);
+template void Fill<double>(S21BasicMatrixView<double>, double);
+template void Fill<long double>(S21BasicMatrixView<long double>, long double);
+template void Add<float>(S21BasicMatrixView<const float>,
+                         S21BasicMatrixView<const float>,
+                         S21BasicMatrixView<float>);
+template void Add<double>(S21BasicMatrixView<const double>,
+                          S21BasicMatrixView<const double>,
+                          S21BasicMatrixView<double>);
+template void Add<long double>(S21BasicMatrixView<const long double>,
+                               S21BasicMatrixView<const long double>,
+                               S21BasicMatrixView<long double>);
+template void Sub<float>(S21BasicMatrixView<const float>,
+                         S21BasicMatrixView<const float>,
+                         S21BasicMatrixView<float>);
+template void Sub<double>(S21BasicMatrixView<const double>,
+                          S21BasicMatrixView<const double>,
+                          S21BasicMatrixView<double>);
+template void Sub<long double>(S21BasicMatrixView<const long double>,
+                               S21BasicMatrixView<const long double>,
+                               S21BasicMatrixView<long double>);
+template void Scale<float>(S21BasicMatrixView<const float>, float,
+                           S21BasicMatrixView<float>);
+template void Scale<double>(S21BasicMatrixView<const double>, double,
+                            S21BasicMatrixView<double>);
+template void Scale<long double>(S21BasicMatrixView<const long double>,
+                                 long double, S21BasicMatrixView<long double>);
+template bool Equal<float>(S21BasicMatrixView<const float>,
+                           S21BasicMatrixView<const float>, float) noexcept;
+template bool Equal<double>(S21BasicMatrixView<const double>,
+                            S21BasicMatrixView<const double>, double) noexcept;
+template bool Equal<long double>(S21BasicMatrixView<const long double>,
+                                 S21BasicMatrixView<const long double>,
+                                 long double) noexcept;
+template void Gemm<float>(float, S21BasicMatrixView<const float>,
+                          S21BasicMatrixView<const float>, float,
+                          S21BasicMatrixView<float>);
+template void Gemm<double>(double, S21BasicMatrixView<const double>,
+                           S21BasicMatrixView<const double>, double,
+                           S21BasicMatrixView<double>);
+template void Gemm<long double>(long double,
+                                S21BasicMatrixView<const long double>,
+                                S21BasicMatrixView<const long double>,
+                                long double, S21BasicMatrixView<long double>);
+
+}  // namespace s21
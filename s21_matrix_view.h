@@ -0,0 +1,214 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_VIEW_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_VIEW_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_matrix.h"
+
+// Non-owning window onto rows x cols elements: element (i, j) is at
+// data()[i * stride() + j * col_stride()]. A view is a few words, is passed
+// by value and never allocates. It may look at a matrix, at a part of one
+// (RowRange, ColRange, Block), at its transpose (Transposed swaps the
+// strides) or at a buffer owned by the caller. S21BasicMatrixView<const T>
+// is the read-only view; a view of T converts to it.
+//
+// A view of an S21BasicMatrix is invalidated by anything that reallocates
+// or re-strides the matrix: SetRows, SetCols, TransposeInPlace, assignment
+// and destruction.
+template <class T>
+class S21BasicMatrixView {
+ public:
+  using Scalar = std::remove_const_t<T>;
+  using ConstView = S21BasicMatrixView<const Scalar>;
+  using Matrix = std::conditional_t<std::is_const_v<T>,
+                                    const S21BasicMatrix<Scalar>,
+                                    S21BasicMatrix<Scalar>>;
+
+  S21BasicMatrixView() noexcept = default;
+  // rows x cols elements of a caller-owned buffer, which must outlive the
+  // view.
+  S21BasicMatrixView(T* data, int rows, int cols, int stride,
+                     int col_stride = 1)
+      : data_(data),
+        rows_(rows),
+        cols_(cols),
+        stride_(stride),
+        col_stride_(col_stride) {
+    if (data == nullptr || rows < 1 || cols < 1)
+      throw std::out_of_range("Invalid matrix");
+  }
+  // The whole matrix. A moved-from matrix gives an empty view, which every
+  // kernel rejects. A mutable view unshares a copy-on-write buffer first.
+  S21BasicMatrixView(Matrix& matrix)
+      : data_(matrix.data()),
+        rows_(matrix.GetRows()),
+        cols_(matrix.GetCols()),
+        stride_(matrix.stride()),
+        col_stride_(1) {}
+  template <class U, class = std::enable_if_t<std::is_same_v<const U, T> &&
+                                              !std::is_same_v<U, T>>>
+  S21BasicMatrixView(const S21BasicMatrixView<U>& other) noexcept
+      : data_(other.data_),
+        rows_(other.rows_),
+        cols_(other.cols_),
+        stride_(other.stride_),
+        col_stride_(other.col_stride_) {}
+
+  T* data() const noexcept { return data_; }
+  int GetRows() const noexcept { return rows_; }
+  int GetCols() const noexcept { return cols_; }
+  int stride() const noexcept { return stride_; }
+  int col_stride() const noexcept { return col_stride_; }
+  bool Empty() const noexcept {
+    return data_ == nullptr || rows_ < 1 || cols_ < 1;
+  }
+
+  // Start of row i; its elements are col_stride() apart.
+  T* Row(int i) const noexcept {
+    return data_ + static_cast<std::ptrdiff_t>(i) * stride_;
+  }
+  T& operator()(int i, int j) const {
+    if (i >= rows_ || j >= cols_ || i < 0 || j < 0) {
+      throw std::out_of_range("Invalid index");
+    }
+    return Row(i)[static_cast<std::ptrdiff_t>(j) * col_stride_];
+  }
+
+  // rows x cols elements starting at (i, j).
+  S21BasicMatrixView Block(int i, int j, int rows, int cols) const {
+    if (i < 0 || j < 0 || rows < 1 || cols < 1 || i + rows > rows_ ||
+        j + cols > cols_) {
+      throw std::out_of_range("Invalid index");
+    }
+    S21BasicMatrixView block(*this);
+    block.data_ = Row(i) + static_cast<std::ptrdiff_t>(j) * col_stride_;
+    block.rows_ = rows;
+    block.cols_ = cols;
+    return block;
+  }
+  // Rows [begin, end) and columns [begin, end).
+  S21BasicMatrixView RowRange(int begin, int end) const {
+    return Block(begin, 0, end - begin, cols_);
+  }
+  S21BasicMatrixView ColRange(int begin, int end) const {
+    return Block(0, begin, rows_, end - begin);
+  }
+  S21BasicMatrixView Transposed() const noexcept {
+    S21BasicMatrixView transposed(*this);
+    transposed.rows_ = cols_;
+    transposed.cols_ = rows_;
+    transposed.stride_ = col_stride_;
+    transposed.col_stride_ = stride_;
+    return transposed;
+  }
+
+ private:
+  template <class U>
+  friend class S21BasicMatrixView;
+
+  T* data_ = nullptr;
+  int rows_ = 0;
+  int cols_ = 0;
+  int stride_ = 0;
+  int col_stride_ = 1;
+};
+
+using S21MatrixView = S21BasicMatrixView<double>;
+using S21ConstMatrixView = S21BasicMatrixView<const double>;
+
+namespace s21 {
+
+// Kernels over views. Rows of unit column stride go through the SIMD
+// kernels and are split across the thread pool like the S21BasicMatrix
+// operations; other layouts fall back to strided loops. Empty views throw
+// std::out_of_range("Invalid matrix"), mismatched shapes
+// std::invalid_argument. out may be one of the inputs itself but must not
+// otherwise overlap them.
+
+// out = a; a transposed view of a row-major block is copied with
+// s21::Transpose. a and out may overlap.
+template <class T>
+void Copy(S21BasicMatrixView<const T> a, S21BasicMatrixView<T> out);
+// out(i, j) = val.
+template <class T>
+void Fill(S21BasicMatrixView<T> out, T val);
+// out = a + b, out = a - b, out = a * num.
+template <class T>
+void Add(S21BasicMatrixView<const T> a, S21BasicMatrixView<const T> b,
+         S21BasicMatrixView<T> out);
+template <class T>
+void Sub(S21BasicMatrixView<const T> a, S21BasicMatrixView<const T> b,
+         S21BasicMatrixView<T> out);
+template <class T>
+void Scale(S21BasicMatrixView<const T> a, T num, S21BasicMatrixView<T> out);
+// False for views of different shapes or empty views; never throws.
+template <class T>
+bool Equal(S21BasicMatrixView<const T> a, S21BasicMatrixView<const T> b,
+           T tolerance) noexcept;
+// c = alpha * a * b + beta * c with the blocked GEMM, which takes the
+// strides of each view as they are, so transposed operands cost nothing.
+// c may overlap a or b; the product then goes through a temporary.
+template <class T>
+void Gemm(T alpha, S21BasicMatrixView<const T> a,
+          S21BasicMatrixView<const T> b, T beta, S21BasicMatrixView<T> c);
+
+extern template void Copy<float>(S21BasicMatrixView<const float>,
+                                 S21BasicMatrixView<float>);
+extern template void Copy<double>(S21BasicMatrixView<const double>,
+                                  S21BasicMatrixView<double>);
+extern template void Copy<long double>(
+    S21BasicMatrixView<const long double>, S21BasicMatrixView<long double>);
+extern template void Fill<float>(S21BasicMatrixView<float>, float);
+extern template void Fill<double>(S21BasicMatrixView<double>, double);
+extern template void Fill<long double>(S21BasicMatrixView<long double>,
+                                       long double);
+extern template void Add<float>(S21BasicMatrixView<const float>,
+                                S21BasicMatrixView<const float>,
+                                S21BasicMatrixView<float>);
+extern template void Add<double>(S21BasicMatrixView<const double>,
+                                 S21BasicMatrixView<const double>,
+                                 S21BasicMatrixView<double>);
+extern template void Add<long double>(S21BasicMatrixView<const long double>,
+                                      S21BasicMatrixView<const long double>,
+                                      S21BasicMatrixView<long double>);
+extern template void Sub<float>(S21BasicMatrixView<const float>,
+                                S21BasicMatrixView<const float>,
+                                S21BasicMatrixView<float>);
+extern template void Sub<double>(S21BasicMatrixView<const double>,
+                                 S21BasicMatrixView<const double>,
+                                 S21BasicMatrixView<double>);
+extern template void Sub<long double>(S21BasicMatrixView<const long double>,
+                                      S21BasicMatrixView<const long double>,
+                                      S21BasicMatrixView<long double>);
+extern template void Scale<float>(S21BasicMatrixView<const float>, float,
+                                  S21BasicMatrixView<float>);
+extern template void Scale<double>(S21BasicMatrixView<const double>, double,
+                                   S21BasicMatrixView<double>);
+extern template void Scale<long double>(
+    S21BasicMatrixView<const long double>, long double,
+    S21BasicMatrixView<long double>);
+extern template bool Equal<float>(S21BasicMatrixView<const float>,
+                                  S21BasicMatrixView<const float>,
+                                  float) noexcept;
+extern template bool Equal<double>(S21BasicMatrixView<const double>,
+                                   S21BasicMatrixView<const double>,
+                                   double) noexcept;
+extern template bool Equal<long double>(
+    S21BasicMatrixView<const long double>,
+    S21BasicMatrixView<const long double>, long double) noexcept;
+extern template void Gemm<float>(float, S21BasicMatrixView<const float>,
+                                 S21BasicMatrixView<const float>, float,
+                                 S21BasicMatrixView<float>);
+extern template void Gemm<double>(double, S21BasicMatrixView<const double>,
+                                  S21BasicMatrixView<const double>, double,
+                                  S21BasicMatrixView<double>);
+extern template void Gemm<long double>(
+    long double, S21BasicMatrixView<const long double>,
+    S21BasicMatrixView<const long double>, long double,
+    S21BasicMatrixView<long double>);
+
+}  // namespace s21
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_VIEW_H
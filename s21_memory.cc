@@ -0,0 +1,199 @@
+#include "s21_memory.h"
+
+#include <algorithm>
+#include <new>
+
+#include "s21_matrix.h"
+
+namespace {
+
+void Account(S21AllocationStats& stats, std::size_t bytes,
+             bool upstream) noexcept {
+  stats.allocations++;
+  if (upstream) stats.upstream_allocations++;
+  stats.bytes_in_use += bytes;
+  stats.peak_bytes = std::max(stats.peak_bytes, stats.bytes_in_use);
+}
+
+}  // namespace
+
+S21AlignedResource* S21AlignedResource::Instance() noexcept {
+  static S21AlignedResource resource;
+  return &resource;
+}
+
+void* S21AlignedResource::do_allocate(std::size_t bytes,
+                                      std::size_t alignment) {
+  return ::operator new(bytes, std::align_val_t(alignment));
+}
+
+void S21AlignedResource::do_deallocate(void* p, std::size_t,
+                                       std::size_t alignment) {
+  ::operator delete(p, std::align_val_t(alignment));
+}
+
+bool S21AlignedResource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+S21PoolResource::S21PoolResource(std::pmr::memory_resource* upstream)
+    : upstream_(upstream), free_() {}
+
+S21PoolResource::~S21PoolResource() { Release(); }
+
+int S21PoolResource::_Class(std::size_t bytes) noexcept {
+  int index = 0;
+  std::size_t block = kMinBlock;
+  while (block < bytes && index < kClasses) {
+    block <<= 1;
+    index++;
+  }
+  return index;
+}
+
+void* S21PoolResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+  const int index = _Class(bytes);
+  if (index >= kClasses || alignment > kMinBlock) {
+    void* p = upstream_->allocate(bytes, alignment);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Account(stats_, bytes, true);
+    return p;
+  }
+  const std::size_t block = kMinBlock << index;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (FreeBlock* head = free_[index]) {
+      free_[index] = head->next;
+      Account(stats_, block, false);
+      return head;
+    }
+  }
+  void* p = upstream_->allocate(block, kMinBlock);
+  std::lock_guard<std::mutex> lock(mutex_);
+  Account(stats_, block, true);
+  return p;
+}
+
+void S21PoolResource::do_deallocate(void* p, std::size_t bytes,
+                                    std::size_t alignment) {
+  const int index = _Class(bytes);
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.deallocations++;
+  if (index >= kClasses || alignment > kMinBlock) {
+    stats_.bytes_in_use -= bytes;
+    upstream_->deallocate(p, bytes, alignment);
+  } else {
+    stats_.bytes_in_use -= kMinBlock << index;
+    FreeBlock* block = static_cast<FreeBlock*>(p);
+    block->next = free_[index];
+    free_[index] = block;
+  }
+}
+
+bool S21PoolResource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+void S21PoolResource::Release() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (int index = 0; index < kClasses; index++) {
+    while (FreeBlock* head = free_[index]) {
+      free_[index] = head->next;
+      upstream_->deallocate(head, kMinBlock << index, kMinBlock);
+    }
+  }
+}
+
+S21AllocationStats S21PoolResource::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+S21ArenaResource::S21ArenaResource(std::size_t chunk_bytes,
+                                   std::pmr::memory_resource* upstream)
+    : upstream_(upstream),
+      chunk_bytes_(std::max<std::size_t>(chunk_bytes, kChunkAlignment)),
+      current_(0),
+      offset_(0) {}
+
+S21ArenaResource::~S21ArenaResource() { Release(); }
+
+void* S21ArenaResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+  alignment = std::max(alignment, alignof(std::max_align_t));
+  const bool over_aligned = alignment > kChunkAlignment;
+  // First fit in the current chunk or any later one kept from before the
+  // last Reset(); otherwise a new chunk big enough for the request. An
+  // over-aligned request only tries the current chunk, so that a miss does
+  // not skip chunks later requests can still use.
+  for (; current_ < chunks_.size(); current_++, offset_ = 0) {
+    const Chunk& chunk = chunks_[current_];
+    std::size_t start = (offset_ + alignment - 1) / alignment * alignment;
+    if (start + bytes <= chunk.size && alignment <= chunk.alignment) {
+      offset_ = start + bytes;
+      std::lock_guard<std::mutex> lock(mutex_);
+      Account(stats_, bytes, false);
+      return chunk.data + start;
+    }
+    if (over_aligned) break;
+  }
+  const std::size_t chunk_alignment = std::max(alignment, kChunkAlignment);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Account(stats_, bytes, true);
+  }
+  if (current_ < chunks_.size()) {
+    // A chunk of its own, put before the current one, which stays current.
+    Chunk chunk{static_cast<char*>(upstream_->allocate(bytes, chunk_alignment)),
+                bytes, chunk_alignment};
+    chunks_.insert(chunks_.begin() + current_, chunk);
+    current_++;
+    return chunk.data;
+  }
+  std::size_t size = std::max(chunk_bytes_, bytes);
+  Chunk chunk{static_cast<char*>(upstream_->allocate(size, chunk_alignment)),
+              size, chunk_alignment};
+  chunks_.push_back(chunk);
+  current_ = chunks_.size() - 1;
+  offset_ = bytes;
+  return chunk.data;
+}
+
+void S21ArenaResource::do_deallocate(void*, std::size_t bytes, std::size_t) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.deallocations++;
+  stats_.bytes_in_use -= std::min(bytes, stats_.bytes_in_use);
+}
+
+bool S21ArenaResource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+void S21ArenaResource::Reset() noexcept {
+  current_ = 0;
+  offset_ = 0;
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.bytes_in_use = 0;
+}
+
+void S21ArenaResource::Release() noexcept {
+  for (const Chunk& chunk : chunks_) {
+    upstream_->deallocate(chunk.data, chunk.size, chunk.alignment);
+  }
+  chunks_.clear();
+  Reset();
+}
+
+S21AllocationStats S21ArenaResource::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+S21ResourceScope::S21ResourceScope(std::pmr::memory_resource* resource) noexcept
+    : previous_(S21Matrix::SetDefaultResource(resource)) {}
+
+S21ResourceScope::~S21ResourceScope() {
+  S21Matrix::SetDefaultResource(previous_);
+}
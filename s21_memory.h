@@ -0,0 +1,130 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_MEMORY_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_MEMORY_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+// Allocation counters shared by the S21 memory resources. A request is
+// "avoided" when it was served from memory the resource already held
+// instead of going to its upstream resource.
+struct S21AllocationStats {
+  std::size_t allocations = 0;
+  std::size_t deallocations = 0;
+  std::size_t upstream_allocations = 0;
+  std::size_t bytes_in_use = 0;
+  std::size_t peak_bytes = 0;
+
+  std::size_t AllocationsAvoided() const noexcept {
+    return allocations - upstream_allocations;
+  }
+};
+
+// Aligned operator new/delete; the default resource of every S21Matrix.
+class S21AlignedResource : public std::pmr::memory_resource {
+ public:
+  static S21AlignedResource* Instance() noexcept;
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void* p, std::size_t bytes,
+                     std::size_t alignment) override;
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override;
+};
+
+// Thread-safe pool of power-of-two size classes from 64 bytes to 4 MB.
+// Freed blocks go to a per-class free list and are handed out again to the
+// next request of the same class; bigger or over-aligned requests go
+// straight to upstream.
+class S21PoolResource : public std::pmr::memory_resource {
+ public:
+  explicit S21PoolResource(
+      std::pmr::memory_resource* upstream = S21AlignedResource::Instance());
+  S21PoolResource(const S21PoolResource&) = delete;
+  S21PoolResource& operator=(const S21PoolResource&) = delete;
+  ~S21PoolResource() override;
+
+  // Returns the cached free blocks to upstream.
+  void Release();
+  S21AllocationStats GetStats() const;
+
+ private:
+  static constexpr std::size_t kMinBlock = 64;
+  static constexpr int kClasses = 17;
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  std::pmr::memory_resource* upstream_;
+  FreeBlock* free_[kClasses];
+  mutable std::mutex mutex_;
+  S21AllocationStats stats_;
+
+  static int _Class(std::size_t bytes) noexcept;
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void* p, std::size_t bytes,
+                     std::size_t alignment) override;
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override;
+};
+
+// Bump allocator for one thread. Deallocation is a no-op; Reset() makes all
+// of the memory available again at once, typically at the end of a request,
+// and keeps the chunks for the next one. Every matrix allocated from the
+// arena must be gone before Reset(). The counters are guarded, so a matrix
+// may still be freed on another thread, such as a thread pool worker.
+class S21ArenaResource : public std::pmr::memory_resource {
+ public:
+  explicit S21ArenaResource(
+      std::size_t chunk_bytes = 1 << 20,
+      std::pmr::memory_resource* upstream = S21AlignedResource::Instance());
+  S21ArenaResource(const S21ArenaResource&) = delete;
+  S21ArenaResource& operator=(const S21ArenaResource&) = delete;
+  ~S21ArenaResource() override;
+
+  void Reset() noexcept;
+  // Returns every chunk to upstream.
+  void Release() noexcept;
+  S21AllocationStats GetStats() const;
+
+ private:
+  static constexpr std::size_t kChunkAlignment = 64;
+
+  struct Chunk {
+    char* data;
+    std::size_t size;
+    std::size_t alignment;
+  };
+
+  std::pmr::memory_resource* upstream_;
+  std::size_t chunk_bytes_;
+  std::vector<Chunk> chunks_;
+  std::size_t current_;
+  std::size_t offset_;
+  mutable std::mutex mutex_;
+  S21AllocationStats stats_;
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void* p, std::size_t bytes,
+                     std::size_t alignment) override;
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override;
+};
+
+// Makes resource the S21Matrix default resource of the current thread for
+// the lifetime of the scope.
+class S21ResourceScope {
+ public:
+  explicit S21ResourceScope(std::pmr::memory_resource* resource) noexcept;
+  S21ResourceScope(const S21ResourceScope&) = delete;
+  S21ResourceScope& operator=(const S21ResourceScope&) = delete;
+  ~S21ResourceScope();
+
+ private:
+  std::pmr::memory_resource* previous_;
+};
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_MEMORY_H
@@ -0,0 +1,258 @@
+#include "s21_profile.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+
+namespace s21 {
+
+namespace {
+
+#ifdef S21_INSTRUMENT
+constexpr bool kInstrumented = true;
+#else
+constexpr bool kInstrumented = false;
+#endif
+
+constexpr const char* kOpNames[kProfileOps] = {
+    "Allocate",  "Copy",        "SumMatrix",       "SubMatrix",
+    "MulNumber", "MulMatrix",   "Transpose",       "Determinant",
+    "CalcComplements",          "InverseMatrix",   "Solve",
+    "Save",      "Load"};
+
+using Counter = std::atomic<std::uint64_t>;
+
+// Counters live in static storage, so they start at zero.
+struct OpCounters {
+  Counter calls;
+  Counter bytes_allocated;
+  Counter bytes_copied;
+  Counter flops;
+  Counter time_ns;
+  Counter time_histogram[kProfileTimeBuckets];
+  Counter cycles;
+  Counter instructions;
+  Counter cache_misses;
+};
+
+OpCounters counters[kProfileOps];
+std::atomic<bool> hardware_seen{false};
+thread_local ProfileScope* innermost = nullptr;
+
+void Add(Counter& counter, std::uint64_t value) noexcept {
+  if (value != 0) counter.fetch_add(value, std::memory_order_relaxed);
+}
+
+std::int64_t NowNs() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+int TimeBucket(std::int64_t ns) noexcept {
+  int bucket = 0;
+  while (bucket + 1 < kProfileTimeBuckets && (ns >> (bucket + 1)) != 0)
+    bucket++;
+  return bucket;
+}
+
+OpCounters& Target(ProfileOp fallback) noexcept {
+  const ProfileOp op = innermost != nullptr ? innermost->op() : fallback;
+  return counters[static_cast<int>(op)];
+}
+
+// Cycles, instructions and cache misses of the calling thread as one
+// perf_event group, opened on first use; unavailable when the kernel or its
+// perf_event_paranoid setting refuses it.
+class HardwareCounters {
+ public:
+  static constexpr int kEvents = 3;
+
+#ifdef __linux__
+  HardwareCounters() noexcept {
+    const std::uint64_t events[kEvents] = {PERF_COUNT_HW_CPU_CYCLES,
+                                           PERF_COUNT_HW_INSTRUCTIONS,
+                                           PERF_COUNT_HW_CACHE_MISSES};
+    for (int i = 0; i < kEvents; i++) {
+      perf_event_attr attr{};
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = events[i];
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP;
+      fds_[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1,
+                                         i == 0 ? -1 : fds_[0], 0));
+      if (fds_[i] < 0) {
+        _Close();
+        return;
+      }
+    }
+  }
+  HardwareCounters(const HardwareCounters&) = delete;
+  HardwareCounters& operator=(const HardwareCounters&) = delete;
+  ~HardwareCounters() { _Close(); }
+
+  bool Read(std::uint64_t* values) const noexcept {
+    std::uint64_t group[kEvents + 1];
+    if (fds_[0] < 0 ||
+        read(fds_[0], group, sizeof(group)) !=
+            static_cast<ssize_t>(sizeof(group)) ||
+        group[0] != kEvents)
+      return false;
+    for (int i = 0; i < kEvents; i++) values[i] = group[i + 1];
+    return true;
+  }
+
+ private:
+  int fds_[kEvents] = {-1, -1, -1};
+
+  void _Close() noexcept {
+    for (int& fd : fds_) {
+      if (fd >= 0) close(fd);
+      fd = -1;
+    }
+  }
+#else
+  bool Read(std::uint64_t*) const noexcept { return false; }
+#endif
+};
+
+const HardwareCounters& ThreadHardwareCounters() noexcept {
+  thread_local HardwareCounters hardware;
+  return hardware;
+}
+
+void AppendField(std::string& json, const char* name, std::uint64_t value) {
+  json += '"';
+  json += name;
+  json += "\": ";
+  json += std::to_string(value);
+  json += ", ";
+}
+
+}  // namespace
+
+const char* ProfileOpName(ProfileOp op) noexcept {
+  return kOpNames[static_cast<int>(op)];
+}
+
+ProfileSnapshot TakeProfileSnapshot() {
+  ProfileSnapshot snapshot;
+  snapshot.enabled = kInstrumented;
+  snapshot.hardware = hardware_seen.load(std::memory_order_relaxed);
+  for (int i = 0; i < kProfileOps; i++) {
+    const OpCounters& source = counters[i];
+    OpProfile& op = snapshot.ops[i];
+    op.calls = source.calls.load(std::memory_order_relaxed);
+    op.bytes_allocated =
+        source.bytes_allocated.load(std::memory_order_relaxed);
+    op.bytes_copied = source.bytes_copied.load(std::memory_order_relaxed);
+    op.flops = source.flops.load(std::memory_order_relaxed);
+    op.time_ns = source.time_ns.load(std::memory_order_relaxed);
+    for (int b = 0; b < kProfileTimeBuckets; b++)
+      op.time_histogram[b] =
+          source.time_histogram[b].load(std::memory_order_relaxed);
+    op.cycles = source.cycles.load(std::memory_order_relaxed);
+    op.instructions = source.instructions.load(std::memory_order_relaxed);
+    op.cache_misses = source.cache_misses.load(std::memory_order_relaxed);
+  }
+  return snapshot;
+}
+
+void ResetProfile() noexcept {
+  for (OpCounters& op : counters) {
+    for (Counter* counter :
+         {&op.calls, &op.bytes_allocated, &op.bytes_copied, &op.flops,
+          &op.time_ns, &op.cycles, &op.instructions, &op.cache_misses})
+      counter->store(0, std::memory_order_relaxed);
+    for (Counter& bucket : op.time_histogram)
+      bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+std::string ProfileJson(const ProfileSnapshot& snapshot) {
+  std::string json = "{\"enabled\": ";
+  json += snapshot.enabled ? "true" : "false";
+  json += ", \"hardware\": ";
+  json += snapshot.hardware ? "true" : "false";
+  json += ", \"operations\": {";
+  for (int i = 0; i < kProfileOps; i++) {
+    const OpProfile& op = snapshot.ops[i];
+    if (i > 0) json += ", ";
+    json += '"';
+    json += kOpNames[i];
+    json += "\": {";
+    AppendField(json, "calls", op.calls);
+    AppendField(json, "bytes_allocated", op.bytes_allocated);
+    AppendField(json, "bytes_copied", op.bytes_copied);
+    AppendField(json, "flops", op.flops);
+    AppendField(json, "time_ns", op.time_ns);
+    AppendField(json, "cycles", op.cycles);
+    AppendField(json, "instructions", op.instructions);
+    AppendField(json, "cache_misses", op.cache_misses);
+    json += "\"time_histogram_ns\": {";
+    bool first = true;
+    for (int b = 0; b < kProfileTimeBuckets; b++) {
+      if (op.time_histogram[b] == 0) continue;
+      if (!first) json += ", ";
+      first = false;
+      json += '"';
+      json += std::to_string(std::uint64_t(1) << (b + 1));
+      json += "\": ";
+      json += std::to_string(op.time_histogram[b]);
+    }
+    json += "}}";
+  }
+  json += "}}";
+  return json;
+}
+
+ProfileScope::ProfileScope(ProfileOp op, double flops) noexcept
+    : op_(op),
+      active_(innermost == nullptr || innermost->op_ != op),
+      hardware_(false),
+      flops_(flops > 0 ? static_cast<std::uint64_t>(flops) : 0),
+      start_ns_(0),
+      start_hardware_{},
+      outer_(innermost) {
+  if (!active_) return;
+  innermost = this;
+  hardware_ = ThreadHardwareCounters().Read(start_hardware_);
+  start_ns_ = NowNs();
+}
+
+ProfileScope::~ProfileScope() {
+  if (!active_) return;
+  const std::int64_t ns = NowNs() - start_ns_;
+  innermost = outer_;
+  OpCounters& op = counters[static_cast<int>(op_)];
+  Add(op.calls, 1);
+  Add(op.flops, flops_);
+  Add(op.time_ns, ns);
+  Add(op.time_histogram[TimeBucket(ns)], 1);
+  std::uint64_t end[HardwareCounters::kEvents];
+  if (hardware_ && ThreadHardwareCounters().Read(end)) {
+    Add(op.cycles, end[0] - start_hardware_[0]);
+    Add(op.instructions, end[1] - start_hardware_[1]);
+    Add(op.cache_misses, end[2] - start_hardware_[2]);
+    hardware_seen.store(true, std::memory_order_relaxed);
+  }
+}
+
+void ProfileAllocated(std::size_t bytes) noexcept {
+  OpCounters& op = Target(ProfileOp::kAllocate);
+  if (innermost == nullptr) Add(op.calls, 1);
+  Add(op.bytes_allocated, bytes);
+}
+
+void ProfileCopied(std::size_t bytes) noexcept {
+  Add(Target(ProfileOp::kCopy).bytes_copied, bytes);
+}
+
+}  // namespace s21
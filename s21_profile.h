@@ -0,0 +1,111 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_PROFILE_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_PROFILE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Per-operation counters of the matrix library. The library records them
+// only when it is built with S21_INSTRUMENT defined (make INSTRUMENT=1);
+// otherwise the S21_PROFILE_* macros expand to nothing and cost nothing.
+// The snapshot API below exists in both builds, so callers need no #ifdef.
+#ifdef S21_INSTRUMENT
+#define S21_PROFILE_SCOPE(op, flops) \
+  s21::ProfileScope s21_profile_scope_(s21::ProfileOp::op, (flops))
+#define S21_PROFILE_ALLOCATED(bytes) s21::ProfileAllocated(bytes)
+#define S21_PROFILE_COPIED(bytes) s21::ProfileCopied(bytes)
+#else
+#define S21_PROFILE_SCOPE(op, flops) static_cast<void>(0)
+#define S21_PROFILE_ALLOCATED(bytes) static_cast<void>(0)
+#define S21_PROFILE_COPIED(bytes) static_cast<void>(0)
+#endif
+
+namespace s21 {
+
+enum class ProfileOp {
+  kAllocate,  // buffers allocated outside every other operation
+  kCopy,      // copy construction and copy assignment
+  kSum,
+  kSub,
+  kMulNumber,
+  kMulMatrix,  // MulMatrix, MulMatrixMixed and the product operator
+  kTranspose,
+  kDeterminant,
+  kComplements,
+  kInverse,
+  kSolve,
+  kSave,
+  kLoad,
+  kCount
+};
+
+constexpr int kProfileOps = static_cast<int>(ProfileOp::kCount);
+// Bucket b of a time histogram counts calls of [2^b, 2^(b + 1)) ns; the
+// last one also counts everything longer.
+constexpr int kProfileTimeBuckets = 40;
+
+struct OpProfile {
+  std::uint64_t calls = 0;
+  std::uint64_t bytes_allocated = 0;
+  std::uint64_t bytes_copied = 0;
+  std::uint64_t flops = 0;
+  std::uint64_t time_ns = 0;
+  std::array<std::uint64_t, kProfileTimeBuckets> time_histogram{};
+  // Hardware counters of the calling thread; zero without perf_event.
+  std::uint64_t cycles = 0;
+  std::uint64_t instructions = 0;
+  std::uint64_t cache_misses = 0;
+};
+
+struct ProfileSnapshot {
+  // True when the library was built with S21_INSTRUMENT.
+  bool enabled = false;
+  // True once perf_event delivered hardware counters.
+  bool hardware = false;
+  std::array<OpProfile, kProfileOps> ops{};
+
+  const OpProfile& operator[](ProfileOp op) const noexcept {
+    return ops[static_cast<int>(op)];
+  }
+};
+
+const char* ProfileOpName(ProfileOp op) noexcept;
+ProfileSnapshot TakeProfileSnapshot();
+void ResetProfile() noexcept;
+// The snapshot as one JSON object:
+//   {"enabled": true, "hardware": false, "operations": {"MulMatrix":
+//   {"calls": 1, ..., "time_histogram_ns": {"2048": 1}}, ...}}
+// Histogram keys are the exclusive upper bounds of the non-empty buckets.
+std::string ProfileJson(const ProfileSnapshot& snapshot);
+
+// Times the enclosing operation, which is inclusive of any operations it
+// calls. A scope opened inside one of the same operation records nothing,
+// so an operation that calls its own kernel entry point is counted once.
+// Bytes allocated and copied go to the innermost open scope. Hardware
+// counters cover the calling thread only, not pool workers.
+class ProfileScope {
+ public:
+  ProfileScope(ProfileOp op, double flops) noexcept;
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+  ~ProfileScope();
+
+  ProfileOp op() const noexcept { return op_; }
+
+ private:
+  ProfileOp op_;
+  bool active_;
+  bool hardware_;
+  std::uint64_t flops_;
+  std::int64_t start_ns_;
+  std::uint64_t start_hardware_[3];
+  ProfileScope* outer_;
+};
+
+void ProfileAllocated(std::size_t bytes) noexcept;
+void ProfileCopied(std::size_t bytes) noexcept;
+
+}  // namespace s21
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_PROFILE_H
@@ -0,0 +1,172 @@
+#include "s21_qr.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "s21_simd.h"
+#include "s21_triangular.h"
+
+template <class T>
+S21BasicQR<T>::S21BasicQR(S21BasicMatrixView<const T> matrix)
+    : qr_(matrix),
+      t_(std::min(kBlock, matrix.GetCols()), matrix.GetCols()),
+      rows_(matrix.GetRows()),
+      cols_(matrix.GetCols()),
+      rank_deficient_(false) {
+  if (rows_ < cols_) throw std::invalid_argument("Rows less than columns");
+  S21BasicMatrixView<T> a = qr_.View();
+  T max_abs = 0;
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++)
+      max_abs = std::max(max_abs, std::abs(a.Row(i)[j]));
+  }
+  const T tolerance = max_abs * rows_ * std::numeric_limits<T>::epsilon();
+  for (int k = 0; k < cols_; k += kBlock) {
+    const int nb = std::min(kBlock, cols_ - k);
+    S21BasicMatrixView<T> t = t_.View().Block(0, k, nb, nb);
+    _FactorPanel(a, k, nb, t);
+    for (int j = k; j < k + nb; j++) {
+      if (std::abs(a.Row(j)[j]) <= tolerance) rank_deficient_ = true;
+    }
+    const S21BasicMatrix<T> v = _Reflectors(k, nb);
+    _FormT(v, t);
+    if (k + nb < cols_)
+      _ApplyTransposed(v, t, a.Block(k, k + nb, rows_ - k, cols_ - k - nb));
+  }
+}
+
+// Unblocked Householder QR of columns [k, k + nb): H_j = I - tau v v^T with
+// v(j) = 1 maps column j below the diagonal onto beta e_j. The reflector is
+// applied to the rest of the panel row by row as a rank-1 update.
+template <class T>
+void S21BasicQR<T>::_FactorPanel(S21BasicMatrixView<T> a, int k, int nb,
+                                 S21BasicMatrixView<T> t) {
+  const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+  const int rows = a.GetRows();
+  const int end = k + nb;
+  std::vector<T> w(nb);
+  for (int j = k; j < end; j++) {
+    const T alpha = a.Row(j)[j];
+    T sigma = 0;
+    for (int i = j + 1; i < rows; i++) sigma += a.Row(i)[j] * a.Row(i)[j];
+    T tau = 0;
+    if (sigma != 0) {
+      const T beta = -std::copysign(std::sqrt(alpha * alpha + sigma), alpha);
+      tau = (beta - alpha) / beta;
+      const T scale = 1 / (alpha - beta);
+      for (int i = j + 1; i < rows; i++) a.Row(i)[j] *= scale;
+      a.Row(j)[j] = beta;
+    }
+    t.Row(j - k)[j - k] = tau;
+    const int width = end - j - 1;
+    if (tau == 0 || width == 0) continue;
+    // w = v^T A(j:, j+1:end), then A(j:, j+1:end) -= tau v w.
+    std::copy(a.Row(j) + j + 1, a.Row(j) + end, w.data());
+    for (int i = j + 1; i < rows; i++)
+      simd.axpy(a.Row(i)[j], a.Row(i) + j + 1, w.data(), width);
+    simd.axpy(-tau, w.data(), a.Row(j) + j + 1, width);
+    for (int i = j + 1; i < rows; i++)
+      simd.axpy(-tau * a.Row(i)[j], w.data(), a.Row(i) + j + 1, width);
+  }
+}
+
+// T(0:j, j) = -tau_j T(0:j, 0:j) V(:, 0:j)^T v_j, with the inner products
+// of the reflectors taken from one GEMM.
+template <class T>
+void S21BasicQR<T>::_FormT(S21BasicMatrixView<const T> v,
+                           S21BasicMatrixView<T> t) {
+  const int nb = v.GetCols();
+  S21BasicMatrix<T> gram(nb, nb);
+  s21::Gemm<T>(1, v.Transposed(), v, 0, gram);
+  for (int j = 0; j < nb; j++) {
+    const T tau = t(j, j);
+    for (int i = 0; i < j; i++) {
+      T sum = 0;
+      for (int r = i; r < j; r++) sum += t(i, r) * gram(r, j);
+      t(i, j) = -tau * sum;
+    }
+    for (int i = j + 1; i < nb; i++) t(i, j) = 0;
+  }
+}
+
+// C := Q_k^T C = C - V (T^T (V^T C)).
+template <class T>
+void S21BasicQR<T>::_ApplyTransposed(S21BasicMatrixView<const T> v,
+                                     S21BasicMatrixView<const T> t,
+                                     S21BasicMatrixView<T> c) {
+  const int nb = v.GetCols();
+  S21BasicMatrix<T> w(nb, c.GetCols()), tw(nb, c.GetCols());
+  s21::Gemm<T>(1, v.Transposed(), c, 0, w);
+  s21::Gemm<T>(1, t.Transposed(), w, 0, tw);
+  s21::Gemm<T>(-1, v, tw, 1, c);
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicQR<T>::_Reflectors(int k, int nb) const {
+  S21BasicMatrix<T> v(rows_ - k, nb);
+  S21BasicMatrixView<const T> packed = qr_.View().Block(k, k, rows_ - k, nb);
+  for (int i = 0; i < rows_ - k; i++) {
+    T* row = v.data() + static_cast<std::size_t>(i) * v.stride();
+    const int below = std::min(i, nb);
+    std::copy(packed.Row(i), packed.Row(i) + below, row);
+    if (i < nb) row[i] = 1;
+  }
+  return v;
+}
+
+template <class T>
+int S21BasicQR<T>::GetRows() const noexcept {
+  return rows_;
+}
+
+template <class T>
+int S21BasicQR<T>::GetCols() const noexcept {
+  return cols_;
+}
+
+template <class T>
+const S21BasicMatrix<T>& S21BasicQR<T>::GetFactors() const noexcept {
+  return qr_;
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicQR<T>::GetR() const {
+  S21BasicMatrix<T> r(cols_, cols_);
+  for (int i = 0; i < cols_; i++) {
+    const T* source = qr_.data() + static_cast<std::size_t>(i) * qr_.stride();
+    std::copy(source + i, source + cols_,
+              r.data() + static_cast<std::size_t>(i) * r.stride() + i);
+  }
+  return r;
+}
+
+template <class T>
+bool S21BasicQR<T>::IsRankDeficient() const noexcept {
+  return rank_deficient_;
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicQR<T>::Solve(S21BasicMatrixView<const T> b) const {
+  if (b.Empty()) throw std::out_of_range("Invalid matrix");
+  if (b.GetRows() != rows_) throw std::invalid_argument("Sizes are not equal");
+  if (rank_deficient_)
+    throw std::invalid_argument("Matrix is rank deficient");
+  S21BasicMatrix<T> y(b);
+  for (int k = 0; k < cols_; k += kBlock) {
+    const int nb = std::min(kBlock, cols_ - k);
+    _ApplyTransposed(_Reflectors(k, nb), t_.View().Block(0, k, nb, nb),
+                     y.View().RowRange(k, rows_));
+  }
+  S21BasicMatrix<T> x(std::as_const(y).View().RowRange(0, cols_));
+  s21::TriangularSolve<T>(s21::Triangle::kUpper, s21::Diagonal::kNonUnit,
+                          qr_.View().Block(0, 0, cols_, cols_), x);
+  return x;
+}
+
+template class S21BasicQR<float>;
+template class S21BasicQR<double>;
+template class S21BasicQR<long double>;
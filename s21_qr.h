@@ -0,0 +1,61 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_QR_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_QR_H
+
+#include "s21_matrix.h"
+
+// Householder QR factorization A = Q * R of an m x n matrix with m >= n,
+// for least-squares problems min |A x - b|. Blocked as in LAPACK: the kBlock
+// reflectors of a panel are combined into Q_k = I - V T V^T (compact WY
+// form), so nearly all of the work of factoring A and of applying Q^T to a
+// right-hand side is GEMM. R and the Householder vectors are stored packed
+// in one matrix, the T factors of the panels in another; both are computed
+// once and reused by every Solve.
+template <class T>
+class S21BasicQR {
+ public:
+  explicit S21BasicQR(S21BasicMatrixView<const T> matrix);
+
+  int GetRows() const noexcept;
+  int GetCols() const noexcept;
+  // R on and above the diagonal, the Householder vectors below it.
+  const S21BasicMatrix<T>& GetFactors() const noexcept;
+  // The n x n upper triangular factor.
+  S21BasicMatrix<T> GetR() const;
+  // True when some diagonal element of R is negligible relative to the
+  // largest element of A, i.e. the columns of A are linearly dependent to
+  // working precision.
+  bool IsRankDeficient() const noexcept;
+
+  // x of size n x k minimizing the Frobenius norm of A x - b for an m x k
+  // b; the exact solution when A is square.
+  S21BasicMatrix<T> Solve(S21BasicMatrixView<const T> b) const;
+
+ private:
+  static constexpr int kBlock = 32;
+
+  S21BasicMatrix<T> qr_;
+  // The upper triangular T of the panel starting at column k in columns
+  // [k, k + kBlock); its diagonal holds the scalar factors tau.
+  S21BasicMatrix<T> t_;
+  int rows_;
+  int cols_;
+  bool rank_deficient_;
+
+  static void _FactorPanel(S21BasicMatrixView<T> a, int k, int nb,
+                           S21BasicMatrixView<T> t);
+  static void _FormT(S21BasicMatrixView<const T> v, S21BasicMatrixView<T> t);
+  static void _ApplyTransposed(S21BasicMatrixView<const T> v,
+                               S21BasicMatrixView<const T> t,
+                               S21BasicMatrixView<T> c);
+  // The Householder vectors of the panel at column k as an explicit
+  // (m - k) x nb matrix with the unit diagonal and the zeros filled in.
+  S21BasicMatrix<T> _Reflectors(int k, int nb) const;
+};
+
+using S21QR = S21BasicQR<double>;
+
+extern template class S21BasicQR<float>;
+extern template class S21BasicQR<double>;
+extern template class S21BasicQR<long double>;
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_QR_H
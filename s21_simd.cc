@@ -0,0 +1,1106 @@
+#include "s21_simd.h"
+
+#include <cmath>
+
+#include <initializer_list>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define S21_SIMD_X86 1
+#endif
+
+namespace s21 {
+
+namespace {
+
+template <class T>
+void AddScalar(const T* a, const T* b, T* out, std::size_t n) {
+  for (std::size_t j = 0; j < n; j++) out[j] = a[j] + b[j];
+}
+
+template <class T>
+void SubScalar(const T* a, const T* b, T* out, std::size_t n) {
+  for (std::size_t j = 0; j < n; j++) out[j] = a[j] - b[j];
+}
+
+template <class T>
+void ScaleScalar(const T* a, T num, T* out, std::size_t n) {
+  for (std::size_t j = 0; j < n; j++) out[j] = a[j] * num;
+}
+
+template <class T>
+void AxpyScalar(T alpha, const T* x, T* y, std::size_t n) {
+  for (std::size_t j = 0; j < n; j++) y[j] = y[j] + alpha * x[j];
+}
+
+// Adds the partial sums pairwise, then the products of the rest elements.
+// Always inlined, so that it is compiled for the instruction set of the
+// vector kernel that calls it: legacy SSE code after AVX-512 code would
+// pay for the transition on every call.
+template <class T>
+__attribute__((always_inline)) inline T DotFinish(T* sum, const T* a,
+                                                  const T* b,
+                                                  std::size_t rest) {
+  for (std::size_t width = kDotLanes<T> / 2; width > 0; width /= 2) {
+    for (std::size_t l = 0; l < width; l++) sum[l] = sum[l] + sum[l + width];
+  }
+  T total = sum[0];
+  for (std::size_t j = 0; j < rest; j++) total = total + a[j] * b[j];
+  return total;
+}
+
+template <class T>
+T DotScalar(const T* a, const T* b, std::size_t n) {
+  constexpr std::size_t kLanes = kDotLanes<T>;
+  T sum[kLanes] = {};
+  std::size_t j = 0;
+  for (; j + kLanes <= n; j += kLanes) {
+    for (std::size_t l = 0; l < kLanes; l++)
+      sum[l] = sum[l] + a[j + l] * b[j + l];
+  }
+  return DotFinish(sum, a + j, b + j, n - j);
+}
+
+template <class T>
+void MulAddScalar(const T* a, const T* b, T* y, std::size_t n) {
+  for (std::size_t j = 0; j < n; j++) y[j] = y[j] + a[j] * b[j];
+}
+
+template <class T>
+void MulSubScalar(const T* a, const T* b, T* y, std::size_t n) {
+  for (std::size_t j = 0; j < n; j++) y[j] = y[j] - a[j] * b[j];
+}
+
+template <class T>
+void DivScalar(const T* a, const T* b, T* out, std::size_t n) {
+  for (std::size_t j = 0; j < n; j++) out[j] = a[j] / b[j];
+}
+
+template <class T>
+bool EqualScalar(const T* a, const T* b, std::size_t n, T tolerance) {
+  for (std::size_t j = 0; j < n; j++) {
+    if (std::fabs(a[j] - b[j]) > tolerance) return false;
+  }
+  return true;
+}
+
+template <class T>
+void FillScalar(T* out, std::size_t n, T val) {
+  for (std::size_t j = 0; j < n; j++) out[j] = val;
+}
+
+template <class T>
+void RampScalar(T* out, std::size_t n, int offset, T val) {
+  for (std::size_t j = 0; j < n; j++) {
+    out[j] = static_cast<int>(offset + j) + val;
+  }
+}
+
+template <class T>
+void TransposeScalar(int rows, int cols, const T* a, int lda, T* b, int ldb) {
+  for (int i = 0; i < rows; i++) {
+    const T* in = a + static_cast<std::ptrdiff_t>(i) * lda;
+    for (int j = 0; j < cols; j++) {
+      b[static_cast<std::ptrdiff_t>(j) * ldb + i] = in[j];
+    }
+  }
+}
+
+// Walks a block in kTile x kTile register tiles, transposing each with
+// TileKernel and leaving the ragged edges to the scalar loop.
+template <int kTile, class T, void (*TileKernel)(const T*, int, T*, int)>
+inline void TransposeTiled(int rows, int cols, const T* a, int lda, T* b,
+                           int ldb) {
+  int i = 0;
+  for (; i + kTile <= rows; i += kTile) {
+    const T* src = a + static_cast<std::ptrdiff_t>(i) * lda;
+    int j = 0;
+    for (; j + kTile <= cols; j += kTile) {
+      TileKernel(src + j, lda, b + static_cast<std::ptrdiff_t>(j) * ldb + i,
+                 ldb);
+    }
+    TransposeScalar(kTile, cols - j, src + j, lda,
+                    b + static_cast<std::ptrdiff_t>(j) * ldb + i, ldb);
+  }
+  TransposeScalar(rows - i, cols, a + static_cast<std::ptrdiff_t>(i) * lda,
+                  lda, b + i, ldb);
+}
+
+#ifdef S21_SIMD_X86
+
+// The vector loops below handle whole registers and hand the remainder to
+// the scalar kernels.
+
+__attribute__((target("sse2"))) void AddSse2(const double* a, const double* b,
+                                             double* out, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 2 <= n; j += 2) {
+    _mm_storeu_pd(out + j,
+                  _mm_add_pd(_mm_loadu_pd(a + j), _mm_loadu_pd(b + j)));
+  }
+  AddScalar(a + j, b + j, out + j, n - j);
+}
+
+__attribute__((target("sse2"))) void SubSse2(const double* a, const double* b,
+                                             double* out, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 2 <= n; j += 2) {
+    _mm_storeu_pd(out + j,
+                  _mm_sub_pd(_mm_loadu_pd(a + j), _mm_loadu_pd(b + j)));
+  }
+  SubScalar(a + j, b + j, out + j, n - j);
+}
+
+__attribute__((target("sse2"))) void ScaleSse2(const double* a, double num,
+                                               double* out, std::size_t n) {
+  const __m128d k = _mm_set1_pd(num);
+  std::size_t j = 0;
+  for (; j + 2 <= n; j += 2) {
+    _mm_storeu_pd(out + j, _mm_mul_pd(_mm_loadu_pd(a + j), k));
+  }
+  ScaleScalar(a + j, num, out + j, n - j);
+}
+
+__attribute__((target("sse2"))) void AxpySse2(double alpha, const double* x,
+                                              double* y, std::size_t n) {
+  const __m128d k = _mm_set1_pd(alpha);
+  std::size_t j = 0;
+  for (; j + 2 <= n; j += 2) {
+    __m128d prod = _mm_mul_pd(k, _mm_loadu_pd(x + j));
+    _mm_storeu_pd(y + j, _mm_add_pd(_mm_loadu_pd(y + j), prod));
+  }
+  AxpyScalar(alpha, x + j, y + j, n - j);
+}
+
+__attribute__((target("sse2"))) bool EqualSse2(const double* a,
+                                               const double* b, std::size_t n,
+                                               double tolerance) {
+  const __m128d abs_mask =
+      _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+  const __m128d tol = _mm_set1_pd(tolerance);
+  std::size_t j = 0;
+  for (; j + 2 <= n; j += 2) {
+    __m128d diff = _mm_sub_pd(_mm_loadu_pd(a + j), _mm_loadu_pd(b + j));
+    if (_mm_movemask_pd(_mm_cmpgt_pd(_mm_and_pd(diff, abs_mask), tol)))
+      return false;
+  }
+  return EqualScalar(a + j, b + j, n - j, tolerance);
+}
+
+__attribute__((target("sse2"))) void FillSse2(double* out, std::size_t n,
+                                              double val) {
+  const __m128d v = _mm_set1_pd(val);
+  std::size_t j = 0;
+  for (; j + 2 <= n; j += 2) _mm_storeu_pd(out + j, v);
+  FillScalar(out + j, n - j, val);
+}
+
+__attribute__((target("sse2"))) void RampSse2(double* out, std::size_t n,
+                                              int offset, double val) {
+  const __m128d v = _mm_set1_pd(val);
+  const __m128d step = _mm_set1_pd(2.);
+  __m128d index = _mm_set_pd(offset + 1., offset + 0.);
+  std::size_t j = 0;
+  for (; j + 2 <= n; j += 2) {
+    _mm_storeu_pd(out + j, _mm_add_pd(index, v));
+    index = _mm_add_pd(index, step);
+  }
+  RampScalar(out + j, n - j, static_cast<int>(offset + j), val);
+}
+
+__attribute__((target("avx2"))) void AddAvx2(const double* a, const double* b,
+                                             double* out, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    _mm256_storeu_pd(out + j, _mm256_add_pd(_mm256_loadu_pd(a + j),
+                                            _mm256_loadu_pd(b + j)));
+  }
+  AddScalar(a + j, b + j, out + j, n - j);
+}
+
+__attribute__((target("avx2"))) void SubAvx2(const double* a, const double* b,
+                                             double* out, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    _mm256_storeu_pd(out + j, _mm256_sub_pd(_mm256_loadu_pd(a + j),
+                                            _mm256_loadu_pd(b + j)));
+  }
+  SubScalar(a + j, b + j, out + j, n - j);
+}
+
+__attribute__((target("avx2"))) void ScaleAvx2(const double* a, double num,
+                                               double* out, std::size_t n) {
+  const __m256d k = _mm256_set1_pd(num);
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    _mm256_storeu_pd(out + j, _mm256_mul_pd(_mm256_loadu_pd(a + j), k));
+  }
+  ScaleScalar(a + j, num, out + j, n - j);
+}
+
+__attribute__((target("avx2"))) void AxpyAvx2(double alpha, const double* x,
+                                              double* y, std::size_t n) {
+  const __m256d k = _mm256_set1_pd(alpha);
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    __m256d prod = _mm256_mul_pd(k, _mm256_loadu_pd(x + j));
+    _mm256_storeu_pd(y + j, _mm256_add_pd(_mm256_loadu_pd(y + j), prod));
+  }
+  AxpyScalar(alpha, x + j, y + j, n - j);
+}
+
+__attribute__((target("avx2"))) bool EqualAvx2(const double* a,
+                                               const double* b, std::size_t n,
+                                               double tolerance) {
+  const __m256d abs_mask =
+      _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+  const __m256d tol = _mm256_set1_pd(tolerance);
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    __m256d diff =
+        _mm256_sub_pd(_mm256_loadu_pd(a + j), _mm256_loadu_pd(b + j));
+    __m256d gt = _mm256_cmp_pd(_mm256_and_pd(diff, abs_mask), tol, _CMP_GT_OQ);
+    if (_mm256_movemask_pd(gt)) return false;
+  }
+  return EqualScalar(a + j, b + j, n - j, tolerance);
+}
+
+__attribute__((target("avx2"))) void FillAvx2(double* out, std::size_t n,
+                                              double val) {
+  const __m256d v = _mm256_set1_pd(val);
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) _mm256_storeu_pd(out + j, v);
+  FillScalar(out + j, n - j, val);
+}
+
+__attribute__((target("avx2"))) void RampAvx2(double* out, std::size_t n,
+                                              int offset, double val) {
+  const __m256d v = _mm256_set1_pd(val);
+  const __m256d step = _mm256_set1_pd(4.);
+  __m256d index =
+      _mm256_set_pd(offset + 3., offset + 2., offset + 1., offset + 0.);
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    _mm256_storeu_pd(out + j, _mm256_add_pd(index, v));
+    index = _mm256_add_pd(index, step);
+  }
+  RampScalar(out + j, n - j, static_cast<int>(offset + j), val);
+}
+
+__attribute__((target("avx512f"))) void AddAvx512(const double* a,
+                                                  const double* b,
+                                                  double* out, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    _mm512_storeu_pd(out + j, _mm512_add_pd(_mm512_loadu_pd(a + j),
+                                            _mm512_loadu_pd(b + j)));
+  }
+  AddScalar(a + j, b + j, out + j, n - j);
+}
+
+__attribute__((target("avx512f"))) void SubAvx512(const double* a,
+                                                  const double* b,
+                                                  double* out, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    _mm512_storeu_pd(out + j, _mm512_sub_pd(_mm512_loadu_pd(a + j),
+                                            _mm512_loadu_pd(b + j)));
+  }
+  SubScalar(a + j, b + j, out + j, n - j);
+}
+
+__attribute__((target("avx512f"))) void ScaleAvx512(const double* a,
+                                                    double num, double* out,
+                                                    std::size_t n) {
+  const __m512d k = _mm512_set1_pd(num);
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    _mm512_storeu_pd(out + j, _mm512_mul_pd(_mm512_loadu_pd(a + j), k));
+  }
+  ScaleScalar(a + j, num, out + j, n - j);
+}
+
+__attribute__((target("avx512f"))) void AxpyAvx512(double alpha,
+                                                   const double* x, double* y,
+                                                   std::size_t n) {
+  const __m512d k = _mm512_set1_pd(alpha);
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    __m512d prod = _mm512_mul_pd(k, _mm512_loadu_pd(x + j));
+    _mm512_storeu_pd(y + j, _mm512_add_pd(_mm512_loadu_pd(y + j), prod));
+  }
+  AxpyScalar(alpha, x + j, y + j, n - j);
+}
+
+__attribute__((target("avx512f"))) bool EqualAvx512(const double* a,
+                                                    const double* b,
+                                                    std::size_t n,
+                                                    double tolerance) {
+  const __m512d tol = _mm512_set1_pd(tolerance);
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    __m512d diff =
+        _mm512_sub_pd(_mm512_loadu_pd(a + j), _mm512_loadu_pd(b + j));
+    if (_mm512_cmp_pd_mask(_mm512_abs_pd(diff), tol, _CMP_GT_OQ)) return false;
+  }
+  return EqualScalar(a + j, b + j, n - j, tolerance);
+}
+
+__attribute__((target("avx512f"))) void FillAvx512(double* out, std::size_t n,
+                                                   double val) {
+  const __m512d v = _mm512_set1_pd(val);
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) _mm512_storeu_pd(out + j, v);
+  FillScalar(out + j, n - j, val);
+}
+
+__attribute__((target("avx512f"))) void RampAvx512(double* out, std::size_t n,
+                                                   int offset, double val) {
+  const __m512d v = _mm512_set1_pd(val);
+  const __m512d step = _mm512_set1_pd(8.);
+  __m512d index = _mm512_set_pd(offset + 7., offset + 6., offset + 5.,
+                                offset + 4., offset + 3., offset + 2.,
+                                offset + 1., offset + 0.);
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    _mm512_storeu_pd(out + j, _mm512_add_pd(index, v));
+    index = _mm512_add_pd(index, step);
+  }
+  RampScalar(out + j, n - j, static_cast<int>(offset + j), val);
+}
+
+// The dot kernels keep kDotLanes partial sums in as many registers as it
+// takes and store them for DotFinish.
+__attribute__((target("sse2"))) double DotSse2(const double* a,
+                                               const double* b,
+                                               std::size_t n) {
+  const __m128d zero = _mm_setzero_pd();
+  __m128d acc[8] = {zero, zero, zero, zero, zero, zero, zero, zero};
+  std::size_t j = 0;
+  for (; j + 16 <= n; j += 16) {
+#pragma GCC unroll 8
+    for (int q = 0; q < 8; q++) {
+      __m128d prod = _mm_mul_pd(_mm_loadu_pd(a + j + 2 * q),
+                                _mm_loadu_pd(b + j + 2 * q));
+      acc[q] = _mm_add_pd(acc[q], prod);
+    }
+  }
+  double sum[16];
+  for (int q = 0; q < 8; q++) _mm_storeu_pd(sum + 2 * q, acc[q]);
+  return DotFinish(sum, a + j, b + j, n - j);
+}
+
+__attribute__((target("avx2"))) double DotAvx2(const double* a,
+                                               const double* b,
+                                               std::size_t n) {
+  const __m256d zero = _mm256_setzero_pd();
+  __m256d acc[4] = {zero, zero, zero, zero};
+  std::size_t j = 0;
+  for (; j + 16 <= n; j += 16) {
+#pragma GCC unroll 4
+    for (int q = 0; q < 4; q++) {
+      __m256d prod = _mm256_mul_pd(_mm256_loadu_pd(a + j + 4 * q),
+                                   _mm256_loadu_pd(b + j + 4 * q));
+      acc[q] = _mm256_add_pd(acc[q], prod);
+    }
+  }
+  double sum[16];
+  for (int q = 0; q < 4; q++) _mm256_storeu_pd(sum + 4 * q, acc[q]);
+  return DotFinish(sum, a + j, b + j, n - j);
+}
+
+__attribute__((target("avx512f"))) double DotAvx512(const double* a,
+                                                    const double* b,
+                                                    std::size_t n) {
+  __m512d acc[2] = {_mm512_setzero_pd(), _mm512_setzero_pd()};
+  std::size_t j = 0;
+  for (; j + 16 <= n; j += 16) {
+#pragma GCC unroll 2
+    for (int q = 0; q < 2; q++) {
+      __m512d prod = _mm512_mul_pd(_mm512_loadu_pd(a + j + 8 * q),
+                                   _mm512_loadu_pd(b + j + 8 * q));
+      acc[q] = _mm512_add_pd(acc[q], prod);
+    }
+  }
+  double sum[16];
+  for (int q = 0; q < 2; q++) _mm512_storeu_pd(sum + 8 * q, acc[q]);
+  return DotFinish(sum, a + j, b + j, n - j);
+}
+
+__attribute__((target("sse2"))) void MulAddSse2(const double* a,
+                                                const double* b, double* y,
+                                                std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 2 <= n; j += 2) {
+    __m128d prod = _mm_mul_pd(_mm_loadu_pd(a + j), _mm_loadu_pd(b + j));
+    _mm_storeu_pd(y + j, _mm_add_pd(_mm_loadu_pd(y + j), prod));
+  }
+  MulAddScalar(a + j, b + j, y + j, n - j);
+}
+
+__attribute__((target("sse2"))) void MulSubSse2(const double* a,
+                                                const double* b, double* y,
+                                                std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 2 <= n; j += 2) {
+    __m128d prod = _mm_mul_pd(_mm_loadu_pd(a + j), _mm_loadu_pd(b + j));
+    _mm_storeu_pd(y + j, _mm_sub_pd(_mm_loadu_pd(y + j), prod));
+  }
+  MulSubScalar(a + j, b + j, y + j, n - j);
+}
+
+__attribute__((target("sse2"))) void DivSse2(const double* a, const double* b,
+                                             double* out, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 2 <= n; j += 2) {
+    _mm_storeu_pd(out + j,
+                  _mm_div_pd(_mm_loadu_pd(a + j), _mm_loadu_pd(b + j)));
+  }
+  DivScalar(a + j, b + j, out + j, n - j);
+}
+
+__attribute__((target("avx2"))) void MulAddAvx2(const double* a,
+                                                const double* b, double* y,
+                                                std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    __m256d prod =
+        _mm256_mul_pd(_mm256_loadu_pd(a + j), _mm256_loadu_pd(b + j));
+    _mm256_storeu_pd(y + j, _mm256_add_pd(_mm256_loadu_pd(y + j), prod));
+  }
+  MulAddScalar(a + j, b + j, y + j, n - j);
+}
+
+__attribute__((target("avx2"))) void MulSubAvx2(const double* a,
+                                                const double* b, double* y,
+                                                std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    __m256d prod =
+        _mm256_mul_pd(_mm256_loadu_pd(a + j), _mm256_loadu_pd(b + j));
+    _mm256_storeu_pd(y + j, _mm256_sub_pd(_mm256_loadu_pd(y + j), prod));
+  }
+  MulSubScalar(a + j, b + j, y + j, n - j);
+}
+
+__attribute__((target("avx2"))) void DivAvx2(const double* a, const double* b,
+                                             double* out, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    _mm256_storeu_pd(out + j, _mm256_div_pd(_mm256_loadu_pd(a + j),
+                                            _mm256_loadu_pd(b + j)));
+  }
+  DivScalar(a + j, b + j, out + j, n - j);
+}
+
+__attribute__((target("avx512f"))) void MulAddAvx512(const double* a,
+                                                     const double* b, double* y,
+                                                     std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    __m512d prod =
+        _mm512_mul_pd(_mm512_loadu_pd(a + j), _mm512_loadu_pd(b + j));
+    _mm512_storeu_pd(y + j, _mm512_add_pd(_mm512_loadu_pd(y + j), prod));
+  }
+  MulAddScalar(a + j, b + j, y + j, n - j);
+}
+
+__attribute__((target("avx512f"))) void MulSubAvx512(const double* a,
+                                                     const double* b, double* y,
+                                                     std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    __m512d prod =
+        _mm512_mul_pd(_mm512_loadu_pd(a + j), _mm512_loadu_pd(b + j));
+    _mm512_storeu_pd(y + j, _mm512_sub_pd(_mm512_loadu_pd(y + j), prod));
+  }
+  MulSubScalar(a + j, b + j, y + j, n - j);
+}
+
+__attribute__((target("avx512f"))) void DivAvx512(const double* a,
+                                                  const double* b, double* out,
+                                                  std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    _mm512_storeu_pd(out + j, _mm512_div_pd(_mm512_loadu_pd(a + j),
+                                            _mm512_loadu_pd(b + j)));
+  }
+  DivScalar(a + j, b + j, out + j, n - j);
+}
+
+__attribute__((target("sse2"))) void Tile2x2Sse2(const double* a, int lda,
+                                                 double* b, int ldb) {
+  __m128d r0 = _mm_loadu_pd(a), r1 = _mm_loadu_pd(a + lda);
+  _mm_storeu_pd(b, _mm_unpacklo_pd(r0, r1));
+  _mm_storeu_pd(b + ldb, _mm_unpackhi_pd(r0, r1));
+}
+
+__attribute__((target("sse2"))) void TransposeSse2(int rows, int cols,
+                                                   const double* a, int lda,
+                                                   double* b, int ldb) {
+  TransposeTiled<2, double, Tile2x2Sse2>(rows, cols, a, lda, b, ldb);
+}
+
+__attribute__((target("avx2"))) void Tile4x4Avx2(const double* a, int lda,
+                                                 double* b, int ldb) {
+  __m256d r0 = _mm256_loadu_pd(a), r1 = _mm256_loadu_pd(a + lda);
+  __m256d r2 = _mm256_loadu_pd(a + 2 * lda), r3 = _mm256_loadu_pd(a + 3 * lda);
+  __m256d t0 = _mm256_unpacklo_pd(r0, r1), t1 = _mm256_unpackhi_pd(r0, r1);
+  __m256d t2 = _mm256_unpacklo_pd(r2, r3), t3 = _mm256_unpackhi_pd(r2, r3);
+  _mm256_storeu_pd(b, _mm256_permute2f128_pd(t0, t2, 0x20));
+  _mm256_storeu_pd(b + ldb, _mm256_permute2f128_pd(t1, t3, 0x20));
+  _mm256_storeu_pd(b + 2 * ldb, _mm256_permute2f128_pd(t0, t2, 0x31));
+  _mm256_storeu_pd(b + 3 * ldb, _mm256_permute2f128_pd(t1, t3, 0x31));
+}
+
+__attribute__((target("avx2"))) void TransposeAvx2(int rows, int cols,
+                                                   const double* a, int lda,
+                                                   double* b, int ldb) {
+  TransposeTiled<4, double, Tile4x4Avx2>(rows, cols, a, lda, b, ldb);
+}
+
+// 8x8 in three shuffle stages: pairs of rows are interleaved, then pairs of
+// 128-bit lanes, then halves, so output row c gathers element c of every
+// input row.
+__attribute__((target("avx512f"))) void Tile8x8Avx512(const double* a,
+                                                      int lda, double* b,
+                                                      int ldb) {
+  __m512d r[8], t[8], u[8];
+  for (int i = 0; i < 8; i++) r[i] = _mm512_loadu_pd(a + i * lda);
+  // Same as unpacklo/unpackhi, whose GCC 12 headers trip -Wuninitialized.
+  const __m512i lo = _mm512_set_epi64(14, 6, 12, 4, 10, 2, 8, 0);
+  const __m512i hi = _mm512_set_epi64(15, 7, 13, 5, 11, 3, 9, 1);
+  for (int i = 0; i < 8; i += 2) {
+    t[i] = _mm512_permutex2var_pd(r[i], lo, r[i + 1]);
+    t[i + 1] = _mm512_permutex2var_pd(r[i], hi, r[i + 1]);
+  }
+  const __m512i even = _mm512_set_epi64(13, 12, 5, 4, 9, 8, 1, 0);
+  const __m512i odd = _mm512_set_epi64(15, 14, 7, 6, 11, 10, 3, 2);
+  for (int h = 0; h < 8; h += 4) {
+    u[h] = _mm512_permutex2var_pd(t[h], even, t[h + 2]);
+    u[h + 1] = _mm512_permutex2var_pd(t[h], odd, t[h + 2]);
+    u[h + 2] = _mm512_permutex2var_pd(t[h + 1], even, t[h + 3]);
+    u[h + 3] = _mm512_permutex2var_pd(t[h + 1], odd, t[h + 3]);
+  }
+  // u[0..3] hold rows 0-3 of columns {0,4}, {2,6}, {1,5}, {3,7}; u[4..7]
+  // the same columns for rows 4-7.
+  const __m512i low = _mm512_set_epi64(11, 10, 9, 8, 3, 2, 1, 0);
+  const __m512i high = _mm512_set_epi64(15, 14, 13, 12, 7, 6, 5, 4);
+  const int column[4] = {0, 2, 1, 3};
+  for (int q = 0; q < 4; q++) {
+    _mm512_storeu_pd(b + column[q] * ldb,
+                     _mm512_permutex2var_pd(u[q], low, u[q + 4]));
+    _mm512_storeu_pd(b + (column[q] + 4) * ldb,
+                     _mm512_permutex2var_pd(u[q], high, u[q + 4]));
+  }
+}
+
+__attribute__((target("avx512f"))) void TransposeAvx512(int rows, int cols,
+                                                        const double* a,
+                                                        int lda, double* b,
+                                                        int ldb) {
+  TransposeTiled<8, double, Tile8x8Avx512>(rows, cols, a, lda, b, ldb);
+}
+
+// float variants: twice the lanes per register. Ramp stays scalar; the
+// transpose tiles are 4x4 (SSE) and 8x8 (AVX).
+
+__attribute__((target("sse2"))) void AddSse2(const float* a, const float* b,
+                                             float* out, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    _mm_storeu_ps(out + j,
+                  _mm_add_ps(_mm_loadu_ps(a + j), _mm_loadu_ps(b + j)));
+  }
+  AddScalar(a + j, b + j, out + j, n - j);
+}
+
+__attribute__((target("sse2"))) void SubSse2(const float* a, const float* b,
+                                             float* out, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    _mm_storeu_ps(out + j,
+                  _mm_sub_ps(_mm_loadu_ps(a + j), _mm_loadu_ps(b + j)));
+  }
+  SubScalar(a + j, b + j, out + j, n - j);
+}
+
+__attribute__((target("sse2"))) void ScaleSse2(const float* a, float num,
+                                               float* out, std::size_t n) {
+  const __m128 k = _mm_set1_ps(num);
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    _mm_storeu_ps(out + j, _mm_mul_ps(_mm_loadu_ps(a + j), k));
+  }
+  ScaleScalar(a + j, num, out + j, n - j);
+}
+
+__attribute__((target("sse2"))) void AxpySse2(float alpha, const float* x,
+                                              float* y, std::size_t n) {
+  const __m128 k = _mm_set1_ps(alpha);
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    __m128 prod = _mm_mul_ps(k, _mm_loadu_ps(x + j));
+    _mm_storeu_ps(y + j, _mm_add_ps(_mm_loadu_ps(y + j), prod));
+  }
+  AxpyScalar(alpha, x + j, y + j, n - j);
+}
+
+__attribute__((target("sse2"))) bool EqualSse2(const float* a, const float* b,
+                                               std::size_t n,
+                                               float tolerance) {
+  const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  const __m128 tol = _mm_set1_ps(tolerance);
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    __m128 diff = _mm_sub_ps(_mm_loadu_ps(a + j), _mm_loadu_ps(b + j));
+    if (_mm_movemask_ps(_mm_cmpgt_ps(_mm_and_ps(diff, abs_mask), tol)))
+      return false;
+  }
+  return EqualScalar(a + j, b + j, n - j, tolerance);
+}
+
+__attribute__((target("sse2"))) void FillSse2(float* out, std::size_t n,
+                                              float val) {
+  const __m128 v = _mm_set1_ps(val);
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) _mm_storeu_ps(out + j, v);
+  FillScalar(out + j, n - j, val);
+}
+
+__attribute__((target("sse2"))) void Tile4x4Sse2(const float* a, int lda,
+                                                 float* b, int ldb) {
+  __m128 r0 = _mm_loadu_ps(a), r1 = _mm_loadu_ps(a + lda);
+  __m128 r2 = _mm_loadu_ps(a + 2 * lda), r3 = _mm_loadu_ps(a + 3 * lda);
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+  _mm_storeu_ps(b, r0);
+  _mm_storeu_ps(b + ldb, r1);
+  _mm_storeu_ps(b + 2 * ldb, r2);
+  _mm_storeu_ps(b + 3 * ldb, r3);
+}
+
+__attribute__((target("sse2"))) void TransposeSse2(int rows, int cols,
+                                                   const float* a, int lda,
+                                                   float* b, int ldb) {
+  TransposeTiled<4, float, Tile4x4Sse2>(rows, cols, a, lda, b, ldb);
+}
+
+__attribute__((target("avx2"))) void AddAvx2(const float* a, const float* b,
+                                             float* out, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    _mm256_storeu_ps(out + j, _mm256_add_ps(_mm256_loadu_ps(a + j),
+                                            _mm256_loadu_ps(b + j)));
+  }
+  AddScalar(a + j, b + j, out + j, n - j);
+}
+
+__attribute__((target("avx2"))) void SubAvx2(const float* a, const float* b,
+                                             float* out, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    _mm256_storeu_ps(out + j, _mm256_sub_ps(_mm256_loadu_ps(a + j),
+                                            _mm256_loadu_ps(b + j)));
+  }
+  SubScalar(a + j, b + j, out + j, n - j);
+}
+
+__attribute__((target("avx2"))) void ScaleAvx2(const float* a, float num,
+                                               float* out, std::size_t n) {
+  const __m256 k = _mm256_set1_ps(num);
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    _mm256_storeu_ps(out + j, _mm256_mul_ps(_mm256_loadu_ps(a + j), k));
+  }
+  ScaleScalar(a + j, num, out + j, n - j);
+}
+
+__attribute__((target("avx2"))) void AxpyAvx2(float alpha, const float* x,
+                                              float* y, std::size_t n) {
+  const __m256 k = _mm256_set1_ps(alpha);
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    __m256 prod = _mm256_mul_ps(k, _mm256_loadu_ps(x + j));
+    _mm256_storeu_ps(y + j, _mm256_add_ps(_mm256_loadu_ps(y + j), prod));
+  }
+  AxpyScalar(alpha, x + j, y + j, n - j);
+}
+
+__attribute__((target("avx2"))) bool EqualAvx2(const float* a, const float* b,
+                                               std::size_t n,
+                                               float tolerance) {
+  const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+  const __m256 tol = _mm256_set1_ps(tolerance);
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    __m256 diff = _mm256_sub_ps(_mm256_loadu_ps(a + j), _mm256_loadu_ps(b + j));
+    __m256 gt = _mm256_cmp_ps(_mm256_and_ps(diff, abs_mask), tol, _CMP_GT_OQ);
+    if (_mm256_movemask_ps(gt)) return false;
+  }
+  return EqualScalar(a + j, b + j, n - j, tolerance);
+}
+
+__attribute__((target("avx2"))) void FillAvx2(float* out, std::size_t n,
+                                              float val) {
+  const __m256 v = _mm256_set1_ps(val);
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) _mm256_storeu_ps(out + j, v);
+  FillScalar(out + j, n - j, val);
+}
+
+// Pairs of rows are interleaved, then pairs of pairs, then 128-bit halves.
+__attribute__((target("avx2"))) void Tile8x8Avx2(const float* a, int lda,
+                                                 float* b, int ldb) {
+  __m256 r[8], t[8], u[8];
+  for (int i = 0; i < 8; i++) r[i] = _mm256_loadu_ps(a + i * lda);
+  for (int i = 0; i < 8; i += 2) {
+    t[i] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+    t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+  }
+  for (int h = 0; h < 8; h += 4) {
+    u[h] = _mm256_shuffle_ps(t[h], t[h + 2], _MM_SHUFFLE(1, 0, 1, 0));
+    u[h + 1] = _mm256_shuffle_ps(t[h], t[h + 2], _MM_SHUFFLE(3, 2, 3, 2));
+    u[h + 2] = _mm256_shuffle_ps(t[h + 1], t[h + 3], _MM_SHUFFLE(1, 0, 1, 0));
+    u[h + 3] = _mm256_shuffle_ps(t[h + 1], t[h + 3], _MM_SHUFFLE(3, 2, 3, 2));
+  }
+  for (int q = 0; q < 4; q++) {
+    _mm256_storeu_ps(b + q * ldb, _mm256_permute2f128_ps(u[q], u[q + 4], 0x20));
+    _mm256_storeu_ps(b + (q + 4) * ldb,
+                     _mm256_permute2f128_ps(u[q], u[q + 4], 0x31));
+  }
+}
+
+__attribute__((target("avx2"))) void TransposeAvx2(int rows, int cols,
+                                                   const float* a, int lda,
+                                                   float* b, int ldb) {
+  TransposeTiled<8, float, Tile8x8Avx2>(rows, cols, a, lda, b, ldb);
+}
+
+__attribute__((target("avx512f"))) void AddAvx512(const float* a,
+                                                  const float* b, float* out,
+                                                  std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 16 <= n; j += 16) {
+    _mm512_storeu_ps(out + j, _mm512_add_ps(_mm512_loadu_ps(a + j),
+                                            _mm512_loadu_ps(b + j)));
+  }
+  AddScalar(a + j, b + j, out + j, n - j);
+}
+
+__attribute__((target("avx512f"))) void SubAvx512(const float* a,
+                                                  const float* b, float* out,
+                                                  std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 16 <= n; j += 16) {
+    _mm512_storeu_ps(out + j, _mm512_sub_ps(_mm512_loadu_ps(a + j),
+                                            _mm512_loadu_ps(b + j)));
+  }
+  SubScalar(a + j, b + j, out + j, n - j);
+}
+
+__attribute__((target("avx512f"))) void ScaleAvx512(const float* a, float num,
+                                                    float* out,
+                                                    std::size_t n) {
+  const __m512 k = _mm512_set1_ps(num);
+  std::size_t j = 0;
+  for (; j + 16 <= n; j += 16) {
+    _mm512_storeu_ps(out + j, _mm512_mul_ps(_mm512_loadu_ps(a + j), k));
+  }
+  ScaleScalar(a + j, num, out + j, n - j);
+}
+
+__attribute__((target("avx512f"))) void AxpyAvx512(float alpha,
+                                                   const float* x, float* y,
+                                                   std::size_t n) {
+  const __m512 k = _mm512_set1_ps(alpha);
+  std::size_t j = 0;
+  for (; j + 16 <= n; j += 16) {
+    __m512 prod = _mm512_mul_ps(k, _mm512_loadu_ps(x + j));
+    _mm512_storeu_ps(y + j, _mm512_add_ps(_mm512_loadu_ps(y + j), prod));
+  }
+  AxpyScalar(alpha, x + j, y + j, n - j);
+}
+
+__attribute__((target("avx512f"))) bool EqualAvx512(const float* a,
+                                                    const float* b,
+                                                    std::size_t n,
+                                                    float tolerance) {
+  const __m512 tol = _mm512_set1_ps(tolerance);
+  std::size_t j = 0;
+  for (; j + 16 <= n; j += 16) {
+    __m512 diff = _mm512_sub_ps(_mm512_loadu_ps(a + j), _mm512_loadu_ps(b + j));
+    if (_mm512_cmp_ps_mask(_mm512_abs_ps(diff), tol, _CMP_GT_OQ)) return false;
+  }
+  return EqualScalar(a + j, b + j, n - j, tolerance);
+}
+
+__attribute__((target("avx512f"))) void FillAvx512(float* out, std::size_t n,
+                                                   float val) {
+  const __m512 v = _mm512_set1_ps(val);
+  std::size_t j = 0;
+  for (; j + 16 <= n; j += 16) _mm512_storeu_ps(out + j, v);
+  FillScalar(out + j, n - j, val);
+}
+
+__attribute__((target("sse2"))) float DotSse2(const float* a, const float* b,
+                                              std::size_t n) {
+  const __m128 zero = _mm_setzero_ps();
+  __m128 acc[8] = {zero, zero, zero, zero, zero, zero, zero, zero};
+  std::size_t j = 0;
+  for (; j + 32 <= n; j += 32) {
+#pragma GCC unroll 8
+    for (int q = 0; q < 8; q++) {
+      __m128 prod = _mm_mul_ps(_mm_loadu_ps(a + j + 4 * q),
+                               _mm_loadu_ps(b + j + 4 * q));
+      acc[q] = _mm_add_ps(acc[q], prod);
+    }
+  }
+  float sum[32];
+  for (int q = 0; q < 8; q++) _mm_storeu_ps(sum + 4 * q, acc[q]);
+  return DotFinish(sum, a + j, b + j, n - j);
+}
+
+__attribute__((target("avx2"))) float DotAvx2(const float* a, const float* b,
+                                              std::size_t n) {
+  const __m256 zero = _mm256_setzero_ps();
+  __m256 acc[4] = {zero, zero, zero, zero};
+  std::size_t j = 0;
+  for (; j + 32 <= n; j += 32) {
+#pragma GCC unroll 4
+    for (int q = 0; q < 4; q++) {
+      __m256 prod = _mm256_mul_ps(_mm256_loadu_ps(a + j + 8 * q),
+                                  _mm256_loadu_ps(b + j + 8 * q));
+      acc[q] = _mm256_add_ps(acc[q], prod);
+    }
+  }
+  float sum[32];
+  for (int q = 0; q < 4; q++) _mm256_storeu_ps(sum + 8 * q, acc[q]);
+  return DotFinish(sum, a + j, b + j, n - j);
+}
+
+__attribute__((target("avx512f"))) float DotAvx512(const float* a,
+                                                   const float* b,
+                                                   std::size_t n) {
+  __m512 acc[2] = {_mm512_setzero_ps(), _mm512_setzero_ps()};
+  std::size_t j = 0;
+  for (; j + 32 <= n; j += 32) {
+#pragma GCC unroll 2
+    for (int q = 0; q < 2; q++) {
+      __m512 prod = _mm512_mul_ps(_mm512_loadu_ps(a + j + 16 * q),
+                                  _mm512_loadu_ps(b + j + 16 * q));
+      acc[q] = _mm512_add_ps(acc[q], prod);
+    }
+  }
+  float sum[32];
+  for (int q = 0; q < 2; q++) _mm512_storeu_ps(sum + 16 * q, acc[q]);
+  return DotFinish(sum, a + j, b + j, n - j);
+}
+
+__attribute__((target("sse2"))) void MulAddSse2(const float* a, const float* b,
+                                                float* y, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    __m128 prod = _mm_mul_ps(_mm_loadu_ps(a + j), _mm_loadu_ps(b + j));
+    _mm_storeu_ps(y + j, _mm_add_ps(_mm_loadu_ps(y + j), prod));
+  }
+  MulAddScalar(a + j, b + j, y + j, n - j);
+}
+
+__attribute__((target("sse2"))) void MulSubSse2(const float* a, const float* b,
+                                                float* y, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    __m128 prod = _mm_mul_ps(_mm_loadu_ps(a + j), _mm_loadu_ps(b + j));
+    _mm_storeu_ps(y + j, _mm_sub_ps(_mm_loadu_ps(y + j), prod));
+  }
+  MulSubScalar(a + j, b + j, y + j, n - j);
+}
+
+__attribute__((target("sse2"))) void DivSse2(const float* a, const float* b,
+                                             float* out, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    _mm_storeu_ps(out + j,
+                  _mm_div_ps(_mm_loadu_ps(a + j), _mm_loadu_ps(b + j)));
+  }
+  DivScalar(a + j, b + j, out + j, n - j);
+}
+
+__attribute__((target("avx2"))) void MulAddAvx2(const float* a, const float* b,
+                                                float* y, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    __m256 prod = _mm256_mul_ps(_mm256_loadu_ps(a + j), _mm256_loadu_ps(b + j));
+    _mm256_storeu_ps(y + j, _mm256_add_ps(_mm256_loadu_ps(y + j), prod));
+  }
+  MulAddScalar(a + j, b + j, y + j, n - j);
+}
+
+__attribute__((target("avx2"))) void MulSubAvx2(const float* a, const float* b,
+                                                float* y, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    __m256 prod = _mm256_mul_ps(_mm256_loadu_ps(a + j), _mm256_loadu_ps(b + j));
+    _mm256_storeu_ps(y + j, _mm256_sub_ps(_mm256_loadu_ps(y + j), prod));
+  }
+  MulSubScalar(a + j, b + j, y + j, n - j);
+}
+
+__attribute__((target("avx2"))) void DivAvx2(const float* a, const float* b,
+                                             float* out, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    _mm256_storeu_ps(out + j, _mm256_div_ps(_mm256_loadu_ps(a + j),
+                                            _mm256_loadu_ps(b + j)));
+  }
+  DivScalar(a + j, b + j, out + j, n - j);
+}
+
+__attribute__((target("avx512f"))) void MulAddAvx512(const float* a,
+                                                     const float* b, float* y,
+                                                     std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 16 <= n; j += 16) {
+    __m512 prod = _mm512_mul_ps(_mm512_loadu_ps(a + j), _mm512_loadu_ps(b + j));
+    _mm512_storeu_ps(y + j, _mm512_add_ps(_mm512_loadu_ps(y + j), prod));
+  }
+  MulAddScalar(a + j, b + j, y + j, n - j);
+}
+
+__attribute__((target("avx512f"))) void MulSubAvx512(const float* a,
+                                                     const float* b, float* y,
+                                                     std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 16 <= n; j += 16) {
+    __m512 prod = _mm512_mul_ps(_mm512_loadu_ps(a + j), _mm512_loadu_ps(b + j));
+    _mm512_storeu_ps(y + j, _mm512_sub_ps(_mm512_loadu_ps(y + j), prod));
+  }
+  MulSubScalar(a + j, b + j, y + j, n - j);
+}
+
+__attribute__((target("avx512f"))) void DivAvx512(const float* a,
+                                                  const float* b, float* out,
+                                                  std::size_t n) {
+  std::size_t j = 0;
+  for (; j + 16 <= n; j += 16) {
+    _mm512_storeu_ps(out + j, _mm512_div_ps(_mm512_loadu_ps(a + j),
+                                            _mm512_loadu_ps(b + j)));
+  }
+  DivScalar(a + j, b + j, out + j, n - j);
+}
+
+#endif  // S21_SIMD_X86
+
+template <class T>
+const BasicSimdKernels<T> kScalarKernels = {
+    SimdLevel::kScalar, AddScalar<T>,    SubScalar<T>,    ScaleScalar<T>,
+    AxpyScalar<T>,      DotScalar<T>,    MulAddScalar<T>, MulSubScalar<T>,
+    DivScalar<T>,       EqualScalar<T>,  FillScalar<T>,   RampScalar<T>,
+    TransposeScalar<T>};
+
+#ifdef S21_SIMD_X86
+const SimdKernels kSse2Kernels = {
+    SimdLevel::kSse2, AddSse2,    SubSse2,    ScaleSse2, AxpySse2,
+    DotSse2,          MulAddSse2, MulSubSse2, DivSse2,   EqualSse2,
+    FillSse2,         RampSse2,   TransposeSse2};
+const SimdKernels kAvx2Kernels = {
+    SimdLevel::kAvx2, AddAvx2,    SubAvx2,    ScaleAvx2, AxpyAvx2,
+    DotAvx2,          MulAddAvx2, MulSubAvx2, DivAvx2,   EqualAvx2,
+    FillAvx2,         RampAvx2,   TransposeAvx2};
+const SimdKernels kAvx512Kernels = {
+    SimdLevel::kAvx512, AddAvx512,    SubAvx512,    ScaleAvx512, AxpyAvx512,
+    DotAvx512,          MulAddAvx512, MulSubAvx512, DivAvx512,   EqualAvx512,
+    FillAvx512,         RampAvx512,   TransposeAvx512};
+
+const BasicSimdKernels<float> kSse2FloatKernels = {
+    SimdLevel::kSse2, AddSse2,    SubSse2,           ScaleSse2, AxpySse2,
+    DotSse2,          MulAddSse2, MulSubSse2,        DivSse2,   EqualSse2,
+    FillSse2,         RampScalar<float>, TransposeSse2};
+const BasicSimdKernels<float> kAvx2FloatKernels = {
+    SimdLevel::kAvx2, AddAvx2,    SubAvx2,           ScaleAvx2, AxpyAvx2,
+    DotAvx2,          MulAddAvx2, MulSubAvx2,        DivAvx2,   EqualAvx2,
+    FillAvx2,         RampScalar<float>, TransposeAvx2};
+// The AVX tile is the widest float transpose; 16x16 tiles would not fit
+// in the register file together with their shuffles.
+const BasicSimdKernels<float> kAvx512FloatKernels = {
+    SimdLevel::kAvx512, AddAvx512,    SubAvx512,         ScaleAvx512,
+    AxpyAvx512,         DotAvx512,    MulAddAvx512,      MulSubAvx512,
+    DivAvx512,          EqualAvx512,  FillAvx512,        RampScalar<float>,
+    TransposeAvx2};
+#endif
+
+// The tables compiled in for T, whether or not the CPU can run them.
+template <class T>
+const BasicSimdKernels<T>* BuiltKernels(SimdLevel level) noexcept {
+  return level == SimdLevel::kScalar ? &kScalarKernels<T> : nullptr;
+}
+
+#ifdef S21_SIMD_X86
+template <>
+const SimdKernels* BuiltKernels<double>(SimdLevel level) noexcept {
+  const SimdKernels* kernels[] = {&kScalarKernels<double>, &kSse2Kernels,
+                                  &kAvx2Kernels, &kAvx512Kernels};
+  return kernels[static_cast<int>(level)];
+}
+
+template <>
+const BasicSimdKernels<float>* BuiltKernels<float>(SimdLevel level) noexcept {
+  const BasicSimdKernels<float>* kernels[] = {
+      &kScalarKernels<float>, &kSse2FloatKernels, &kAvx2FloatKernels,
+      &kAvx512FloatKernels};
+  return kernels[static_cast<int>(level)];
+}
+#endif
+
+bool CpuSupports(SimdLevel level) noexcept {
+  switch (level) {
+    case SimdLevel::kScalar:
+      return true;
+#ifdef S21_SIMD_X86
+    case SimdLevel::kSse2:
+      return __builtin_cpu_supports("sse2");
+    case SimdLevel::kAvx2:
+      return __builtin_cpu_supports("avx2");
+    case SimdLevel::kAvx512:
+      return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+      return false;
+  }
+}
+
+template <class T>
+const BasicSimdKernels<T>& SelectKernels() noexcept {
+  const BasicSimdKernels<T>* best = &kScalarKernels<T>;
+  for (SimdLevel level : {SimdLevel::kSse2, SimdLevel::kAvx2,
+                          SimdLevel::kAvx512}) {
+    if (const BasicSimdKernels<T>* kernels = SimdKernelsFor<T>(level))
+      best = kernels;
+  }
+  return *best;
+}
+
+}  // namespace
+
+template <class T>
+const BasicSimdKernels<T>& Simd() noexcept {
+  static const BasicSimdKernels<T>& kernels = SelectKernels<T>();
+  return kernels;
+}
+
+template <class T>
+const BasicSimdKernels<T>* SimdKernelsFor(SimdLevel level) noexcept {
+  return CpuSupports(level) ? BuiltKernels<T>(level) : nullptr;
+}
+
+template const BasicSimdKernels<float>& Simd<float>() noexcept;
+template const BasicSimdKernels<double>& Simd<double>() noexcept;
+template const BasicSimdKernels<long double>& Simd<long double>() noexcept;
+template const BasicSimdKernels<float>* SimdKernelsFor<float>(
+    SimdLevel level) noexcept;
+template const BasicSimdKernels<double>* SimdKernelsFor<double>(
+    SimdLevel level) noexcept;
+template const BasicSimdKernels<long double>* SimdKernelsFor<long double>(
+    SimdLevel level) noexcept;
+
+}  // namespace s21
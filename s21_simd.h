@@ -0,0 +1,74 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_SIMD_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_SIMD_H
+
+#include <cstddef>
+
+namespace s21 {
+
+enum class SimdLevel { kScalar, kSse2, kAvx2, kAvx512 };
+
+// Partial sums of the dot kernel: two AVX-512 registers of float or
+// double, so that consecutive additions do not wait for each other.
+template <class T>
+constexpr std::size_t kDotLanes = sizeof(T) == 4 ? 32 : 16;
+
+// Kernels over n contiguous elements of type T. Every variant produces
+// results bit-identical to the scalar one: there is no fused multiply-add,
+// and the one reduction (dot) fixes its order.
+template <class T>
+struct BasicSimdKernels {
+  SimdLevel level;
+  // out = a + b, out = a - b; out may alias a or b.
+  void (*add)(const T* a, const T* b, T* out, std::size_t n);
+  void (*sub)(const T* a, const T* b, T* out, std::size_t n);
+  // out = a * num; out may alias a.
+  void (*scale)(const T* a, T num, T* out, std::size_t n);
+  // y = y + alpha * x.
+  void (*axpy)(T alpha, const T* x, T* y, std::size_t n);
+  // Sum of a[j] * b[j]. The products go to kDotLanes<T> interleaved
+  // partial sums that are added pairwise at the end; every level keeps that
+  // order, so the result does not depend on the level either.
+  T (*dot)(const T* a, const T* b, std::size_t n);
+  // y = y + a * b and y = y - a * b element by element.
+  void (*mul_add)(const T* a, const T* b, T* y, std::size_t n);
+  void (*mul_sub)(const T* a, const T* b, T* y, std::size_t n);
+  // out = a / b; out may alias a or b.
+  void (*div)(const T* a, const T* b, T* out, std::size_t n);
+  // True when no |a - b| is greater than tolerance.
+  bool (*equal)(const T* a, const T* b, std::size_t n, T tolerance);
+  // out[j] = val.
+  void (*fill)(T* out, std::size_t n, T val);
+  // out[j] = (offset + j) + val.
+  void (*ramp)(T* out, std::size_t n, int offset, T val);
+  // b = a^T for a rows x cols block with row strides lda and ldb; meant for
+  // tiles that fit in L1. Full register tiles are transposed with shuffles.
+  void (*transpose)(int rows, int cols, const T* a, int lda, T* b, int ldb);
+};
+
+using SimdKernels = BasicSimdKernels<double>;
+
+// Kernels for the widest instruction set the CPU supports, picked once on
+// first use. float and double have vector kernels for every level; long
+// double only has the scalar ones.
+template <class T = double>
+const BasicSimdKernels<T>& Simd() noexcept;
+
+// Kernels for a specific level, or nullptr when the build or the CPU does
+// not support it.
+template <class T = double>
+const BasicSimdKernels<T>* SimdKernelsFor(SimdLevel level) noexcept;
+
+extern template const BasicSimdKernels<float>& Simd<float>() noexcept;
+extern template const BasicSimdKernels<double>& Simd<double>() noexcept;
+extern template const BasicSimdKernels<long double>&
+Simd<long double>() noexcept;
+extern template const BasicSimdKernels<float>* SimdKernelsFor<float>(
+    SimdLevel level) noexcept;
+extern template const BasicSimdKernels<double>* SimdKernelsFor<double>(
+    SimdLevel level) noexcept;
+extern template const BasicSimdKernels<long double>*
+SimdKernelsFor<long double>(SimdLevel level) noexcept;
+
+}  // namespace s21
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_SIMD_H
@@ -0,0 +1,386 @@
+#include "s21_sparse_matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+template <class T>
+T* RowOf(S21BasicMatrix<T>& matrix, int i) {
+  return matrix.data() + static_cast<std::size_t>(i) * matrix.stride();
+}
+
+template <class T>
+const T* RowOf(const S21BasicMatrix<T>& matrix, int i) {
+  return matrix.data() + static_cast<std::size_t>(i) * matrix.stride();
+}
+
+}  // namespace
+
+template <class T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(int rows, int cols,
+                                              S21SparseFormat format)
+    : rows_(rows),
+      cols_(cols),
+      format_(format),
+      offsets_(S21BasicMatrix<T>::GetDefaultResource()),
+      indices_(S21BasicMatrix<T>::GetDefaultResource()),
+      values_(S21BasicMatrix<T>::GetDefaultResource()) {
+  if (rows < 1 || cols < 1) throw std::out_of_range("Invalid matrix");
+  offsets_.assign(_Major() + 1, 0);
+}
+
+// Counts the kept elements of every row first, so the arrays are allocated
+// once at their final size and the rows can be filled in parallel.
+template <class T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(const S21BasicMatrix<T>& dense,
+                                              T threshold,
+                                              S21SparseFormat format)
+    : S21BasicSparseMatrix(dense.GetRows(), dense.GetCols()) {
+  if (dense.data() == nullptr) throw std::out_of_range("Invalid matrix");
+  const std::ptrdiff_t grain = s21::ParallelGrain(cols_);
+  s21::ParallelFor(rows_, grain, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (int i = begin; i < end; i++) {
+      const T* row = RowOf(dense, i);
+      std::size_t kept = 0;
+      for (int j = 0; j < cols_; j++) kept += !(std::abs(row[j]) <= threshold);
+      offsets_[i + 1] = kept;
+    }
+  });
+  for (int i = 0; i < rows_; i++) offsets_[i + 1] += offsets_[i];
+  indices_.resize(offsets_[rows_]);
+  values_.resize(offsets_[rows_]);
+  s21::ParallelFor(rows_, grain, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (int i = begin; i < end; i++) {
+      const T* row = RowOf(dense, i);
+      std::size_t k = offsets_[i];
+      for (int j = 0; j < cols_; j++) {
+        if (!(std::abs(row[j]) <= threshold)) {
+          indices_[k] = j;
+          values_[k++] = row[j];
+        }
+      }
+    }
+  });
+  if (format == S21SparseFormat::kCsc) *this = ToFormat(format);
+}
+
+// Bucketed by major index with a counting sort, then every line is sorted
+// by minor index and its duplicates merged in place.
+template <class T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    int rows, int cols, const std::vector<Triplet>& triplets,
+    S21SparseFormat format)
+    : S21BasicSparseMatrix(rows, cols, format) {
+  const bool csr = format_ == S21SparseFormat::kCsr;
+  for (const Triplet& t : triplets) {
+    if (t.row < 0 || t.row >= rows_ || t.col < 0 || t.col >= cols_)
+      throw std::out_of_range("Invalid index");
+    offsets_[(csr ? t.row : t.col) + 1]++;
+  }
+  for (int m = 0; m < _Major(); m++) offsets_[m + 1] += offsets_[m];
+  std::vector<std::pair<int, T>> entries(triplets.size());
+  std::vector<std::size_t> next(offsets_.begin(), offsets_.end() - 1);
+  for (const Triplet& t : triplets) {
+    entries[next[csr ? t.row : t.col]++] = {csr ? t.col : t.row, t.value};
+  }
+  indices_.resize(entries.size());
+  values_.resize(entries.size());
+  std::size_t out = 0;
+  for (int m = 0; m < _Major(); m++) {
+    auto first = entries.begin() + offsets_[m];
+    auto last = entries.begin() + offsets_[m + 1];
+    std::stable_sort(first, last, [](const auto& a, const auto& b) {
+      return a.first < b.first;
+    });
+    offsets_[m] = out;
+    for (auto it = first; it != last; ++it) {
+      if (out > offsets_[m] && indices_[out - 1] == it->first) {
+        values_[out - 1] += it->second;
+      } else {
+        indices_[out] = it->first;
+        values_[out++] = it->second;
+      }
+    }
+  }
+  offsets_[_Major()] = out;
+  indices_.resize(out);
+  values_.resize(out);
+}
+
+template <class T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    const S21BasicSparseMatrix& other)
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      format_(other.format_),
+      offsets_(other.offsets_, S21BasicMatrix<T>::GetDefaultResource()),
+      indices_(other.indices_, S21BasicMatrix<T>::GetDefaultResource()),
+      values_(other.values_, S21BasicMatrix<T>::GetDefaultResource()) {}
+
+template <class T>
+int S21BasicSparseMatrix<T>::GetRows() const noexcept {
+  return rows_;
+}
+
+template <class T>
+int S21BasicSparseMatrix<T>::GetCols() const noexcept {
+  return cols_;
+}
+
+template <class T>
+S21SparseFormat S21BasicSparseMatrix<T>::GetFormat() const noexcept {
+  return format_;
+}
+
+template <class T>
+std::size_t S21BasicSparseMatrix<T>::NonZeros() const noexcept {
+  return values_.size();
+}
+
+template <class T>
+const std::pmr::vector<std::size_t>& S21BasicSparseMatrix<T>::Offsets()
+    const noexcept {
+  return offsets_;
+}
+
+template <class T>
+const std::pmr::vector<int>& S21BasicSparseMatrix<T>::Indices()
+    const noexcept {
+  return indices_;
+}
+
+template <class T>
+const std::pmr::vector<T>& S21BasicSparseMatrix<T>::Values() const noexcept {
+  return values_;
+}
+
+template <class T>
+T S21BasicSparseMatrix<T>::operator()(int i, int j) const {
+  if (i < 0 || i >= rows_ || j < 0 || j >= cols_)
+    throw std::out_of_range("Invalid index");
+  const bool csr = format_ == S21SparseFormat::kCsr;
+  const int major = csr ? i : j, minor = csr ? j : i;
+  auto first = indices_.begin() + offsets_[major];
+  auto last = indices_.begin() + offsets_[major + 1];
+  auto it = std::lower_bound(first, last, minor);
+  return it != last && *it == minor ? values_[it - indices_.begin()] : T(0);
+}
+
+// Walking the lines in order appends to every target line in increasing
+// old-major order, so the result comes out sorted.
+template <class T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::ToFormat(
+    S21SparseFormat format) const {
+  if (format == format_) return *this;
+  S21BasicSparseMatrix result(rows_, cols_, format);
+  for (int index : indices_) result.offsets_[index + 1]++;
+  for (int m = 0; m < result._Major(); m++)
+    result.offsets_[m + 1] += result.offsets_[m];
+  result.indices_.resize(NonZeros());
+  result.values_.resize(NonZeros());
+  std::vector<std::size_t> next(result.offsets_.begin(),
+                                result.offsets_.end() - 1);
+  for (int m = 0; m < _Major(); m++) {
+    for (std::size_t k = offsets_[m]; k < offsets_[m + 1]; k++) {
+      std::size_t out = next[indices_[k]]++;
+      result.indices_[out] = m;
+      result.values_[out] = values_[k];
+    }
+  }
+  return result;
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::ToDense() const {
+  S21BasicMatrix<T> result(rows_, cols_);
+  const bool csr = format_ == S21SparseFormat::kCsr;
+  for (int m = 0; m < _Major(); m++) {
+    for (std::size_t k = offsets_[m]; k < offsets_[m + 1]; k++) {
+      if (csr)
+        RowOf(result, m)[indices_[k]] = values_[k];
+      else
+        RowOf(result, indices_[k])[m] = values_[k];
+    }
+  }
+  return result;
+}
+
+template <class T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Transpose() const {
+  S21BasicSparseMatrix result(cols_, rows_,
+                              format_ == S21SparseFormat::kCsr
+                                  ? S21SparseFormat::kCsc
+                                  : S21SparseFormat::kCsr);
+  result.offsets_ = offsets_;
+  result.indices_ = indices_;
+  result.values_ = values_;
+  return result;
+}
+
+// Missing entries count as zeros on either side.
+template <class T>
+bool S21BasicSparseMatrix<T>::EqMatrix(
+    const S21BasicSparseMatrix& other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) return false;
+  const S21BasicSparseMatrix& b =
+      other.format_ == format_ ? other : other.ToFormat(format_);
+  const T tolerance = S21Tolerance<T>::kEqual;
+  for (int m = 0; m < _Major(); m++) {
+    std::size_t ka = offsets_[m], kb = b.offsets_[m];
+    while (ka < offsets_[m + 1] || kb < b.offsets_[m + 1]) {
+      int ia = ka < offsets_[m + 1] ? indices_[ka] : _Minor();
+      int ib = kb < b.offsets_[m + 1] ? b.indices_[kb] : _Minor();
+      T va = ia <= ib ? values_[ka++] : T(0);
+      T vb = ib <= ia ? b.values_[kb++] : T(0);
+      if (std::abs(va - vb) > tolerance) return false;
+    }
+  }
+  return true;
+}
+
+template <class T>
+void S21BasicSparseMatrix<T>::SumMatrix(const S21BasicSparseMatrix& other) {
+  _SumAndSubMatrix('+', other);
+}
+
+template <class T>
+void S21BasicSparseMatrix<T>::SubMatrix(const S21BasicSparseMatrix& other) {
+  _SumAndSubMatrix('-', other);
+}
+
+// Line-by-line merge of the two sorted index lists; entries that cancel
+// exactly are not stored.
+template <class T>
+void S21BasicSparseMatrix<T>::_SumAndSubMatrix(
+    char plus_or_minus, const S21BasicSparseMatrix& other) {
+  if (rows_ != other.rows_ || cols_ != other.cols_)
+    throw std::invalid_argument("Sizes are not equal");
+  const S21BasicSparseMatrix& b =
+      other.format_ == format_ ? other : other.ToFormat(format_);
+  const T sign = plus_or_minus == '+' ? T(1) : T(-1);
+  S21BasicSparseMatrix result(rows_, cols_, format_);
+  result.indices_.reserve(NonZeros() + b.NonZeros());
+  result.values_.reserve(NonZeros() + b.NonZeros());
+  for (int m = 0; m < _Major(); m++) {
+    std::size_t ka = offsets_[m], kb = b.offsets_[m];
+    while (ka < offsets_[m + 1] || kb < b.offsets_[m + 1]) {
+      int ia = ka < offsets_[m + 1] ? indices_[ka] : _Minor();
+      int ib = kb < b.offsets_[m + 1] ? b.indices_[kb] : _Minor();
+      int index = std::min(ia, ib);
+      T value = ia <= ib ? values_[ka++] : T(0);
+      if (ib <= ia) value += sign * b.values_[kb++];
+      if (value != T(0)) {
+        result.indices_.push_back(index);
+        result.values_.push_back(value);
+      }
+    }
+    result.offsets_[m + 1] = result.values_.size();
+  }
+  result.indices_.shrink_to_fit();
+  result.values_.shrink_to_fit();
+  *this = std::move(result);
+}
+
+template <class T>
+void S21BasicSparseMatrix<T>::MulVector(const T* x, T* y) const {
+  if (format_ == S21SparseFormat::kCsc) {
+    std::fill(y, y + rows_, T(0));
+    for (int j = 0; j < cols_; j++) {
+      for (std::size_t k = offsets_[j]; k < offsets_[j + 1]; k++) {
+        y[indices_[k]] += values_[k] * x[j];
+      }
+    }
+    return;
+  }
+  const std::ptrdiff_t per_row = std::max<std::ptrdiff_t>(
+      1, static_cast<std::ptrdiff_t>(NonZeros() / rows_));
+  s21::ParallelFor(rows_, s21::ParallelGrain(per_row),
+                   [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                     for (int i = begin; i < end; i++) {
+                       T sum = 0;
+                       for (std::size_t k = offsets_[i]; k < offsets_[i + 1];
+                            k++) {
+                         sum += values_[k] * x[indices_[k]];
+                       }
+                       y[i] = sum;
+                     }
+                   });
+}
+
+// Row i of the result only depends on row i of A, so CSR rows go to
+// different threads; a CSC matrix is converted first.
+template <class T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::MulMatrix(
+    const S21BasicMatrix<T>& dense) const {
+  if (dense.data() == nullptr) throw std::out_of_range("Invalid matrix");
+  if (cols_ != dense.GetRows())
+    throw std::invalid_argument(
+        "Columns first matrix not equal rows second matrix");
+  if (format_ == S21SparseFormat::kCsc)
+    return ToFormat(S21SparseFormat::kCsr).MulMatrix(dense);
+  const int n = dense.GetCols();
+  S21BasicMatrix<T> result(rows_, n);
+  const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+  const std::ptrdiff_t per_row = std::max<std::ptrdiff_t>(
+      1, static_cast<std::ptrdiff_t>(NonZeros() / rows_));
+  s21::ParallelFor(rows_, s21::ParallelGrain(per_row * n),
+                   [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                     for (int i = begin; i < end; i++) {
+                       T* out = RowOf(result, i);
+                       for (std::size_t k = offsets_[i]; k < offsets_[i + 1];
+                            k++) {
+                         simd.axpy(values_[k], RowOf(dense, indices_[k]), out,
+                                   n);
+                       }
+                     }
+                   });
+  return result;
+}
+
+template <class T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator+(
+    const S21BasicSparseMatrix& other) const {
+  S21BasicSparseMatrix result(*this);
+  result.SumMatrix(other);
+  return result;
+}
+
+template <class T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator-(
+    const S21BasicSparseMatrix& other) const {
+  S21BasicSparseMatrix result(*this);
+  result.SubMatrix(other);
+  return result;
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::operator*(
+    const S21BasicMatrix<T>& dense) const {
+  return MulMatrix(dense);
+}
+
+template <class T>
+bool S21BasicSparseMatrix<T>::operator==(
+    const S21BasicSparseMatrix& other) const {
+  return EqMatrix(other);
+}
+
+template <class T>
+int S21BasicSparseMatrix<T>::_Major() const noexcept {
+  return format_ == S21SparseFormat::kCsr ? rows_ : cols_;
+}
+
+template <class T>
+int S21BasicSparseMatrix<T>::_Minor() const noexcept {
+  return format_ == S21SparseFormat::kCsr ? cols_ : rows_;
+}
+
+template class S21BasicSparseMatrix<float>;
+template class S21BasicSparseMatrix<double>;
+template class S21BasicSparseMatrix<long double>;
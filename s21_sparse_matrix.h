@@ -0,0 +1,101 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_SPARSE_MATRIX_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_SPARSE_MATRIX_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "s21_matrix.h"
+
+enum class S21SparseFormat {
+  kCsr,  // compressed rows: Offsets() has rows + 1 entries
+  kCsc,  // compressed columns: Offsets() has cols + 1 entries
+};
+
+// Non-zero (row, col, value) in coordinate (COO) form.
+template <class T>
+struct S21BasicTriplet {
+  int row;
+  int col;
+  T value;
+};
+
+// Compressed sparse matrix. The stored entries of major line m (a row in CSR,
+// a column in CSC) are Indices()[k] / Values()[k] for k in
+// [Offsets()[m], Offsets()[m + 1]), sorted by minor index without
+// duplicates. Memory is proportional to the number of stored entries.
+template <class T>
+class S21BasicSparseMatrix {
+ public:
+  using Triplet = S21BasicTriplet<T>;
+
+  // All-zero rows x cols matrix.
+  S21BasicSparseMatrix(int rows, int cols,
+                       S21SparseFormat format = S21SparseFormat::kCsr);
+  // Keeps the elements of dense with |a(i, j)| > threshold, and NaNs.
+  explicit S21BasicSparseMatrix(const S21BasicMatrix<T>& dense,
+                                T threshold = 0,
+                                S21SparseFormat format = S21SparseFormat::kCsr);
+  // Triplets in any order; duplicates are summed.
+  S21BasicSparseMatrix(int rows, int cols, const std::vector<Triplet>& triplets,
+                       S21SparseFormat format = S21SparseFormat::kCsr);
+  S21BasicSparseMatrix(const S21BasicSparseMatrix& other);
+  S21BasicSparseMatrix(S21BasicSparseMatrix&& other) noexcept = default;
+  S21BasicSparseMatrix& operator=(const S21BasicSparseMatrix& other) = default;
+  S21BasicSparseMatrix& operator=(S21BasicSparseMatrix&& other) = default;
+  ~S21BasicSparseMatrix() = default;
+
+  int GetRows() const noexcept;
+  int GetCols() const noexcept;
+  S21SparseFormat GetFormat() const noexcept;
+  std::size_t NonZeros() const noexcept;
+  const std::pmr::vector<std::size_t>& Offsets() const noexcept;
+  const std::pmr::vector<int>& Indices() const noexcept;
+  const std::pmr::vector<T>& Values() const noexcept;
+  // Stored value of (i, j), 0 when there is none.
+  T operator()(int i, int j) const;
+
+  // Counting-sort conversion between CSR and CSC, O(rows + cols + nnz).
+  S21BasicSparseMatrix ToFormat(S21SparseFormat format) const;
+  S21BasicMatrix<T> ToDense() const;
+  // The CSR arrays of A are the CSC arrays of A^T, so the transpose comes in
+  // the other format at the cost of a copy.
+  S21BasicSparseMatrix Transpose() const;
+
+  bool EqMatrix(const S21BasicSparseMatrix& other) const;
+  void SumMatrix(const S21BasicSparseMatrix& other);
+  void SubMatrix(const S21BasicSparseMatrix& other);
+  // y = A * x for x of GetCols() and y of GetRows() elements. CSR rows are
+  // split across the thread pool; CSC scatters column by column.
+  void MulVector(const T* x, T* y) const;
+  // A * B for a dense B; every stored a(i, k) adds a(i, k) * row k of B to
+  // row i of the result.
+  S21BasicMatrix<T> MulMatrix(const S21BasicMatrix<T>& dense) const;
+
+  S21BasicSparseMatrix operator+(const S21BasicSparseMatrix& other) const;
+  S21BasicSparseMatrix operator-(const S21BasicSparseMatrix& other) const;
+  S21BasicMatrix<T> operator*(const S21BasicMatrix<T>& dense) const;
+  bool operator==(const S21BasicSparseMatrix& other) const;
+
+ private:
+  int rows_;
+  int cols_;
+  S21SparseFormat format_;
+  std::pmr::vector<std::size_t> offsets_;
+  std::pmr::vector<int> indices_;
+  std::pmr::vector<T> values_;
+
+  int _Major() const noexcept;
+  int _Minor() const noexcept;
+  void _SumAndSubMatrix(char plus_or_minus,
+                        const S21BasicSparseMatrix& other);
+};
+
+using S21SparseMatrix = S21BasicSparseMatrix<double>;
+using S21Triplet = S21BasicTriplet<double>;
+
+extern template class S21BasicSparseMatrix<float>;
+extern template class S21BasicSparseMatrix<double>;
+extern template class S21BasicSparseMatrix<long double>;
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_SPARSE_MATRIX_H
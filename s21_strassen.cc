@@ -0,0 +1,176 @@
+#include "s21_strassen.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory_resource>
+#include <vector>
+
+#include "s21_gemm.h"
+#include "s21_matrix.h"
+#include "s21_profile.h"
+
+namespace s21 {
+
+namespace {
+
+std::atomic<MulAlgorithm> mul_algorithm{MulAlgorithm::kClassic};
+std::atomic<int> strassen_crossover{kStrassenCrossover};
+
+template <class T>
+using ConstView = S21BasicMatrixView<const T>;
+template <class T>
+using View = S21BasicMatrixView<T>;
+
+bool Recurses(int m, int n, int k, int crossover) noexcept {
+  return std::min({m, n, k}) > crossover;
+}
+
+// c := a * b + beta * c straight through the blocked kernel; the operands
+// of the recursion never overlap, so the checks of the view Gemm are moot.
+template <class T>
+void Product(ConstView<T> a, ConstView<T> b, T beta, View<T> c) {
+  s21::Gemm<T>(c.GetRows(), c.GetCols(), a.GetCols(), 1, a.data(),
+               a.stride(), a.col_stride(), b.data(), b.stride(),
+               b.col_stride(), beta, c.data(), c.stride(), c.col_stride());
+}
+
+// The schedule of Boyer, Dumas, Pernet and Zhou ("Memory efficient
+// scheduling of Strassen-Winograd's matrix multiplication algorithm",
+// 2009) with the two temporaries X and Y; the seven products and the
+// partial sums U live in the quadrants of C.
+template <class T>
+void Winograd(ConstView<T> a, ConstView<T> b, View<T> c, int crossover,
+              T* workspace) {
+  const int m = a.GetRows(), k = a.GetCols(), n = b.GetCols();
+  if (!Recurses(m, n, k, crossover)) {
+    Product<T>(a, b, 0, c);
+    return;
+  }
+  const int m2 = m / 2, k2 = k / 2, n2 = n / 2;
+  const int x_cols = std::max(k2, n2);
+  ConstView<T> a11 = a.Block(0, 0, m2, k2), a12 = a.Block(0, k2, m2, k2);
+  ConstView<T> a21 = a.Block(m2, 0, m2, k2), a22 = a.Block(m2, k2, m2, k2);
+  ConstView<T> b11 = b.Block(0, 0, k2, n2), b12 = b.Block(0, n2, k2, n2);
+  ConstView<T> b21 = b.Block(k2, 0, k2, n2), b22 = b.Block(k2, n2, k2, n2);
+  View<T> c11 = c.Block(0, 0, m2, n2), c12 = c.Block(0, n2, m2, n2);
+  View<T> c21 = c.Block(m2, 0, m2, n2), c22 = c.Block(m2, n2, m2, n2);
+  View<T> x(workspace, m2, x_cols, x_cols);
+  View<T> s = x.Block(0, 0, m2, k2), p1 = x.Block(0, 0, m2, n2);
+  T* y_data = workspace + static_cast<std::size_t>(m2) * x_cols;
+  View<T> y(y_data, k2, n2, n2);
+  T* next = y_data + static_cast<std::size_t>(k2) * n2;
+
+  s21::Sub<T>(a11, a21, s);                     // S3
+  s21::Sub<T>(b22, b12, y);                     // T3
+  Winograd<T>(s, y, c21, crossover, next);      // P7 = S3 T3
+  s21::Add<T>(a21, a22, s);                     // S1
+  s21::Sub<T>(b12, b11, y);                     // T1
+  Winograd<T>(s, y, c22, crossover, next);      // P5 = S1 T1
+  s21::Sub<T>(s, a11, s);                       // S2 = S1 - A11
+  s21::Sub<T>(b22, y, y);                       // T2 = B22 - T1
+  Winograd<T>(s, y, c12, crossover, next);      // P6 = S2 T2
+  s21::Sub<T>(a12, s, s);                       // S4 = A12 - S2
+  Winograd<T>(s, b22, c11, crossover, next);    // P3 = S4 B22
+  Winograd<T>(a11, b11, p1, crossover, next);   // P1
+  s21::Add<T>(p1, c12, c12);                    // U2 = P1 + P6
+  s21::Add<T>(c12, c21, c21);                   // U3 = U2 + P7
+  s21::Add<T>(c12, c22, c12);                   // U4 = U2 + P5
+  s21::Add<T>(c21, c22, c22);                   // U7 = U3 + P5 = C22
+  s21::Add<T>(c12, c11, c12);                   // U5 = U4 + P3 = C12
+  s21::Sub<T>(y, b21, y);                       // T4 = T2 - B21
+  Winograd<T>(a22, y, c11, crossover, next);    // P4 = A22 T4
+  s21::Sub<T>(c21, c11, c21);                   // U6 = U3 - P4 = C21
+  Winograd<T>(a12, b21, c11, crossover, next);  // P2
+  s21::Add<T>(p1, c11, c11);                    // U1 = P1 + P2 = C11
+
+  const int m_even = 2 * m2, k_even = 2 * k2, n_even = 2 * n2;
+  if (k_even < k) {
+    Product<T>(a.Block(0, k - 1, m_even, 1), b.Block(k - 1, 0, 1, n_even), 1,
+               c.Block(0, 0, m_even, n_even));
+  }
+  if (n_even < n) Product<T>(a, b.ColRange(n - 1, n), 0, c.ColRange(n - 1, n));
+  if (m_even < m) {
+    Product<T>(a.RowRange(m - 1, m), b.ColRange(0, n_even), 0,
+               c.Block(m - 1, 0, 1, n_even));
+  }
+}
+
+}  // namespace
+
+MulAlgorithm GetMulAlgorithm() noexcept { return mul_algorithm.load(); }
+
+MulAlgorithm SetMulAlgorithm(MulAlgorithm algorithm) noexcept {
+  return mul_algorithm.exchange(algorithm);
+}
+
+int GetStrassenCrossover() noexcept { return strassen_crossover.load(); }
+
+int SetStrassenCrossover(int crossover) noexcept {
+  return strassen_crossover.exchange(std::max(crossover, 1));
+}
+
+template <class T>
+std::size_t StrassenWorkspace(int m, int n, int k, int crossover) noexcept {
+  std::size_t size = 0;
+  crossover = std::max(crossover, 1);
+  while (Recurses(m, n, k, crossover)) {
+    m /= 2;
+    n /= 2;
+    k /= 2;
+    size += static_cast<std::size_t>(m) * std::max(k, n) +
+            static_cast<std::size_t>(k) * n;
+  }
+  return size;
+}
+
+template <class T>
+void Strassen(int m, int n, int k, const T* a, int rsa, int csa, const T* b,
+              int rsb, int csb, T* c, int rsc, int csc, int crossover,
+              T* workspace) {
+  Winograd<T>(ConstView<T>(a, m, k, rsa, csa), ConstView<T>(b, k, n, rsb, csb),
+              View<T>(c, m, n, rsc, csc), std::max(crossover, 1), workspace);
+}
+
+template <class T>
+void Multiply(MulAlgorithm algorithm, int m, int n, int k, const T* a,
+              int rsa, int csa, const T* b, int rsb, int csb, T* c, int rsc,
+              int csc) {
+  S21_PROFILE_SCOPE(kMulMatrix, 2. * m * n * k);
+  const int crossover = GetStrassenCrossover();
+  if (algorithm == MulAlgorithm::kClassic ||
+      !Recurses(m, n, k, crossover)) {
+    s21::Gemm<T>(m, n, k, 1, a, rsa, csa, b, rsb, csb, 0, c, rsc, csc);
+    return;
+  }
+  std::pmr::vector<T> workspace(
+      StrassenWorkspace<T>(m, n, k, crossover),
+      S21BasicMatrix<T>::GetDefaultResource());
+  Strassen<T>(m, n, k, a, rsa, csa, b, rsb, csb, c, rsc, csc, crossover,
+              workspace.data());
+}
+
+template std::size_t StrassenWorkspace<float>(int, int, int, int) noexcept;
+template std::size_t StrassenWorkspace<double>(int, int, int, int) noexcept;
+template std::size_t StrassenWorkspace<long double>(int, int, int,
+                                                    int) noexcept;
+template void Strassen<float>(int, int, int, const float*, int, int,
+                              const float*, int, int, float*, int, int, int,
+                              float*);
+template void Strassen<double>(int, int, int, const double*, int, int,
+                               const double*, int, int, double*, int, int,
+                               int, double*);
+template void Strassen<long double>(int, int, int, const long double*, int,
+                                    int, const long double*, int, int,
+                                    long double*, int, int, int,
+                                    long double*);
+template void Multiply<float>(MulAlgorithm, int, int, int, const float*, int,
+                              int, const float*, int, int, float*, int, int);
+template void Multiply<double>(MulAlgorithm, int, int, int, const double*,
+                               int, int, const double*, int, int, double*,
+                               int, int);
+template void Multiply<long double>(MulAlgorithm, int, int, int,
+                                    const long double*, int, int,
+                                    const long double*, int, int,
+                                    long double*, int, int);
+
+}  // namespace s21
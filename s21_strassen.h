@@ -0,0 +1,91 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_STRASSEN_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_STRASSEN_H
+
+#include <cstddef>
+
+namespace s21 {
+
+// Algorithm of MulMatrix and of the matrix product operator.
+enum class MulAlgorithm {
+  kClassic,   // the blocked O(n^3) Gemm
+  kStrassen,  // Strassen-Winograd down to the crossover, then Gemm
+};
+
+// Products whose smallest dimension is at most the crossover are left to
+// Gemm, so every leaf of the recursion is between crossover / 2 and
+// crossover on its smallest side.
+constexpr int kStrassenCrossover = 512;
+
+// Process-wide settings; each setter returns the previous value. The
+// crossover is at least 1. Defaults: kClassic and kStrassenCrossover.
+MulAlgorithm GetMulAlgorithm() noexcept;
+MulAlgorithm SetMulAlgorithm(MulAlgorithm algorithm) noexcept;
+int GetStrassenCrossover() noexcept;
+int SetStrassenCrossover(int crossover) noexcept;
+
+// Elements of workspace Strassen needs for an m x k by k x n product: at
+// each level one m/2 x max(k/2, n/2) and one k/2 x n/2 temporary, the rest
+// of each level held in the quadrants of C. About (mk + kn) / 3 elements
+// for square operands; 0 when no level recurses.
+template <class T>
+std::size_t StrassenWorkspace(int m, int n, int k, int crossover) noexcept;
+
+// C := A * B by the Winograd variant of Strassen's algorithm: 7 half-size
+// products and 15 additions per level instead of 8 products. A is m x k,
+// B is k x n and C is m x n, all addressed through row and column strides
+// as in Gemm. Odd dimensions are peeled: the even part recurses and the
+// last row, column or rank-1 term is added by Gemm. C must not overlap A,
+// B or the workspace of StrassenWorkspace elements.
+//
+// Accuracy. The classic product has the componentwise bound
+// |C - fl(AB)| <= k u |A| |B| (u the unit roundoff), so every element is
+// accurate relative to its own terms. Strassen-Winograd only satisfies a
+// normwise bound: max |C - fl(AB)| <= c(n) u max |A| max |B|, where c(n)
+// grows as (n / n0)^log2(18) ~ (n / n0)^4.17 times n0^2 for leaves of size
+// n0 (Higham, Accuracy and Stability of Numerical Algorithms, sec. 23.2.2).
+// The worst case is pessimistic; in practice each level costs a small
+// factor in the largest error. Elements much smaller than |A| |B| may lose
+// all relative accuracy, so keep kClassic for badly scaled operands.
+template <class T>
+void Strassen(int m, int n, int k, const T* a, int rsa, int csa, const T* b,
+              int rsb, int csb, T* c, int rsc, int csc, int crossover,
+              T* workspace);
+
+// C := A * B with the given algorithm and the process-wide crossover. The
+// workspace of kStrassen is one allocation from the default resource of
+// S21BasicMatrix, made only when a level recurses.
+template <class T>
+void Multiply(MulAlgorithm algorithm, int m, int n, int k, const T* a,
+              int rsa, int csa, const T* b, int rsb, int csb, T* c, int rsc,
+              int csc);
+
+extern template std::size_t StrassenWorkspace<float>(int, int, int,
+                                                     int) noexcept;
+extern template std::size_t StrassenWorkspace<double>(int, int, int,
+                                                      int) noexcept;
+extern template std::size_t StrassenWorkspace<long double>(int, int, int,
+                                                           int) noexcept;
+extern template void Strassen<float>(int, int, int, const float*, int, int,
+                                     const float*, int, int, float*, int,
+                                     int, int, float*);
+extern template void Strassen<double>(int, int, int, const double*, int, int,
+                                      const double*, int, int, double*, int,
+                                      int, int, double*);
+extern template void Strassen<long double>(int, int, int, const long double*,
+                                           int, int, const long double*, int,
+                                           int, long double*, int, int, int,
+                                           long double*);
+extern template void Multiply<float>(MulAlgorithm, int, int, int,
+                                     const float*, int, int, const float*,
+                                     int, int, float*, int, int);
+extern template void Multiply<double>(MulAlgorithm, int, int, int,
+                                      const double*, int, int, const double*,
+                                      int, int, double*, int, int);
+extern template void Multiply<long double>(MulAlgorithm, int, int, int,
+                                           const long double*, int, int,
+                                           const long double*, int, int,
+                                           long double*, int, int);
+
+}  // namespace s21
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_STRASSEN_H
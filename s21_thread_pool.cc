@@ -0,0 +1,218 @@
+#include "s21_thread_pool.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace s21 {
+
+namespace {
+
+thread_local ThreadPool* tls_pool = nullptr;
+thread_local int tls_worker = -1;
+
+int HardwareThreads() noexcept {
+  unsigned count = std::thread::hardware_concurrency();
+  return count == 0 ? 1 : static_cast<int>(count);
+}
+
+}  // namespace
+
+ThreadPool& ThreadPool::Instance() {
+  static ThreadPool pool([] {
+    const char* env = std::getenv("S21_NUM_THREADS");
+    return env != nullptr ? std::atoi(env) : 0;
+  }());
+  return pool;
+}
+
+ThreadPool::ThreadPool(int threads, AffinityPolicy policy)
+    : pending_(0), next_queue_(0), stop_(false), threads_(1),
+      policy_(policy) {
+  _Start(threads, policy);
+}
+
+ThreadPool::~ThreadPool() { _Stop(); }
+
+void ThreadPool::Configure(int threads, AffinityPolicy policy) {
+  _Stop();
+  _Start(threads, policy);
+}
+
+int ThreadPool::GetThreadCount() const noexcept { return threads_; }
+AffinityPolicy ThreadPool::GetAffinityPolicy() const noexcept {
+  return policy_;
+}
+
+void ThreadPool::_Start(int threads, AffinityPolicy policy) {
+  threads_ = threads > 0 ? threads : HardwareThreads();
+  policy_ = policy;
+  stop_ = false;
+  queues_.clear();
+  for (int i = 0; i < threads_ - 1; i++) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  for (int i = 0; i < threads_ - 1; i++) {
+    workers_.emplace_back(&ThreadPool::_WorkerLoop, this, i);
+    _Pin(workers_.back(), i + 1, threads_, policy_);
+  }
+}
+
+// Workers leave only once nothing is queued; whatever a task queued after
+// the last of them left runs here, so no task is ever dropped.
+void ThreadPool::_Stop() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread& worker : workers_) worker.join();
+  workers_.clear();
+  while (_TryRunOne(-1)) {
+  }
+}
+
+void ThreadPool::_Pin(std::thread& thread, int index, int threads,
+                      AffinityPolicy policy) {
+#ifdef __linux__
+  const int cpus = HardwareThreads();
+  int cpu = -1;
+  if (policy == AffinityPolicy::kCompact) {
+    cpu = index % cpus;
+  } else if (policy == AffinityPolicy::kScatter) {
+    cpu = static_cast<int>(static_cast<long long>(index) * cpus / threads) %
+          cpus;
+  }
+  if (cpu >= 0) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+  }
+#else
+  (void)thread;
+  (void)index;
+  (void)threads;
+  (void)policy;
+#endif
+}
+
+void ThreadPool::Submit(Task task) {
+  if (queues_.empty()) {
+    task();
+    return;
+  }
+  std::size_t target = tls_pool == this
+                           ? static_cast<std::size_t>(tls_worker)
+                           : next_queue_++ % queues_.size();
+  {
+    std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+    queues_[target]->tasks.push_back(std::move(task));
+    pending_++;
+  }
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+  }
+  wake_.notify_one();
+}
+
+// Pops from the back of the home queue, then steals from the front of the
+// others. home is -1 for threads that do not belong to the pool.
+bool ThreadPool::_TryRunOne(int home) {
+  Task task;
+  const int count = static_cast<int>(queues_.size());
+  for (int n = 0; n < count && !task; n++) {
+    int index = home >= 0 ? (home + n) % count : n;
+    Queue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) continue;
+    if (index == home) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+  }
+  if (!task) return false;
+  pending_--;
+  task();
+  return true;
+}
+
+void ThreadPool::_WorkerLoop(int index) {
+  tls_pool = this;
+  tls_worker = index;
+  while (true) {
+    if (_TryRunOne(index)) continue;
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    wake_.wait(lock, [this] { return stop_ || pending_ > 0; });
+    if (stop_ && pending_ == 0) break;
+  }
+  tls_pool = nullptr;
+  tls_worker = -1;
+}
+
+void ThreadPool::ParallelFor(std::ptrdiff_t count, std::ptrdiff_t grain,
+                             const RangeBody& body) {
+  if (count <= 0) return;
+  grain = std::max<std::ptrdiff_t>(grain, 1);
+  std::ptrdiff_t chunks =
+      std::min<std::ptrdiff_t>(count / grain, threads_ * 4);
+  if (threads_ <= 1 || chunks < 2) {
+    body(0, count);
+    return;
+  }
+
+  std::atomic<std::ptrdiff_t> remaining(chunks);
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto run_chunk = [&](std::ptrdiff_t chunk) {
+    try {
+      body(count * chunk / chunks, count * (chunk + 1) / chunks);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (!error) error = std::current_exception();
+    }
+    remaining--;
+  };
+  // Chunks that cannot be queued, when Submit runs out of memory, run here;
+  // the queued ones refer to this frame, so it must not unwind before they
+  // are done.
+  std::ptrdiff_t queued = 1;
+  try {
+    for (; queued < chunks; queued++) {
+      Submit([&run_chunk, queued] { run_chunk(queued); });
+    }
+  } catch (...) {
+  }
+  for (std::ptrdiff_t chunk = queued; chunk < chunks; chunk++)
+    run_chunk(chunk);
+  run_chunk(0);
+  RunUntil([&remaining] { return remaining == 0; });
+  if (error) std::rethrow_exception(error);
+}
+
+void ThreadPool::RunUntil(const std::function<bool()>& done) {
+  const int home = tls_pool == this ? tls_worker : -1;
+  while (!done()) {
+    if (!_TryRunOne(home)) std::this_thread::yield();
+  }
+}
+
+void ParallelFor(std::ptrdiff_t count, std::ptrdiff_t grain,
+                 const ThreadPool::RangeBody& body) {
+  ThreadPool::Instance().ParallelFor(count, grain, body);
+}
+
+std::ptrdiff_t ParallelGrain(std::ptrdiff_t work_per_item) noexcept {
+  work_per_item = std::max<std::ptrdiff_t>(work_per_item, 1);
+  return std::max<std::ptrdiff_t>(kParallelMinWork / work_per_item, 1);
+}
+
+}  // namespace s21
@@ -0,0 +1,101 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_THREAD_POOL_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+enum class AffinityPolicy {
+  kNone,     // let the OS scheduler place the workers
+  kCompact,  // pin worker i to CPU i
+  kScatter,  // spread the workers evenly over all CPUs
+};
+
+// Work-stealing pool shared by the matrix kernels. Each worker owns a deque:
+// it pops its own tasks LIFO and steals from the others FIFO. Threads that
+// wait for a ParallelFor run queued tasks instead of blocking, so kernels
+// may nest parallel loops freely.
+class ThreadPool {
+ public:
+  using Task = std::function<void()>;
+  using RangeBody = std::function<void(std::ptrdiff_t, std::ptrdiff_t)>;
+
+  // The process-wide pool, sized from S21_NUM_THREADS or the hardware.
+  static ThreadPool& Instance();
+
+  explicit ThreadPool(int threads = 0,
+                      AffinityPolicy policy = AffinityPolicy::kNone);
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  // Restarts the workers; threads counts the calling thread, so 1 makes
+  // every call run inline. 0 means one thread per hardware CPU. Queued
+  // tasks are run before the old workers go. Not thread-safe: no other
+  // thread may use the pool meanwhile, and it must not be called from a
+  // task.
+  void Configure(int threads, AffinityPolicy policy = AffinityPolicy::kNone);
+  int GetThreadCount() const noexcept;
+  AffinityPolicy GetAffinityPolicy() const noexcept;
+
+  void Submit(Task task);
+
+  // Calls body on disjoint subranges covering [0, count), each at least
+  // grain long, and returns once all of them are done. Ranges that do not
+  // split into two grains run inline on the caller, as do chunks that
+  // cannot be queued. The first exception thrown by body is rethrown here;
+  // ParallelFor itself throws nothing else.
+  void ParallelFor(std::ptrdiff_t count, std::ptrdiff_t grain,
+                   const RangeBody& body);
+
+  // Runs queued tasks on the calling thread until done() returns true, so
+  // a thread that waits for pool work helps with it instead of blocking.
+  void RunUntil(const std::function<bool()>& done);
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> workers_;
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  std::atomic<std::size_t> pending_;
+  std::atomic<std::size_t> next_queue_;
+  bool stop_;
+  int threads_;
+  AffinityPolicy policy_;
+
+  void _Start(int threads, AffinityPolicy policy);
+  void _Stop();
+  void _WorkerLoop(int index);
+  bool _TryRunOne(int home);
+  static void _Pin(std::thread& thread, int index, int threads,
+                   AffinityPolicy policy);
+};
+
+// Work below which a kernel is not worth splitting across threads, in
+// element operations.
+constexpr std::ptrdiff_t kParallelMinWork = 1 << 15;
+
+// Shortcut for ThreadPool::Instance().ParallelFor.
+void ParallelFor(std::ptrdiff_t count, std::ptrdiff_t grain,
+                 const ThreadPool::RangeBody& body);
+
+// Grain, in items, that gives each chunk at least kParallelMinWork
+// operations when one item costs work_per_item.
+std::ptrdiff_t ParallelGrain(std::ptrdiff_t work_per_item) noexcept;
+
+}  // namespace s21
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_THREAD_POOL_H
@@ -0,0 +1,393 @@
+#include "s21_tiled_matrix.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+
+#include "s21_gemm.h"
+#include "s21_matrix_file.h"
+
+namespace {
+
+constexpr char kMagic[8] = {'S', '2', '1', 'T', 'I', 'L', 'E', 'S'};
+constexpr std::uint32_t kVersion = 1;
+
+struct TileHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t dtype;
+  std::uint32_t element_size;
+  std::uint32_t tile;
+  std::uint64_t rows;
+  std::uint64_t cols;
+  std::uint64_t data_offset;
+  char reserved[16];
+};
+
+static_assert(sizeof(TileHeader) == 64, "the header is 64 bytes");
+
+int OpenFile(const std::string& path, int flags) {
+  int fd = open(path.c_str(), flags | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    throw std::system_error(errno, std::generic_category(),
+                            "Cannot open matrix file");
+  }
+  return fd;
+}
+
+int Blocks(int size, int tile) noexcept { return (size + tile - 1) / tile; }
+
+}  // namespace
+
+template <class T>
+S21BasicTiledMatrix<T>::S21BasicTiledMatrix() noexcept
+    : fd_(-1), rows_(0), cols_(0), tile_(0) {}
+
+// The file is extended to its full size with ftruncate, which reads back as
+// zeros without writing them.
+template <class T>
+S21BasicTiledMatrix<T>::S21BasicTiledMatrix(const std::string& path,
+                                            int rows, int cols, int tile)
+    : S21BasicTiledMatrix() {
+  if (rows < 1 || cols < 1 || tile < 1)
+    throw std::out_of_range("Invalid matrix");
+  rows_ = rows;
+  cols_ = cols;
+  tile_ = (tile + s21::kGemmKC - 1) / s21::kGemmKC * s21::kGemmKC;
+  fd_ = OpenFile(path, O_RDWR | O_CREAT | O_TRUNC);
+  TileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.dtype = static_cast<std::uint32_t>(s21::DtypeOf<T>());
+  header.element_size = sizeof(T);
+  header.tile = tile_;
+  header.rows = rows_;
+  header.cols = cols_;
+  header.data_offset = sizeof(header);
+  try {
+    s21::WriteFile(fd_, &header, sizeof(header), 0);
+    if (ftruncate(fd_, _TileOffset(TileRows(), 0)) != 0) {
+      throw std::system_error(errno, std::generic_category(),
+                              "Cannot write matrix file");
+    }
+  } catch (...) {
+    _Close();
+    throw;
+  }
+}
+
+template <class T>
+S21BasicTiledMatrix<T>::S21BasicTiledMatrix(
+    S21BasicTiledMatrix&& other) noexcept
+    : fd_(other.fd_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      tile_(other.tile_) {
+  other.fd_ = -1;
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.tile_ = 0;
+}
+
+template <class T>
+S21BasicTiledMatrix<T>& S21BasicTiledMatrix<T>::operator=(
+    S21BasicTiledMatrix&& other) noexcept {
+  if (this != &other) {
+    _Close();
+    std::swap(fd_, other.fd_);
+    std::swap(rows_, other.rows_);
+    std::swap(cols_, other.cols_);
+    std::swap(tile_, other.tile_);
+  }
+  return *this;
+}
+
+template <class T>
+S21BasicTiledMatrix<T>::~S21BasicTiledMatrix() {
+  _Close();
+}
+
+template <class T>
+void S21BasicTiledMatrix<T>::_Close() noexcept {
+  if (fd_ >= 0) close(fd_);
+  fd_ = -1;
+  rows_ = 0;
+  cols_ = 0;
+  tile_ = 0;
+}
+
+template <class T>
+S21BasicTiledMatrix<T> S21BasicTiledMatrix<T>::Open(const std::string& path) {
+  S21BasicTiledMatrix result;
+  result.fd_ = OpenFile(path, O_RDWR);
+  struct stat status;
+  if (fstat(result.fd_, &status) != 0) {
+    throw std::system_error(errno, std::generic_category(),
+                            "Cannot read matrix file");
+  }
+  TileHeader header;
+  if (static_cast<std::size_t>(status.st_size) < sizeof(header))
+    throw std::invalid_argument("Invalid matrix file");
+  s21::ReadFile(result.fd_, &header, sizeof(header), 0);
+  const std::uint64_t int_max = std::numeric_limits<int>::max();
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion || header.element_size != sizeof(T) ||
+      header.tile < 1 || header.tile % s21::kGemmKC != 0 ||
+      header.tile > int_max || header.rows < 1 || header.rows > int_max ||
+      header.cols < 1 || header.cols > int_max ||
+      header.data_offset != sizeof(header))
+    throw std::invalid_argument("Invalid matrix file");
+  if (header.dtype != static_cast<std::uint32_t>(s21::DtypeOf<T>()))
+    throw std::invalid_argument("Matrix file has another element type");
+  result.rows_ = static_cast<int>(header.rows);
+  result.cols_ = static_cast<int>(header.cols);
+  result.tile_ = static_cast<int>(header.tile);
+  if (static_cast<std::size_t>(status.st_size) <
+      result._TileOffset(result.TileRows(), 0))
+    throw std::invalid_argument("Invalid matrix file");
+  return result;
+}
+
+template <class T>
+S21BasicTiledMatrix<T> S21BasicTiledMatrix<T>::FromMatrix(
+    const std::string& path, S21BasicMatrixView<const T> matrix, int tile) {
+  if (matrix.Empty()) throw std::out_of_range("Invalid matrix");
+  S21BasicTiledMatrix result(path, matrix.GetRows(), matrix.GetCols(), tile);
+  S21BasicMatrix<T> buffer(result.tile_, result.tile_);
+  for (int bi = 0; bi < result.TileRows(); bi++) {
+    for (int bj = 0; bj < result.TileCols(); bj++) {
+      const int rows = result._Extent(bi, result.rows_);
+      const int cols = result._Extent(bj, result.cols_);
+      if (rows < result.tile_ || cols < result.tile_)
+        s21::Fill<T>(buffer, 0);
+      s21::Copy<T>(matrix.Block(bi * result.tile_, bj * result.tile_, rows,
+                                cols),
+                   buffer.View().Block(0, 0, rows, cols));
+      result.WriteTile(bi, bj, buffer);
+    }
+  }
+  return result;
+}
+
+template <class T>
+S21BasicTiledMatrix<T> S21BasicTiledMatrix<T>::FromFile(
+    const std::string& path, const std::string& matrix_file, int tile) {
+  S21BasicMappedMatrix<T> source(matrix_file);
+  S21BasicTiledMatrix result(path, source.GetRows(), source.GetCols(), tile);
+  S21BasicMatrix<T> buffer(result.tile_, result.tile_);
+  for (int bi = 0; bi < result.TileRows(); bi++) {
+    source.Prefetch((bi + 1) * result.tile_, (bi + 2) * result.tile_);
+    for (int bj = 0; bj < result.TileCols(); bj++) {
+      const int rows = result._Extent(bi, result.rows_);
+      const int cols = result._Extent(bj, result.cols_);
+      if (rows < result.tile_ || cols < result.tile_)
+        s21::Fill<T>(buffer, 0);
+      s21::Copy<T>(source.View().Block(bi * result.tile_, bj * result.tile_,
+                                       rows, cols),
+                   buffer.View().Block(0, 0, rows, cols));
+      result.WriteTile(bi, bj, buffer);
+    }
+  }
+  return result;
+}
+
+template <class T>
+int S21BasicTiledMatrix<T>::GetRows() const noexcept {
+  return rows_;
+}
+
+template <class T>
+int S21BasicTiledMatrix<T>::GetCols() const noexcept {
+  return cols_;
+}
+
+template <class T>
+int S21BasicTiledMatrix<T>::GetTile() const noexcept {
+  return tile_;
+}
+
+template <class T>
+int S21BasicTiledMatrix<T>::TileRows() const noexcept {
+  return tile_ > 0 ? Blocks(rows_, tile_) : 0;
+}
+
+template <class T>
+int S21BasicTiledMatrix<T>::TileCols() const noexcept {
+  return tile_ > 0 ? Blocks(cols_, tile_) : 0;
+}
+
+template <class T>
+std::size_t S21BasicTiledMatrix<T>::_TileOffset(int bi,
+                                                int bj) const noexcept {
+  const std::size_t tile_bytes =
+      static_cast<std::size_t>(tile_) * tile_ * sizeof(T);
+  return sizeof(TileHeader) +
+         (static_cast<std::size_t>(bi) * TileCols() + bj) * tile_bytes;
+}
+
+// Rows or columns of block that lie inside a dimension of the given size.
+template <class T>
+int S21BasicTiledMatrix<T>::_Extent(int block, int size) const noexcept {
+  return std::min(tile_, size - block * tile_);
+}
+
+template <class T>
+void S21BasicTiledMatrix<T>::ReadTile(int bi, int bj,
+                                      S21BasicMatrixView<T> tile) const {
+  if (fd_ < 0 || tile.Empty()) throw std::out_of_range("Invalid matrix");
+  if (bi < 0 || bj < 0 || bi >= TileRows() || bj >= TileCols())
+    throw std::out_of_range("Invalid index");
+  if (tile.GetRows() != tile_ || tile.GetCols() != tile_ ||
+      tile.col_stride() != 1)
+    throw std::invalid_argument("Sizes are not equal");
+  const std::size_t row_bytes = static_cast<std::size_t>(tile_) * sizeof(T);
+  if (tile.stride() == tile_) {
+    s21::ReadFile(fd_, tile.data(), row_bytes * tile_, _TileOffset(bi, bj));
+    return;
+  }
+  for (int i = 0; i < tile_; i++) {
+    s21::ReadFile(fd_, tile.Row(i), row_bytes,
+                  _TileOffset(bi, bj) + i * row_bytes);
+  }
+}
+
+template <class T>
+void S21BasicTiledMatrix<T>::WriteTile(int bi, int bj,
+                                       S21BasicMatrixView<const T> tile) {
+  if (fd_ < 0 || tile.Empty()) throw std::out_of_range("Invalid matrix");
+  if (bi < 0 || bj < 0 || bi >= TileRows() || bj >= TileCols())
+    throw std::out_of_range("Invalid index");
+  if (tile.GetRows() != tile_ || tile.GetCols() != tile_ ||
+      tile.col_stride() != 1)
+    throw std::invalid_argument("Sizes are not equal");
+  const std::size_t row_bytes = static_cast<std::size_t>(tile_) * sizeof(T);
+  if (tile.stride() == tile_) {
+    s21::WriteFile(fd_, tile.data(), row_bytes * tile_, _TileOffset(bi, bj));
+    return;
+  }
+  for (int i = 0; i < tile_; i++) {
+    s21::WriteFile(fd_, tile.Row(i), row_bytes,
+                   _TileOffset(bi, bj) + i * row_bytes);
+  }
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicTiledMatrix<T>::ToMatrix() const {
+  if (fd_ < 0) throw std::out_of_range("Invalid matrix");
+  S21BasicMatrix<T> result(rows_, cols_);
+  S21BasicMatrix<T> buffer(tile_, tile_);
+  for (int bi = 0; bi < TileRows(); bi++) {
+    for (int bj = 0; bj < TileCols(); bj++) {
+      const int rows = _Extent(bi, rows_), cols = _Extent(bj, cols_);
+      ReadTile(bi, bj, buffer);
+      s21::Copy<T>(buffer.View().Block(0, 0, rows, cols),
+                   result.View().Block(bi * tile_, bj * tile_, rows, cols));
+    }
+  }
+  return result;
+}
+
+template <class T>
+void S21BasicTiledMatrix<T>::Save(const std::string& matrix_file) const {
+  if (fd_ < 0) throw std::out_of_range("Invalid matrix");
+  S21BasicMatrixWriter<T> writer(matrix_file, rows_, cols_);
+  S21BasicMatrix<T> panel(tile_, cols_);
+  S21BasicMatrix<T> buffer(tile_, tile_);
+  for (int bi = 0; bi < TileRows(); bi++) {
+    const int rows = _Extent(bi, rows_);
+    for (int bj = 0; bj < TileCols(); bj++) {
+      const int cols = _Extent(bj, cols_);
+      ReadTile(bi, bj, buffer);
+      s21::Copy<T>(buffer.View().Block(0, 0, rows, cols),
+                   panel.View().Block(0, bj * tile_, rows, cols));
+    }
+    writer.WriteRows(panel.View().RowRange(0, rows));
+  }
+  writer.Close();
+}
+
+// Step s multiplies A(i, p) by B(p, j) into C(i, j), with p running
+// fastest. Tiles alternate between two slots: while step s computes from
+// one, the operands of step s + 1 are read into the other, and a finished
+// C tile is written from its slot while the next one accumulates in the
+// other. Each future is collected before its slot is reused.
+template <class T>
+S21BasicTiledMatrix<T> S21BasicTiledMatrix<T>::MulMatrix(
+    const S21BasicTiledMatrix& other, const std::string& path) const {
+  if (fd_ < 0 || other.fd_ < 0) throw std::out_of_range("Invalid matrix");
+  if (cols_ != other.rows_)
+    throw std::invalid_argument(
+        "Columns first matrix not equal rows second matrix");
+  if (tile_ != other.tile_) throw std::invalid_argument("Sizes are not equal");
+  S21BasicTiledMatrix result(path, rows_, other.cols_, tile_);
+  const int tiles_j = other.TileCols(), tiles_k = TileCols();
+  const std::ptrdiff_t steps =
+      static_cast<std::ptrdiff_t>(TileRows()) * tiles_j * tiles_k;
+  S21BasicMatrix<T> a_tiles[2] = {{tile_, tile_}, {tile_, tile_}};
+  S21BasicMatrix<T> b_tiles[2] = {{tile_, tile_}, {tile_, tile_}};
+  S21BasicMatrix<T> c_tiles[2] = {{tile_, tile_}, {tile_, tile_}};
+  auto load = [&](std::ptrdiff_t step, int slot) {
+    const int i = step / (tiles_j * tiles_k);
+    const int j = step / tiles_k % tiles_j;
+    const int p = step % tiles_k;
+    ReadTile(i, p, a_tiles[slot]);
+    other.ReadTile(p, j, b_tiles[slot]);
+  };
+  std::future<void> loading = std::async(std::launch::async, load, 0, 0);
+  std::future<void> writing;
+  int c_slot = 0;
+  for (std::ptrdiff_t step = 0; step < steps; step++) {
+    const int slot = step % 2;
+    loading.get();
+    if (step + 1 < steps)
+      loading = std::async(std::launch::async, load, step + 1, 1 - slot);
+    const int i = step / (tiles_j * tiles_k);
+    const int j = step / tiles_k % tiles_j;
+    const int p = step % tiles_k;
+    const int m = _Extent(i, rows_);
+    const int n = other._Extent(j, other.cols_);
+    const int k = _Extent(p, cols_);
+    // An edge tile one row, column or index wide would go to GEMV or GER,
+    // which sum in another order than the blocked kernel of the whole
+    // product; one zero row, column or index more keeps it blocked.
+    const int m_pad = m == 1 && rows_ > 1 ? 2 : m;
+    const int n_pad = n == 1 && other.cols_ > 1 ? 2 : n;
+    const int k_pad = k == 1 && cols_ > 1 ? 2 : k;
+    if (k_pad > k) {
+      s21::Fill<T>(a_tiles[slot].View().Block(0, k, m_pad, 1), 0);
+      s21::Fill<T>(b_tiles[slot].View().Block(k, 0, 1, n_pad), 0);
+    }
+    if (p == 0 && (m < tile_ || n < tile_))
+      s21::Fill<T>(c_tiles[c_slot], 0);
+    s21::Gemm<T>(1, a_tiles[slot].View().Block(0, 0, m_pad, k_pad),
+                 b_tiles[slot].View().Block(0, 0, k_pad, n_pad),
+                 p == 0 ? 0 : 1,
+                 c_tiles[c_slot].View().Block(0, 0, m_pad, n_pad));
+    if (p == tiles_k - 1) {
+      if (m_pad > m)
+        s21::Fill<T>(c_tiles[c_slot].View().Block(m, 0, 1, n_pad), 0);
+      if (n_pad > n)
+        s21::Fill<T>(c_tiles[c_slot].View().Block(0, n, m_pad, 1), 0);
+      if (writing.valid()) writing.get();
+      writing = std::async(std::launch::async, [&, i, j, c_slot] {
+        result.WriteTile(i, j, c_tiles[c_slot]);
+      });
+      c_slot = 1 - c_slot;
+    }
+  }
+  if (writing.valid()) writing.get();
+  return result;
+}
+
+template class S21BasicTiledMatrix<float>;
+template class S21BasicTiledMatrix<double>;
+template class S21BasicTiledMatrix<long double>;
@@ -0,0 +1,94 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_TILED_MATRIX_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_TILED_MATRIX_H
+
+#include <string>
+
+#include "s21_matrix.h"
+
+// Out-of-core matrix kept in a file on local disk as square tiles of
+// GetTile() x GetTile() elements. Tile (bi, bj) covers rows
+// [bi * tile, (bi + 1) * tile) and the same range of columns; it is stored
+// contiguously and row-major, edge tiles zero-padded to the full size, so a
+// tile is one read or one write. The file starts with a 64-byte header
+//
+//   char[8] magic "S21TILES", uint32 version, uint32 dtype
+//   (S21MatrixDtype), uint32 element size, uint32 tile, uint64 rows,
+//   uint64 cols, uint64 data offset, 16 reserved bytes
+//
+// and has no checksum: it is working storage that is rewritten tile by tile.
+// Use Save() for a checksummed matrix file. Only the tiles being worked on
+// are ever in memory.
+template <class T>
+class S21BasicTiledMatrix {
+ public:
+  static constexpr int kDefaultTile = 1024;
+
+  // Creates a zero rows x cols matrix in a new file. The tile is rounded up
+  // to a multiple of s21::kGemmKC so that MulMatrix sums the k dimension in
+  // the same order as the in-memory GEMM.
+  S21BasicTiledMatrix(const std::string& path, int rows, int cols,
+                      int tile = kDefaultTile);
+  S21BasicTiledMatrix(S21BasicTiledMatrix&& other) noexcept;
+  S21BasicTiledMatrix& operator=(S21BasicTiledMatrix&& other) noexcept;
+  S21BasicTiledMatrix(const S21BasicTiledMatrix&) = delete;
+  S21BasicTiledMatrix& operator=(const S21BasicTiledMatrix&) = delete;
+  // Closes the file and leaves it on disk.
+  ~S21BasicTiledMatrix();
+
+  // Opens a tile file written earlier.
+  static S21BasicTiledMatrix Open(const std::string& path);
+  // Copies an in-memory matrix or view into a new tile file.
+  static S21BasicTiledMatrix FromMatrix(const std::string& path,
+                                        S21BasicMatrixView<const T> matrix,
+                                        int tile = kDefaultTile);
+  // Converts a matrix file (s21_matrix_file.h) through a read-only mapping,
+  // one row of tiles at a time, so the source is never fully in memory.
+  static S21BasicTiledMatrix FromFile(const std::string& path,
+                                      const std::string& matrix_file,
+                                      int tile = kDefaultTile);
+
+  int GetRows() const noexcept;
+  int GetCols() const noexcept;
+  int GetTile() const noexcept;
+  int TileRows() const noexcept;
+  int TileCols() const noexcept;
+
+  // Tile (bi, bj) from or to a tile x tile buffer; a view of a
+  // S21BasicMatrix(GetTile(), GetTile()) fits. pread/pwrite only, so
+  // different tiles may be moved from different threads.
+  void ReadTile(int bi, int bj, S21BasicMatrixView<T> tile) const;
+  void WriteTile(int bi, int bj, S21BasicMatrixView<const T> tile);
+
+  S21BasicMatrix<T> ToMatrix() const;
+  // Streams the matrix into a matrix file one row of tiles at a time.
+  void Save(const std::string& matrix_file) const;
+
+  // this * other into a new tile file at path. Tiles of C are computed one
+  // after the other with s21::Gemm, the kernel of MulMatrix; while one
+  // product runs, a background thread reads the next pair of A and B tiles
+  // and writes the previous C tile back. Six tiles are in memory: two
+  // pairs of operands and two of C. Both operands must share the tile size.
+  // For sizes that fit in memory the result equals MulMatrix bit for bit.
+  S21BasicTiledMatrix MulMatrix(const S21BasicTiledMatrix& other,
+                                const std::string& path) const;
+
+ private:
+  int fd_;
+  int rows_;
+  int cols_;
+  int tile_;
+
+  S21BasicTiledMatrix() noexcept;
+  std::size_t _TileOffset(int bi, int bj) const noexcept;
+  int _Extent(int block, int size) const noexcept;
+  void _Close() noexcept;
+};
+
+using S21TiledMatrix = S21BasicTiledMatrix<double>;
+using S21FloatTiledMatrix = S21BasicTiledMatrix<float>;
+
+extern template class S21BasicTiledMatrix<float>;
+extern template class S21BasicTiledMatrix<double>;
+extern template class S21BasicTiledMatrix<long double>;
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_TILED_MATRIX_H
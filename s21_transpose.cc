@@ -0,0 +1,119 @@
+#include "s21_transpose.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+namespace s21 {
+
+namespace {
+
+// Leaf size of the recursion: a 32 x 32 tile of A and of B take 16 KB
+// together in double, which fits in any L1.
+constexpr int kLeaf = 32;
+
+template <class T>
+void TransposeRecursive(const BasicSimdKernels<T>& simd, int rows, int cols,
+                        const T* a, int lda, T* b, int ldb) {
+  if (rows <= kLeaf && cols <= kLeaf) {
+    simd.transpose(rows, cols, a, lda, b, ldb);
+  } else if (rows >= cols) {
+    int half = rows / 2;
+    TransposeRecursive(simd, half, cols, a, lda, b, ldb);
+    TransposeRecursive(simd, rows - half, cols,
+                       a + static_cast<std::ptrdiff_t>(half) * lda, lda,
+                       b + half, ldb);
+  } else {
+    int half = cols / 2;
+    TransposeRecursive(simd, rows, half, a, lda, b, ldb);
+    TransposeRecursive(simd, rows, cols - half, a + half, lda,
+                       b + static_cast<std::ptrdiff_t>(half) * ldb, ldb);
+  }
+}
+
+}  // namespace
+
+template <class T>
+void Transpose(int rows, int cols, const T* a, int lda, T* b, int ldb) {
+  const BasicSimdKernels<T>& simd = Simd<T>();
+  const int band = 2 * kLeaf;
+  ParallelFor((rows + band - 1) / band, ParallelGrain(band * cols),
+              [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                int first = begin * band;
+                int last = std::min<int>(end * band, rows);
+                TransposeRecursive(
+                    simd, last - first, cols,
+                    a + static_cast<std::ptrdiff_t>(first) * lda, lda,
+                    b + first, ldb);
+              });
+}
+
+template <class T>
+void TransposeSquareInPlace(int n, T* a, int ld) {
+  const BasicSimdKernels<T>& simd = Simd<T>();
+  const int tiles = (n + kLeaf - 1) / kLeaf;
+  auto tile = [&](int row, int col) {
+    return a + static_cast<std::ptrdiff_t>(row) * kLeaf * ld + col * kLeaf;
+  };
+  ParallelFor(tiles, ParallelGrain(static_cast<std::ptrdiff_t>(kLeaf) * n),
+              [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                T buffer[kLeaf * kLeaf];
+                for (int ti = begin; ti < end; ti++) {
+                  int h = std::min(kLeaf, n - ti * kLeaf);
+                  T* diagonal = tile(ti, ti);
+                  for (int i = 0; i < h; i++) {
+                    for (int j = i + 1; j < h; j++) {
+                      std::swap(diagonal[i * ld + j], diagonal[j * ld + i]);
+                    }
+                  }
+                  for (int tj = ti + 1; tj < tiles; tj++) {
+                    int w = std::min(kLeaf, n - tj * kLeaf);
+                    T* upper = tile(ti, tj);
+                    T* lower = tile(tj, ti);
+                    simd.transpose(h, w, upper, ld, buffer, kLeaf);
+                    simd.transpose(w, h, lower, ld, upper, ld);
+                    for (int i = 0; i < w; i++) {
+                      std::copy(buffer + i * kLeaf, buffer + i * kLeaf + h,
+                                lower + static_cast<std::ptrdiff_t>(i) * ld);
+                    }
+                  }
+                }
+              });
+}
+
+// Element p = i * cols + j moves to j * rows + i, which is p * rows modulo
+// rows * cols - 1 for every p except the first and the last.
+template <class T>
+void TransposeDenseInPlace(int rows, int cols, T* a) {
+  if (rows == 1 || cols == 1) return;
+  const unsigned long long last =
+      static_cast<unsigned long long>(rows) * cols - 1;
+  std::vector<bool> moved(last, false);
+  for (unsigned long long start = 1; start < last; start++) {
+    if (moved[start]) continue;
+    T carry = a[start];
+    unsigned long long p = start;
+    do {
+      p = p * rows % last;
+      std::swap(carry, a[p]);
+      moved[p] = true;
+    } while (p != start);
+  }
+}
+
+template void Transpose<float>(int, int, const float*, int, float*, int);
+template void Transpose<double>(int, int, const double*, int, double*, int);
+template void Transpose<long double>(int, int, const long double*, int,
+                                     long double*, int);
+template void TransposeSquareInPlace<float>(int, float*, int);
+template void TransposeSquareInPlace<double>(int, double*, int);
+template void TransposeSquareInPlace<long double>(int, long double*, int);
+template void TransposeDenseInPlace<float>(int, int, float*);
+template void TransposeDenseInPlace<double>(int, int, double*);
+template void TransposeDenseInPlace<long double>(int, int, long double*);
+
+}  // namespace s21
@@ -0,0 +1,41 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_TRANSPOSE_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_TRANSPOSE_H
+
+namespace s21 {
+
+// B := A^T, where A is rows x cols with row stride lda and B is cols x rows
+// with row stride ldb. A and B must not overlap. The matrix is halved along
+// its longer side until the pieces fit in L1 (cache-oblivious recursion), and
+// the pieces are transposed with the SIMD register-tile kernels.
+template <class T>
+void Transpose(int rows, int cols, const T* a, int lda, T* b, int ldb);
+
+// Transposes an n x n matrix with row stride ld in place by swapping
+// mirrored tiles through a small stack buffer.
+template <class T>
+void TransposeSquareInPlace(int n, T* a, int ld);
+
+// Turns a dense rows x cols matrix (row stride cols) into its dense
+// cols x rows transpose in the same buffer by following the permutation
+// cycles. Needs one bit of scratch per element.
+template <class T>
+void TransposeDenseInPlace(int rows, int cols, T* a);
+
+extern template void Transpose<float>(int, int, const float*, int, float*,
+                                      int);
+extern template void Transpose<double>(int, int, const double*, int, double*,
+                                       int);
+extern template void Transpose<long double>(int, int, const long double*, int,
+                                            long double*, int);
+extern template void TransposeSquareInPlace<float>(int, float*, int);
+extern template void TransposeSquareInPlace<double>(int, double*, int);
+extern template void TransposeSquareInPlace<long double>(int, long double*,
+                                                         int);
+extern template void TransposeDenseInPlace<float>(int, int, float*);
+extern template void TransposeDenseInPlace<double>(int, int, double*);
+extern template void TransposeDenseInPlace<long double>(int, int,
+                                                        long double*);
+
+}  // namespace s21
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_TRANSPOSE_H
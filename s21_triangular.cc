@@ -0,0 +1,121 @@
+#include "s21_triangular.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+namespace s21 {
+
+namespace {
+
+template <class T>
+using ConstView = S21BasicMatrixView<const T>;
+template <class T>
+using View = S21BasicMatrixView<T>;
+
+// Below this many right-hand sides the SIMD call costs more than it saves.
+constexpr int kAxpyWidth = 8;
+
+// Row i of x := (row i - sum of a(i, r) * row r) / a(i, i), one SIMD axpy
+// per solved row r.
+template <class T>
+void SubstituteRows(Triangle triangle, Diagonal diagonal, ConstView<T> a,
+                    View<T> x) {
+  const BasicSimdKernels<T>& simd = Simd<T>();
+  const int n = a.GetRows(), width = x.GetCols();
+  const std::ptrdiff_t acs = a.col_stride();
+  const bool lower = triangle == Triangle::kLower;
+  for (int step = 0; step < n; step++) {
+    const int i = lower ? step : n - 1 - step;
+    const T* ai = a.Row(i);
+    T* xi = x.Row(i);
+    for (int r = lower ? 0 : i + 1; r < (lower ? i : n); r++) {
+      const T factor = ai[r * acs];
+      if (factor != 0) simd.axpy(-factor, x.Row(r), xi, width);
+    }
+    if (diagonal == Diagonal::kNonUnit) {
+      const T pivot = ai[i * acs];
+      for (int j = 0; j < width; j++) xi[j] /= pivot;
+    }
+  }
+}
+
+// One right-hand side at a time as dot products; four partial sums keep the
+// additions from waiting on each other.
+template <class T>
+void SubstituteColumns(Triangle triangle, Diagonal diagonal, ConstView<T> a,
+                       View<T> x) {
+  const int n = a.GetRows();
+  const std::ptrdiff_t acs = a.col_stride(), xs = x.stride();
+  const bool lower = triangle == Triangle::kLower;
+  for (int j = 0; j < x.GetCols(); j++) {
+    T* column = x.Row(0) + static_cast<std::ptrdiff_t>(j) * x.col_stride();
+    for (int step = 0; step < n; step++) {
+      const int i = lower ? step : n - 1 - step;
+      const T* ai = a.Row(i);
+      const int end = lower ? i : n;
+      T sums[4] = {0, 0, 0, 0};
+      int r = lower ? 0 : i + 1;
+      for (; r + 4 <= end; r += 4) {
+        for (int u = 0; u < 4; u++)
+          sums[u] += ai[(r + u) * acs] * column[(r + u) * xs];
+      }
+      for (; r < end; r++) sums[0] += ai[r * acs] * column[r * xs];
+      T value = column[i * xs] - ((sums[0] + sums[1]) + (sums[2] + sums[3]));
+      if (diagonal == Diagonal::kNonUnit) value /= ai[i * acs];
+      column[i * xs] = value;
+    }
+  }
+}
+
+}  // namespace
+
+template <class T>
+void TriangularSolve(Triangle triangle, Diagonal diagonal, ConstView<T> a,
+                     View<T> b) {
+  if (a.Empty() || b.Empty()) throw std::out_of_range("Invalid matrix");
+  if (a.GetRows() != a.GetCols())
+    throw std::invalid_argument("Matrix is not square");
+  if (b.GetRows() != a.GetRows())
+    throw std::invalid_argument("Sizes are not equal");
+  const std::ptrdiff_t n = a.GetRows();
+  const std::ptrdiff_t panel = std::max<std::ptrdiff_t>(
+      kTriangularPanelBytes / (sizeof(T) * n), kAxpyWidth);
+  // Right-hand sides are independent, so the columns of b are split across
+  // threads and then into panels. A panel narrower than b is solved in a
+  // packed copy: its rows would otherwise sit a whole row of b apart, which
+  // for power-of-two widths maps them onto a few cache sets.
+  const bool pack = panel < b.GetCols();
+  ParallelFor(
+      b.GetCols(), ParallelGrain(n * n),
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        std::pmr::vector<T> scratch(pack ? n * panel : 0,
+                                    S21BasicMatrix<T>::GetDefaultResource());
+        for (std::ptrdiff_t p = begin; p < end; p += panel) {
+          const View<T> x = b.ColRange(p, std::min(p + panel, end));
+          const int width = x.GetCols();
+          const View<T> target =
+              pack ? View<T>(scratch.data(), n, width, width) : x;
+          if (pack) Copy<T>(x, target);
+          if (target.col_stride() == 1 && width >= kAxpyWidth)
+            SubstituteRows<T>(triangle, diagonal, a, target);
+          else
+            SubstituteColumns<T>(triangle, diagonal, a, target);
+          if (pack) Copy<T>(target, x);
+        }
+      });
+}
+
+template void TriangularSolve<float>(Triangle, Diagonal,
+                                     ConstView<float>, View<float>);
+template void TriangularSolve<double>(Triangle, Diagonal, ConstView<double>,
+                                      View<double>);
+template void TriangularSolve<long double>(Triangle, Diagonal,
+                                           ConstView<long double>,
+                                           View<long double>);
+
+}  // namespace s21
@@ -0,0 +1,46 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_TRIANGULAR_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_TRIANGULAR_H
+
+#include <cstddef>
+
+#include "s21_matrix.h"
+
+namespace s21 {
+
+enum class Triangle { kLower, kUpper };
+enum class Diagonal {
+  kNonUnit,
+  kUnit,  // the diagonal of A is taken as 1 and never read
+};
+
+// Size of a panel of right-hand sides, about that of L2.
+constexpr std::size_t kTriangularPanelBytes = 1 << 21;
+
+// B := A^-1 * B in place for a square triangular A, so every column of B is
+// one right-hand side. Only the given triangle of A is read, which lets the
+// packed factors of LU, Cholesky and QR be passed as they are; a transposed
+// view of a lower triangle is an upper one. B is solved in panels of
+// columns of about kTriangularPanelBytes, so the rows that substitution
+// keeps revisiting stay in L2; wide panels go row by row through the SIMD
+// axpy, narrow ones column by column as dot products. (Eliminating blocks
+// of rows with GEMM instead was measured slower: the rows of a panel
+// already stream from cache faster than the packed kernel runs.) A zero on
+// the diagonal gives infinities, so callers check for singularity first.
+// Throws like the view kernels of s21_matrix_view.h.
+template <class T>
+void TriangularSolve(Triangle triangle, Diagonal diagonal,
+                     S21BasicMatrixView<const T> a, S21BasicMatrixView<T> b);
+
+extern template void TriangularSolve<float>(Triangle, Diagonal,
+                                            S21BasicMatrixView<const float>,
+                                            S21BasicMatrixView<float>);
+extern template void TriangularSolve<double>(Triangle, Diagonal,
+                                             S21BasicMatrixView<const double>,
+                                             S21BasicMatrixView<double>);
+extern template void TriangularSolve<long double>(
+    Triangle, Diagonal, S21BasicMatrixView<const long double>,
+    S21BasicMatrixView<long double>);
+
+}  // namespace s21
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_TRIANGULAR_H
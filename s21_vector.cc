@@ -0,0 +1,323 @@
+#include "s21_vector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_gemm.h"
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Elements a dot task sums on its own. The partial sums of the blocks are
+// added in order, so the split does not depend on the thread count.
+constexpr std::ptrdiff_t kDotBlock = 1 << 14;
+
+// Runs f(begin, end) over chunks of [0, n) for an element-wise operation of
+// work operations per element.
+template <class F>
+void ForChunks(int n, std::ptrdiff_t work, F f) {
+  s21::ParallelFor(n, s21::ParallelGrain(work),
+                   [&f](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                     f(begin, static_cast<std::size_t>(end - begin));
+                   });
+}
+
+template <class T>
+T Dot(const T* a, const T* b, int n) {
+  const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+  if (n <= kDotBlock) return simd.dot(a, b, n);
+  const std::ptrdiff_t blocks = (n + kDotBlock - 1) / kDotBlock;
+  std::vector<T> partial(blocks);
+  s21::ParallelFor(blocks, 1, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t block = begin; block < end; block++) {
+      const std::ptrdiff_t first = block * kDotBlock;
+      partial[block] = simd.dot(a + first, b + first,
+                                std::min<std::ptrdiff_t>(kDotBlock, n - first));
+    }
+  });
+  T sum = T(0);
+  for (T value : partial) sum += value;
+  return sum;
+}
+
+}  // namespace
+
+template <class T>
+S21BasicVector<T>::S21BasicVector(int size)
+    : data_(S21BasicMatrix<T>::GetDefaultResource()) {
+  if (size < 1) throw std::out_of_range("Invalid vector");
+  data_.resize(size);
+}
+
+template <class T>
+S21BasicVector<T>::S21BasicVector(std::initializer_list<T> values)
+    : data_(values, S21BasicMatrix<T>::GetDefaultResource()) {
+  if (data_.empty()) throw std::out_of_range("Invalid vector");
+}
+
+template <class T>
+S21BasicVector<T>::S21BasicVector(S21BasicMatrixView<const T> matrix)
+    : data_(S21BasicMatrix<T>::GetDefaultResource()) {
+  if (matrix.GetRows() != 1 && matrix.GetCols() != 1)
+    throw std::invalid_argument("Matrix is not a vector");
+  if (matrix.GetRows() != 1) matrix = matrix.Transposed();
+  data_.resize(matrix.GetCols());
+  for (int i = 0; i < matrix.GetCols(); i++) data_[i] = matrix(0, i);
+}
+
+template <class T>
+S21BasicVector<T>::S21BasicVector(const S21BasicMatrix<T>& matrix)
+    : S21BasicVector(matrix.View()) {}
+
+template <class T>
+S21BasicVector<T>::S21BasicVector(const S21BasicVector& other)
+    : data_(other.data_, S21BasicMatrix<T>::GetDefaultResource()) {}
+
+template <class T>
+int S21BasicVector<T>::GetSize() const noexcept {
+  return static_cast<int>(data_.size());
+}
+
+template <class T>
+T& S21BasicVector<T>::operator()(int i) {
+  if (i < 0 || i >= GetSize()) throw std::out_of_range("Invalid index");
+  return data_[i];
+}
+
+template <class T>
+T S21BasicVector<T>::operator()(int i) const {
+  if (i < 0 || i >= GetSize()) throw std::out_of_range("Invalid index");
+  return data_[i];
+}
+
+template <class T>
+T* S21BasicVector<T>::data() noexcept {
+  return data_.data();
+}
+
+template <class T>
+const T* S21BasicVector<T>::data() const noexcept {
+  return data_.data();
+}
+
+template <class T>
+S21BasicMatrixView<T> S21BasicVector<T>::View() noexcept {
+  return S21BasicMatrixView<T>(data(), GetSize(), 1, 1);
+}
+
+template <class T>
+S21BasicMatrixView<const T> S21BasicVector<T>::View() const noexcept {
+  return S21BasicMatrixView<const T>(data(), GetSize(), 1, 1);
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicVector<T>::ToMatrix() const {
+  S21BasicMatrix<T> matrix(GetSize(), 1);
+  s21::Copy<T>(View(), matrix.View());
+  return matrix;
+}
+
+template <class T>
+bool S21BasicVector<T>::EqVector(const S21BasicVector& other) const noexcept {
+  return EqVector(other, S21Tolerance<T>::kEqual);
+}
+
+template <class T>
+bool S21BasicVector<T>::EqVector(const S21BasicVector& other,
+                                 T tolerance) const noexcept {
+  return GetSize() == other.GetSize() &&
+         s21::Simd<T>().equal(data(), other.data(), GetSize(), tolerance);
+}
+
+template <class T>
+T S21BasicVector<T>::Dot(const S21BasicVector& other) const {
+  _CheckSize(other);
+  return ::Dot(data(), other.data(), GetSize());
+}
+
+template <class T>
+void S21BasicVector<T>::Axpy(T alpha, const S21BasicVector& x) {
+  _CheckSize(x);
+  const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+  ForChunks(GetSize(), 2, [&](std::ptrdiff_t begin, std::size_t n) {
+    simd.axpy(alpha, x.data() + begin, data() + begin, n);
+  });
+}
+
+template <class T>
+T S21BasicVector<T>::Norm1() const noexcept {
+  T sum = T(0);
+  for (T value : data_) sum += std::fabs(value);
+  return sum;
+}
+
+template <class T>
+T S21BasicVector<T>::Norm2() const {
+  const T squares = ::Dot(data(), data(), GetSize());
+  if (std::isfinite(squares) && squares >= std::numeric_limits<T>::min())
+    return std::sqrt(squares);
+  const T scale = NormInf();
+  if (scale == T(0) || !std::isfinite(scale)) return scale;
+  T sum = T(0);
+  for (T value : data_) sum += (value / scale) * (value / scale);
+  return scale * std::sqrt(sum);
+}
+
+template <class T>
+T S21BasicVector<T>::NormInf() const noexcept {
+  T max = T(0);
+  for (T value : data_) {
+    if (std::isnan(value)) return value;
+    max = std::max(max, std::fabs(value));
+  }
+  return max;
+}
+
+template <class T>
+S21BasicVector<T> S21BasicVector<T>::operator+(
+    const S21BasicVector& other) const {
+  S21BasicVector result(*this);
+  result += other;
+  return result;
+}
+
+template <class T>
+S21BasicVector<T> S21BasicVector<T>::operator-(
+    const S21BasicVector& other) const {
+  S21BasicVector result(*this);
+  result -= other;
+  return result;
+}
+
+template <class T>
+S21BasicVector<T> S21BasicVector<T>::operator*(const T num) const {
+  S21BasicVector result(*this);
+  result *= num;
+  return result;
+}
+
+template <class T>
+S21BasicVector<T>& S21BasicVector<T>::operator+=(const S21BasicVector& other) {
+  _CheckSize(other);
+  const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+  ForChunks(GetSize(), 1, [&](std::ptrdiff_t begin, std::size_t n) {
+    simd.add(data() + begin, other.data() + begin, data() + begin, n);
+  });
+  return *this;
+}
+
+template <class T>
+S21BasicVector<T>& S21BasicVector<T>::operator-=(const S21BasicVector& other) {
+  _CheckSize(other);
+  const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+  ForChunks(GetSize(), 1, [&](std::ptrdiff_t begin, std::size_t n) {
+    simd.sub(data() + begin, other.data() + begin, data() + begin, n);
+  });
+  return *this;
+}
+
+template <class T>
+S21BasicVector<T>& S21BasicVector<T>::operator*=(const T num) {
+  const s21::BasicSimdKernels<T>& simd = s21::Simd<T>();
+  ForChunks(GetSize(), 1, [&](std::ptrdiff_t begin, std::size_t n) {
+    simd.scale(data() + begin, num, data() + begin, n);
+  });
+  return *this;
+}
+
+template <class T>
+bool S21BasicVector<T>::operator==(const S21BasicVector& other) const noexcept {
+  return EqVector(other);
+}
+
+template <class T>
+void S21BasicVector<T>::_CheckSize(const S21BasicVector& other) const {
+  if (GetSize() != other.GetSize())
+    throw std::invalid_argument("Sizes are not equal");
+}
+
+template <class T>
+S21BasicVector<T> operator*(const S21BasicMatrix<T>& matrix,
+                            const S21BasicVector<T>& vector) {
+  S21BasicVector<T> result(matrix.GetRows());
+  s21::Gemv<T>(1, matrix.View(), vector, 0, result);
+  return result;
+}
+
+template <class T>
+S21BasicVector<T> operator*(const S21BasicVector<T>& vector,
+                            const S21BasicMatrix<T>& matrix) {
+  S21BasicVector<T> result(matrix.GetCols());
+  s21::Gemv<T>(1, matrix.View().Transposed(), vector, 0, result);
+  return result;
+}
+
+namespace s21 {
+
+template <class T>
+void Gemv(T alpha, S21BasicMatrixView<const T> a, const S21BasicVector<T>& x,
+          T beta, S21BasicVector<T>& y) {
+  if (a.GetCols() != x.GetSize() || a.GetRows() != y.GetSize())
+    throw std::invalid_argument(
+        "Columns first matrix not equal rows second matrix");
+  if (&x == &y) {
+    S21BasicVector<T> result(y);
+    Gemv<T>(alpha, a, x, beta, result);
+    y = std::move(result);
+    return;
+  }
+  Gemv<T>(a.GetRows(), a.GetCols(), alpha, a.data(), a.stride(),
+          a.col_stride(), x.data(), 1, beta, y.data(), 1);
+}
+
+template <class T>
+void Ger(T alpha, const S21BasicVector<T>& x, const S21BasicVector<T>& y,
+         S21BasicMatrixView<T> a) {
+  if (a.GetRows() != x.GetSize() || a.GetCols() != y.GetSize())
+    throw std::invalid_argument("Sizes are not equal");
+  Ger<T>(a.GetRows(), a.GetCols(), alpha, x.data(), 1, y.data(), 1, a.data(),
+         a.stride(), a.col_stride());
+}
+
+template void Gemv<float>(float, S21BasicMatrixView<const float>,
+                          const S21BasicVector<float>&, float,
+                          S21BasicVector<float>&);
+template void Gemv<double>(double, S21BasicMatrixView<const double>,
+                           const S21BasicVector<double>&, double,
+                           S21BasicVector<double>&);
+template void Gemv<long double>(long double,
+                                S21BasicMatrixView<const long double>,
+                                const S21BasicVector<long double>&,
+                                long double, S21BasicVector<long double>&);
+template void Ger<float>(float, const S21BasicVector<float>&,
+                         const S21BasicVector<float>&,
+                         S21BasicMatrixView<float>);
+template void Ger<double>(double, const S21BasicVector<double>&,
+                          const S21BasicVector<double>&,
+                          S21BasicMatrixView<double>);
+template void Ger<long double>(long double, const S21BasicVector<long double>&,
+                               const S21BasicVector<long double>&,
+                               S21BasicMatrixView<long double>);
+
+}  // namespace s21
+
+template class S21BasicVector<float>;
+template class S21BasicVector<double>;
+template class S21BasicVector<long double>;
+template S21BasicVector<float> operator*(const S21BasicMatrix<float>&,
+                                         const S21BasicVector<float>&);
+template S21BasicVector<double> operator*(const S21BasicMatrix<double>&,
+                                          const S21BasicVector<double>&);
+template S21BasicVector<long double> operator*(
+    const S21BasicMatrix<long double>&, const S21BasicVector<long double>&);
+template S21BasicVector<float> operator*(const S21BasicVector<float>&,
+                                         const S21BasicMatrix<float>&);
+template S21BasicVector<double> operator*(const S21BasicVector<double>&,
+                                          const S21BasicMatrix<double>&);
+template S21BasicVector<long double> operator*(
+    const S21BasicVector<long double>&, const S21BasicMatrix<long double>&);
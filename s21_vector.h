@@ -0,0 +1,133 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_VECTOR_H
+#define CPP_S21_MATRIXPLUS_SRC_S21_VECTOR_H
+
+#include <initializer_list>
+#include <memory_resource>
+#include <vector>
+
+#include "s21_matrix.h"
+#include "s21_matrix_view.h"
+
+// Dense vector of contiguous elements, allocated from the default resource
+// of S21BasicMatrix. Dot, Axpy, Norm2 and the element-wise operations run
+// the SIMD kernels on chunks split across the thread pool; Norm1 and
+// NormInf are serial loops. A product with an S21BasicMatrix runs GEMV.
+// Results do not depend on the thread count. View() shows the vector as a
+// column, so it also takes part in the view kernels and in s21::Gemm.
+template <class T>
+class S21BasicVector {
+ public:
+  // size zeros.
+  explicit S21BasicVector(int size);
+  S21BasicVector(std::initializer_list<T> values);
+  // Copy of a single row or column.
+  explicit S21BasicVector(S21BasicMatrixView<const T> matrix);
+  explicit S21BasicVector(const S21BasicMatrix<T>& matrix);
+  S21BasicVector(const S21BasicVector& other);
+  S21BasicVector(S21BasicVector&& other) noexcept = default;
+  S21BasicVector& operator=(const S21BasicVector& other) = default;
+  S21BasicVector& operator=(S21BasicVector&& other) = default;
+  ~S21BasicVector() = default;
+
+  int GetSize() const noexcept;
+  T& operator()(int i);
+  T operator()(int i) const;
+  T* data() noexcept;
+  const T* data() const noexcept;
+  // GetSize() x 1; Transposed() gives the row.
+  S21BasicMatrixView<T> View() noexcept;
+  S21BasicMatrixView<const T> View() const noexcept;
+  S21BasicMatrix<T> ToMatrix() const;
+
+  bool EqVector(const S21BasicVector& other) const noexcept;
+  bool EqVector(const S21BasicVector& other, T tolerance) const noexcept;
+  T Dot(const S21BasicVector& other) const;
+  // *this += alpha * x.
+  void Axpy(T alpha, const S21BasicVector& x);
+  // Sum of |x_i|, the Euclidean norm and max |x_i|. Norm2 rescales when the
+  // sum of squares would overflow or underflow. A NaN element makes each
+  // of them NaN.
+  T Norm1() const noexcept;
+  T Norm2() const;
+  T NormInf() const noexcept;
+
+  S21BasicVector operator+(const S21BasicVector& other) const;
+  S21BasicVector operator-(const S21BasicVector& other) const;
+  S21BasicVector operator*(const T num) const;
+  S21BasicVector& operator+=(const S21BasicVector& other);
+  S21BasicVector& operator-=(const S21BasicVector& other);
+  S21BasicVector& operator*=(const T num);
+  bool operator==(const S21BasicVector& other) const noexcept;
+
+ private:
+  std::pmr::vector<T> data_;
+
+  void _CheckSize(const S21BasicVector& other) const;
+};
+
+template <class T>
+S21BasicVector<T> operator*(const T num, const S21BasicVector<T>& vector) {
+  return vector * num;
+}
+
+// A * x and x^T * A by GEMV.
+template <class T>
+S21BasicVector<T> operator*(const S21BasicMatrix<T>& matrix,
+                            const S21BasicVector<T>& vector);
+template <class T>
+S21BasicVector<T> operator*(const S21BasicVector<T>& vector,
+                            const S21BasicMatrix<T>& matrix);
+
+using S21Vector = S21BasicVector<double>;
+
+namespace s21 {
+
+// y := alpha * a * x + beta * y; y may be x. When beta is 0, y is not read.
+template <class T>
+void Gemv(T alpha, S21BasicMatrixView<const T> a, const S21BasicVector<T>& x,
+          T beta, S21BasicVector<T>& y);
+// a := a + alpha * x * y^T.
+template <class T>
+void Ger(T alpha, const S21BasicVector<T>& x, const S21BasicVector<T>& y,
+         S21BasicMatrixView<T> a);
+
+extern template void Gemv<float>(float, S21BasicMatrixView<const float>,
+                                 const S21BasicVector<float>&, float,
+                                 S21BasicVector<float>&);
+extern template void Gemv<double>(double, S21BasicMatrixView<const double>,
+                                  const S21BasicVector<double>&, double,
+                                  S21BasicVector<double>&);
+extern template void Gemv<long double>(
+    long double, S21BasicMatrixView<const long double>,
+    const S21BasicVector<long double>&, long double,
+    S21BasicVector<long double>&);
+extern template void Ger<float>(float, const S21BasicVector<float>&,
+                                const S21BasicVector<float>&,
+                                S21BasicMatrixView<float>);
+extern template void Ger<double>(double, const S21BasicVector<double>&,
+                                 const S21BasicVector<double>&,
+                                 S21BasicMatrixView<double>);
+extern template void Ger<long double>(long double,
+                                      const S21BasicVector<long double>&,
+                                      const S21BasicVector<long double>&,
+                                      S21BasicMatrixView<long double>);
+
+}  // namespace s21
+
+extern template class S21BasicVector<float>;
+extern template class S21BasicVector<double>;
+extern template class S21BasicVector<long double>;
+extern template S21BasicVector<float> operator*(
+    const S21BasicMatrix<float>&, const S21BasicVector<float>&);
+extern template S21BasicVector<double> operator*(
+    const S21BasicMatrix<double>&, const S21BasicVector<double>&);
+extern template S21BasicVector<long double> operator*(
+    const S21BasicMatrix<long double>&, const S21BasicVector<long double>&);
+extern template S21BasicVector<float> operator*(const S21BasicVector<float>&,
+                                                const S21BasicMatrix<float>&);
+extern template S21BasicVector<double> operator*(
+    const S21BasicVector<double>&, const S21BasicMatrix<double>&);
+extern template S21BasicVector<long double> operator*(
+    const S21BasicVector<long double>&, const S21BasicMatrix<long double>&);
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_VECTOR_H
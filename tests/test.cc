@@ -36,6 +36,64 @@ TEST(constructors, move) {
   ASSERT_EQ(movematr.GetCols(), 4);
 }
 
+TEST(constructors, copy_is_deep) {
+  S21Matrix matr(9, 9);
+  matr._FillMatrix(1);
+  S21Matrix copymatr(matr);
+  copymatr(8, 8) = -1;
+  ASSERT_EQ(matr(8, 8), 17);
+  ASSERT_NE(matr.data(), copymatr.data());
+}
+
+TEST(storage, aligned_contiguous) {
+  S21Matrix matr(5, 11);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(matr.data()) % 64, 0u);
+  ASSERT_GE(matr.stride(), matr.GetCols());
+  ASSERT_EQ(matr.stride() % 8, 0);
+  matr(3, 7) = 42;
+  ASSERT_EQ(matr.data()[3 * matr.stride() + 7], 42);
+}
+
+TEST(storage, in_place_updates) {
+  S21PoolResource pool;
+  S21Matrix matr(6, 6, &pool), matr2(6, 6, &pool);
+  matr._FillMatrix(1);
+  matr2._FillMatrix(2);
+  const double* data = matr.data();
+  std::size_t allocations = pool.GetStats().allocations;
+  matr += matr2;
+  matr -= matr2;
+  matr *= 3.;
+  matr.SumMatrix(matr);
+  matr = matr2;
+  ASSERT_EQ(matr.data(), data);
+  ASSERT_EQ(pool.GetStats().allocations, allocations);
+  ASSERT_TRUE(matr == matr2);
+}
+
+TEST(storage, set_rows_cols_amortized) {
+  S21PoolResource pool;
+  S21Matrix matr(1, 1, &pool);
+  matr(0, 0) = 7;
+  for (int n = 2; n <= 64; n++) {
+    matr.SetRows(n);
+    matr.SetCols(n);
+    matr(n - 1, n - 1) = n;
+  }
+  ASSERT_LE(pool.GetStats().allocations, 16u);
+  for (int i = 0; i < 64; i++) {
+    for (int j = 0; j < 64; j++) {
+      ASSERT_EQ(matr(i, j), i == j ? (i ? i + 1 : 7) : 0);
+    }
+  }
+  matr.SetRows(3);
+  matr.SetCols(2);
+  ASSERT_EQ(matr(0, 0), 7);
+  ASSERT_EQ(matr(1, 1), 2);
+  matr.SetCols(4);
+  ASSERT_EQ(matr(1, 3), 0);
+}
+
 //------------------------------------------------------------
 
 TEST(matrix, EqMatrix) {
@@ -619,4 +677,168 @@ TEST(operator, ifequals) {
   matr._FillMatrix(10);
   matr2._FillMatrix(10);
   ASSERT_TRUE(matr == matr2);
-}
\ No newline at end of file
+}
+//------------------------------------------------------------------
+
+static S21Matrix NaiveProduct(S21Matrix &a, S21Matrix &b) {
+  S21Matrix result(a.GetRows(), b.GetCols());
+  for (int i = 0; i < a.GetRows(); i++) {
+    for (int j = 0; j < b.GetCols(); j++) {
+      for (int n = 0; n < a.GetCols(); n++) result(i, j) += a(i, n) * b(n, j);
+    }
+  }
+  return result;
+}
+
+TEST(gemm, blocked_matches_naive) {
+  const int shapes[][3] = {{1, 1, 1},    {3, 5, 7},    {17, 9, 33},
+                           {97, 261, 5}, {130, 300, 70}, {1, 300, 1}};
+  for (const auto &shape : shapes) {
+    S21Matrix a(shape[0], shape[1]), b(shape[1], shape[2]);
+    FillPseudoRandom(a, 1);
+    FillPseudoRandom(b, 2);
+    S21Matrix expected = NaiveProduct(a, b);
+    a.MulMatrix(b);
+    ASSERT_TRUE(a.EqMatrix(expected));
+  }
+}
+
+TEST(gemm, accumulates) {
+  S21Matrix a(20, 30), b(30, 10), c(20, 10);
+  FillPseudoRandom(a, 3);
+  FillPseudoRandom(b, 4);
+  FillPseudoRandom(c, 5);
+  S21Matrix expected = NaiveProduct(a, b);
+  for (int i = 0; i < c.GetRows(); i++) {
+    for (int j = 0; j < c.GetCols(); j++) {
+      expected(i, j) = 2. * expected(i, j) + 0.5 * c(i, j);
+    }
+  }
+  S21Matrix::Gemm(2., a, b, 0.5, c);
+  ASSERT_TRUE(c.EqMatrix(expected));
+}
+
+TEST(gemm, aliased_output) {
+  S21Matrix a(16, 16);
+  FillPseudoRandom(a, 6);
+  S21Matrix expected = NaiveProduct(a, a);
+  S21Matrix::Gemm(1., a, a, 0., a);
+  ASSERT_TRUE(a.EqMatrix(expected));
+}
+
+TEST(gemm, Throw) {
+  try {
+    S21Matrix a(2, 3), b(3, 4), c(2, 3);
+    S21Matrix::Gemm(1., a, b, 0., c);
+  } catch (const std::exception &e) {
+    ASSERT_STREQ(e.what(), "Sizes are not equal");
+  }
+}
+
+//------------------------------------------------------------------
+
+TEST(expression, fused_elementwise) {
+  S21Matrix a(7, 13), b(7, 13), c(7, 13), result(7, 13);
+  FillPseudoRandom(a, 11);
+  FillPseudoRandom(b, 12);
+  FillPseudoRandom(c, 13);
+  const double *buffer = result.data();
+  result = a + b - c * 2.0;
+  ASSERT_EQ(result.data(), buffer);
+  for (int i = 0; i < 7; i++) {
+    for (int j = 0; j < 13; j++) {
+      ASSERT_EQ(result(i, j), a(i, j) + b(i, j) - c(i, j) * 2.0);
+    }
+  }
+}
+
+TEST(expression, compound_assignment) {
+  S21Matrix a(4, 4), b(4, 4), expected(4, 4);
+  a._FillMatrix(1);
+  b._FillMatrix(3);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) expected(i, j) = a(i, j) - 0.5 * b(i, j);
+  }
+  a -= 0.5 * b;
+  ASSERT_TRUE(a == expected);
+}
+
+TEST(expression, transpose_aliasing) {
+  S21Matrix a(3, 3), expected(3, 3);
+  FillPseudoRandom(a, 14);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) expected(i, j) = a(i, j) + a(j, i);
+  }
+  a = a + a.Transpose();
+  ASSERT_TRUE(a == expected);
+
+  S21Matrix wide(2, 5);
+  wide._FillMatrix(0);
+  wide = wide.Transpose() * 3.;
+  ASSERT_EQ(wide.GetRows(), 5);
+  ASSERT_EQ(wide.GetCols(), 2);
+  ASSERT_EQ(wide(4, 1), 15);
+}
+
+TEST(expression, products) {
+  S21Matrix a(6, 4), b(6, 4), c(4, 5);
+  FillPseudoRandom(a, 15);
+  FillPseudoRandom(b, 16);
+  FillPseudoRandom(c, 17);
+  S21Matrix sum = a + b, at = a.Transpose();
+  ASSERT_TRUE((a + b) * c == NaiveProduct(sum, c));
+  S21Matrix gram = a.Transpose() * b;
+  ASSERT_TRUE(gram == NaiveProduct(at, b));
+  S21Matrix shifted = a * c + a * c * 2.;
+  S21Matrix product = NaiveProduct(a, c);
+  ASSERT_TRUE(shifted == product * 3.);
+}
+
+TEST(expression, Throw) {
+  try {
+    S21Matrix a(3, 2), b(2, 3), c(3, 2);
+    c = a + b * 2.;
+  } catch (const std::exception &e) {
+    ASSERT_STREQ(e.what(), "Sizes are not equal");
+  }
+}
+
+//------------------------------------------------------------------
+
+TEST(transpose, blocked) {
+  for (int rows : {1, 5, 33, 130}) {
+    for (int cols : {1, 7, 64, 257}) {
+      S21Matrix matr(rows, cols);
+      FillPseudoRandom(matr, rows * cols);
+      S21Matrix transposed = matr.Transpose();
+      ASSERT_EQ(transposed.GetRows(), cols);
+      for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) ASSERT_EQ(transposed(j, i), matr(i, j));
+      }
+    }
+  }
+}
+
+TEST(transpose, in_place) {
+  const int shapes[][2] = {{70, 70}, {3, 3}, {9, 20}, {20, 9}, {1, 12}, {5, 3}};
+  for (const auto &shape : shapes) {
+    S21Matrix matr(shape[0], shape[1]);
+    FillPseudoRandom(matr, shape[0] + 3 * shape[1]);
+    S21Matrix expected = matr.Transpose();
+    const double *buffer = matr.data();
+    matr.TransposeInPlace();
+    ASSERT_EQ(matr.data(), buffer);
+    ASSERT_GE(matr.stride(), matr.GetCols());
+    ASSERT_TRUE(matr == expected);
+  }
+}
+
+TEST(transpose, self_assignment_in_place) {
+  S21Matrix matr(40, 40);
+  FillPseudoRandom(matr, 21);
+  S21Matrix expected = matr.Transpose();
+  const double *buffer = matr.data();
+  matr = matr.Transpose();
+  ASSERT_EQ(matr.data(), buffer);
+  ASSERT_TRUE(matr == expected);
+}
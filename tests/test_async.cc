@@ -0,0 +1,98 @@
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include "test_base.h"
+
+// Runs the enclosed test body with a global pool of the given size and
+// restores the previous one afterwards.
+class PoolGuard {
+ public:
+  explicit PoolGuard(int threads)
+      : previous_(s21::ThreadPool::Instance().GetThreadCount()) {
+    s21::ThreadPool::Instance().Configure(threads);
+  }
+  ~PoolGuard() { s21::ThreadPool::Instance().Configure(previous_); }
+
+ private:
+  int previous_;
+};
+
+TEST(async, sum_of_products) {
+  for (int threads : {1, 4}) {
+    PoolGuard pool(threads);
+    S21Matrix a(70, 50), b(50, 60), c(70, 40), d(40, 60);
+    FillPseudoRandom(a, 1);
+    FillPseudoRandom(b, 2);
+    FillPseudoRandom(c, 3);
+    FillPseudoRandom(d, 4);
+    S21AsyncMatrix result = S21AsyncMatrix(a) * S21AsyncMatrix(b) +
+                            S21AsyncMatrix(c) * S21AsyncMatrix(d);
+    ASSERT_TRUE(result.Get().EqMatrix(S21Matrix(a * b + c * d), 1e-12));
+    ASSERT_TRUE(result.IsReady());
+  }
+}
+
+TEST(async, operations) {
+  PoolGuard pool(3);
+  S21Matrix matr(20, 20), b(20, 2);
+  FillPseudoRandom(matr, 5);
+  FillPseudoRandom(b, 6);
+  for (int i = 0; i < 20; i++) matr(i, i) += 20;
+  S21AsyncMatrix async(matr);
+  S21AsyncMatrix inverse = async.InverseMatrix();
+  S21AsyncMatrix difference = (async - async.Transpose()) * 2.;
+  s21::Future<double> det = async.Determinant();
+  ASSERT_TRUE(inverse.Get().EqMatrix(matr.InverseMatrix()));
+  ASSERT_TRUE(
+      difference.Get().EqMatrix(S21Matrix((matr - matr.Transpose()) * 2.)));
+  ASSERT_DOUBLE_EQ(det.Get(), matr.Determinant());
+  ASSERT_TRUE(async.Solve(S21AsyncMatrix(b)).Get().EqMatrix(matr.Solve(b)));
+  S21Matrix small(3, 3);
+  FillPseudoRandom(small, 7);
+  ASSERT_TRUE(S21AsyncMatrix(small).CalcComplements().Get().EqMatrix(
+      small.CalcComplements()));
+}
+
+// Each branch waits for the other to start, which only works when the
+// pool runs them at the same time.
+TEST(async, independent_branches_overlap) {
+  PoolGuard pool(2);
+  std::atomic<int> started(0);
+  auto branch = [&started](int value) {
+    started++;
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (started < 2 && std::chrono::steady_clock::now() < deadline)
+      std::this_thread::yield();
+    return started == 2 ? value : -1;
+  };
+  s21::Future<int> one(1), two(2);
+  s21::Future<int> sum = s21::Then(
+      [](int a, int b) { return a + b; }, s21::Then(branch, one),
+      s21::Then(branch, two));
+  ASSERT_EQ(sum.Get(), 3);
+}
+
+TEST(async, errors_propagate) {
+  PoolGuard pool(2);
+  S21AsyncMatrix a(S21Matrix(3, 4)), b(S21Matrix(5, 6));
+  S21AsyncMatrix product = a * b;
+  S21AsyncMatrix dependent = product.Transpose() + a;
+  for (const S21AsyncMatrix &result : {product, dependent}) {
+    try {
+      result.Get();
+      FAIL();
+    } catch (const std::exception &e) {
+      ASSERT_STREQ(e.what(),
+                   "Columns first matrix not equal rows second matrix");
+    }
+  }
+  try {
+    S21AsyncMatrix(S21Matrix(3, 3)).InverseMatrix().Get();
+    FAIL();
+  } catch (const std::exception &e) {
+    ASSERT_STREQ(e.what(), "Determinant equals 0");
+  }
+}
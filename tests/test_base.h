@@ -3,6 +3,46 @@
 
 #include <gtest/gtest.h>
 
+#include "/home/juli/SH21/CPP1_s21_matrixplus-1/src/s21_async.h"
+#include "/home/juli/SH21/CPP1_s21_matrixplus-1/src/s21_cholesky.h"
+#include "/home/juli/SH21/CPP1_s21_matrixplus-1/src/s21_fixed_matrix.h"
+#include "/home/juli/SH21/CPP1_s21_matrixplus-1/src/s21_incremental_matrix.h"
+#include "/home/juli/SH21/CPP1_s21_matrixplus-1/src/s21_lazy_matrix.h"
+#include "/home/juli/SH21/CPP1_s21_matrixplus-1/src/s21_lu.h"
 #include "/home/juli/SH21/CPP1_s21_matrixplus-1/src/s21_matrix.h"
+#include "/home/juli/SH21/CPP1_s21_matrixplus-1/src/s21_matrix_batch.h"
+#include "/home/juli/SH21/CPP1_s21_matrixplus-1/src/s21_matrix_file.h"
+#include "/home/juli/SH21/CPP1_s21_matrixplus-1/src/s21_matrix_view.h"
+#include "/home/juli/SH21/CPP1_s21_matrixplus-1/src/s21_memory.h"
+#include "/home/juli/SH21/CPP1_s21_matrixplus-1/src/s21_profile.h"
+#include "/home/juli/SH21/CPP1_s21_matrixplus-1/src/s21_qr.h"
+#include "/home/juli/SH21/CPP1_s21_matrixplus-1/src/s21_simd.h"
+#include "/home/juli/SH21/CPP1_s21_matrixplus-1/src/s21_sparse_matrix.h"
+#include "/home/juli/SH21/CPP1_s21_matrixplus-1/src/s21_strassen.h"
+#include "/home/juli/SH21/CPP1_s21_matrixplus-1/src/s21_thread_pool.h"
+#include "/home/juli/SH21/CPP1_s21_matrixplus-1/src/s21_tiled_matrix.h"
+#include "/home/juli/SH21/CPP1_s21_matrixplus-1/src/s21_triangular.h"
+#include "/home/juli/SH21/CPP1_s21_matrixplus-1/src/s21_vector.h"
+
+// Fills matr with values in [-1, 1] from a fixed LCG, so every run and every
+// platform sees the same matrix for a seed.
+template <class T>
+inline void FillPseudoRandom(S21BasicMatrix<T> &matr, unsigned seed) {
+  for (int i = 0; i < matr.GetRows(); i++) {
+    for (int j = 0; j < matr.GetCols(); j++) {
+      seed = seed * 1103515245u + 12345u;
+      matr(i, j) = static_cast<T>((seed >> 16) % 2001) / 1000 - 1;
+    }
+  }
+}
+
+// FillPseudoRandom plus 2 on the diagonal, which keeps a square matrix well
+// conditioned.
+template <class T>
+inline void FillWellConditioned(S21BasicMatrix<T> &matr, unsigned seed) {
+  FillPseudoRandom(matr, seed);
+  for (int i = 0; i < matr.GetRows() && i < matr.GetCols(); i++)
+    matr(i, i) += 2;
+}
 
 #endif  // CPP_S21_MATRIXPLUS_SRC_TESTS_TEST_H
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "test_base.h"
+
+// A^T A + n I is symmetric positive definite and well conditioned.
+static S21Matrix SymmetricPositiveDefinite(int n, unsigned seed) {
+  S21Matrix a(n, n);
+  FillPseudoRandom(a, seed);
+  S21Matrix spd = a.Transpose() * a;
+  for (int i = 0; i < n; i++) spd(i, i) += n;
+  return spd;
+}
+
+TEST(cholesky, factor) {
+  for (int n : {1, 7, 64, 150}) {
+    S21Matrix spd = SymmetricPositiveDefinite(n, n);
+    S21Cholesky cholesky(spd);
+    ASSERT_TRUE(cholesky.IsPositiveDefinite());
+    S21Matrix l = cholesky.GetFactor();
+    for (int i = 0; i < n; i++) {
+      ASSERT_GT(l(i, i), 0);
+      for (int j = i + 1; j < n; j++) ASSERT_EQ(l(i, j), 0);
+    }
+    ASSERT_TRUE((l * l.Transpose()).EqMatrix(spd, 1e-10 * n));
+  }
+  S21Matrix spd = SymmetricPositiveDefinite(20, 1);
+  ASSERT_NEAR(S21Cholesky(spd).Determinant() / spd.Determinant(), 1., 1e-10);
+}
+
+TEST(cholesky, solve_multiple_rhs) {
+  S21Matrix spd = SymmetricPositiveDefinite(130, 1), x(130, 4);
+  FillPseudoRandom(x, 2);
+  S21Matrix b = spd * x;
+  ASSERT_TRUE(spd.SolveCholesky(b).EqMatrix(x, 1e-10));
+  S21Cholesky cholesky(spd);
+  S21Matrix product = spd * cholesky.Inverse();
+  for (int i = 0; i < 130; i++) {
+    for (int j = 0; j < 130; j++)
+      ASSERT_NEAR(product(i, j), i == j ? 1. : 0., 1e-12);
+  }
+}
+
+TEST(cholesky, reads_lower_triangle) {
+  S21Matrix spd = SymmetricPositiveDefinite(70, 3), x(70, 1);
+  FillPseudoRandom(x, 4);
+  S21Matrix b = spd * x;
+  for (int i = 0; i < 70; i++) {
+    for (int j = i + 1; j < 70; j++) spd(i, j) = 1e6;
+  }
+  ASSERT_TRUE(S21Cholesky(spd).Solve(b).EqMatrix(x, 1e-10));
+}
+
+TEST(cholesky, not_positive_definite) {
+  S21Matrix matr(3, 3);
+  matr(0, 0) = 4;
+  matr(1, 1) = -1;
+  matr(2, 2) = 2;
+  S21Cholesky cholesky(matr);
+  ASSERT_FALSE(cholesky.IsPositiveDefinite());
+  try {
+    cholesky.Solve(matr);
+    FAIL();
+  } catch (const std::exception &e) {
+    ASSERT_STREQ(e.what(), "Matrix is not positive definite");
+  }
+}
+
+TEST(cholesky, update_and_downdate) {
+  S21Matrix spd = SymmetricPositiveDefinite(90, 5), u(90, 1);
+  FillPseudoRandom(u, 6);
+  S21Cholesky cholesky(spd);
+  ASSERT_TRUE(cholesky.Update(u));
+  S21Matrix l = cholesky.GetFactor();
+  ASSERT_TRUE((l * l.Transpose()).EqMatrix(spd + u * u.Transpose(), 1e-10));
+  for (int i = 0; i < 90; i++) {
+    for (int j = i + 1; j < 90; j++) ASSERT_EQ(l(i, j), 0);
+  }
+  ASSERT_TRUE(cholesky.Downdate(u));
+  ASSERT_TRUE(S21Matrix(cholesky.GetFactor())
+                  .EqMatrix(S21Cholesky(spd).GetFactor(), 1e-10));
+}
+
+TEST(cholesky, downdate_to_indefinite) {
+  S21Matrix matr(3, 3), u(3, 1);
+  matr(0, 0) = matr(1, 1) = matr(2, 2) = 1;
+  u(1, 0) = 2;
+  S21Cholesky cholesky(matr);
+  ASSERT_FALSE(cholesky.Downdate(u));
+  ASSERT_FALSE(cholesky.IsPositiveDefinite());
+  try {
+    cholesky.Update(u);
+    FAIL();
+  } catch (const std::exception &e) {
+    ASSERT_STREQ(e.what(), "Matrix is not positive definite");
+  }
+}
+
+TEST(cholesky, Throw) {
+  try {
+    S21Matrix matr(3, 2);
+    S21Cholesky cholesky(matr);
+  } catch (const std::exception &e) {
+    ASSERT_STREQ(e.what(), "Matrix is not square");
+  }
+}
@@ -0,0 +1,126 @@
+#include <thread>
+#include <vector>
+
+#include "test_base.h"
+
+// Turns copy-on-write on for one test and restores the setting afterwards.
+class CopyOnWrite {
+ public:
+  CopyOnWrite() : enabled_(S21Matrix::SetCopyOnWrite(true)) {}
+  ~CopyOnWrite() { S21Matrix::SetCopyOnWrite(enabled_); }
+
+ private:
+  bool enabled_;
+};
+
+TEST(copy_on_write, copy_shares_until_written) {
+  CopyOnWrite cow;
+  S21Matrix a(20, 30);
+  FillPseudoRandom(a, 1);
+  const S21Matrix &ca = a;
+  S21Matrix b(a);
+  const S21Matrix &cb = b;
+  ASSERT_EQ(ca.data(), cb.data());
+  ASSERT_TRUE(a.IsShared());
+  ASSERT_TRUE(b.IsShared());
+  const double before = ca.data()[0];
+  b(0, 0) = before + 1;
+  ASSERT_NE(ca.data(), cb.data());
+  ASSERT_FALSE(a.IsShared());
+  ASSERT_FALSE(b.IsShared());
+  ASSERT_EQ(ca.data()[0], before);
+  ASSERT_EQ(cb.data()[0], before + 1);
+  for (int j = 1; j < 30; j++) ASSERT_EQ(a(19, j), b(19, j));
+}
+
+TEST(copy_on_write, mutators_detach) {
+  CopyOnWrite cow;
+  S21Matrix a(9, 9), other(9, 9);
+  FillPseudoRandom(a, 2);
+  FillPseudoRandom(other, 3);
+  const S21Matrix original(a);
+  S21ConstMatrixView view = original.View();
+  S21Matrix sum(a), scaled(a), grown(a), assigned(a), transposed(a);
+  sum.SumMatrix(other);
+  scaled.MulNumber(2.);
+  grown.SetRows(12);
+  assigned = a + other;
+  transposed = transposed.Transpose();
+  a.TransposeInPlace();
+  ASSERT_TRUE(sum == assigned);
+  ASSERT_TRUE(a == transposed);
+  ASSERT_EQ(grown(11, 8), 0);
+  for (int i = 0; i < 9; i++) {
+    for (int j = 0; j < 9; j++) {
+      ASSERT_EQ(sum(i, j), view(i, j) + other(i, j));
+      ASSERT_EQ(scaled(i, j), view(i, j) * 2.);
+      ASSERT_EQ(grown(i, j), view(i, j));
+      ASSERT_EQ(transposed(j, i), view(i, j));
+    }
+  }
+  ASSERT_FALSE(original.IsShared());
+}
+
+TEST(copy_on_write, assignment_and_move) {
+  CopyOnWrite cow;
+  S21Matrix a(6, 7), b(2, 2);
+  FillPseudoRandom(a, 4);
+  b = a;
+  const S21Matrix &ca = a, &cb = b;
+  ASSERT_EQ(ca.data(), cb.data());
+  S21Matrix moved(std::move(b));
+  ASSERT_EQ(static_cast<const S21Matrix &>(moved).data(), ca.data());
+  ASSERT_TRUE(a.IsShared());
+  moved = S21Matrix(1, 1);
+  ASSERT_FALSE(a.IsShared());
+
+  // A copy into another resource is deep, and the resource is kept.
+  S21PoolResource pool;
+  S21Matrix pooled(3, 3, &pool);
+  pooled = a;
+  ASSERT_EQ(pooled.GetResource(), &pool);
+  ASSERT_NE(static_cast<const S21Matrix &>(pooled).data(), ca.data());
+  ASSERT_TRUE(pooled == a);
+}
+
+TEST(copy_on_write, off_copies_deeply) {
+  S21Matrix a(4, 4);
+  a._FillMatrix(1);
+  {
+    CopyOnWrite cow;
+    S21Matrix::SetCopyOnWrite(false);
+    S21Matrix b(a);
+    ASSERT_FALSE(a.IsShared());
+  }
+  CopyOnWrite cow;
+  // A buffer allocated while the mode was off has no count to share.
+  S21Matrix b(a);
+  ASSERT_FALSE(a.IsShared());
+  ASSERT_TRUE(b == a);
+}
+
+TEST(copy_on_write, shared_across_threads) {
+  CopyOnWrite cow;
+  S21Matrix a(64, 64);
+  FillPseudoRandom(a, 5);
+  const S21Matrix expected = a.Transpose();
+  std::vector<S21Matrix> copies(4, a);
+  std::vector<double> sums(copies.size());
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < copies.size(); t++) {
+    threads.emplace_back([&, t] {
+      const S21Matrix &copy = copies[t];
+      double sum = 0;
+      for (int i = 0; i < 64; i++) {
+        for (int j = 0; j < 64; j++) sum += copy.data()[i * copy.stride() + j];
+      }
+      sums[t] = sum;
+      copies[t].Transpose();
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+  for (std::size_t t = 1; t < copies.size(); t++) ASSERT_EQ(sums[t], sums[0]);
+  copies.clear();
+  ASSERT_FALSE(a.IsShared());
+  ASSERT_TRUE(expected == S21Matrix(a.Transpose()));
+}
@@ -0,0 +1,70 @@
+#include "test_base.h"
+
+// Evaluated by the compiler; a failure here is a build error.
+constexpr S21Matrix3 kRotation{0, -1, 0, 1, 0, 0, 0, 0, 1};
+static_assert(kRotation.Determinant() == 1.);
+static_assert((kRotation * kRotation.Transpose()) == S21Matrix3::Identity());
+static_assert(kRotation.InverseMatrix() == kRotation.Transpose());
+static_assert(S21FixedMatrix<2, 3>{1, 2, 3, 4, 5, 6}.Transpose()(2, 1) == 6.);
+
+template <int N>
+static void CheckAgainstDynamic(unsigned seed) {
+  S21Matrix dynamic(N, N), other(N, N);
+  FillWellConditioned(dynamic, seed);
+  FillWellConditioned(other, seed + 1);
+  S21FixedMatrix<N, N> fixed(dynamic), fixed_other(other);
+  ASSERT_NEAR(fixed.Determinant(), dynamic.Determinant(), 1e-12);
+  ASSERT_TRUE(fixed.InverseMatrix().ToMatrix() == dynamic.InverseMatrix());
+  ASSERT_TRUE(fixed.CalcComplements().ToMatrix() == dynamic.CalcComplements());
+  S21Matrix transposed = dynamic.Transpose();
+  ASSERT_TRUE(fixed.Transpose().ToMatrix() == transposed);
+  S21Matrix sum = dynamic + other;
+  ASSERT_TRUE((fixed + fixed_other).ToMatrix() == sum);
+  S21Matrix product = dynamic * other;
+  fixed *= fixed_other;
+  ASSERT_TRUE(fixed.ToMatrix() == product);
+}
+
+TEST(fixed_matrix, matches_dynamic) {
+  CheckAgainstDynamic<1>(1);
+  CheckAgainstDynamic<2>(2);
+  CheckAgainstDynamic<3>(3);
+  CheckAgainstDynamic<4>(4);
+  CheckAgainstDynamic<5>(5);
+  CheckAgainstDynamic<7>(6);
+}
+
+TEST(fixed_matrix, rectangular_product) {
+  S21Matrix a(2, 3), b(3, 4);
+  FillWellConditioned(a, 7);
+  FillWellConditioned(b, 8);
+  S21FixedMatrix<2, 4> product =
+      S21FixedMatrix<2, 3>(a) * S21FixedMatrix<3, 4>(b);
+  S21Matrix expected = a * b;
+  ASSERT_TRUE(product.ToMatrix() == expected);
+}
+
+TEST(fixed_matrix, float_elements) {
+  S21FixedMatrix<2, 2, float> matr{1.f, 2.f, 3.f, 4.f};
+  ASSERT_FLOAT_EQ(matr.Determinant(), -2.f);
+  ASSERT_FLOAT_EQ(matr.InverseMatrix()(1, 0), 1.5f);
+  matr *= 2.f;
+  ASSERT_FLOAT_EQ(matr(1, 1), 8.f);
+  S21FixedMatrix<2, 2, float> close = matr;
+  close(0, 0) += 5e-5f;
+  ASSERT_TRUE(close == matr);
+  ASSERT_FALSE(close.EqMatrix(matr, 1e-5f));
+  static_assert(S21Matrix2{1, 2}.EqMatrix(S21Matrix2{1.5, 2}, 0.5));
+  ASSERT_TRUE(matr * 2 == 2 * matr);
+  static_assert(S21Matrix2{1, 2} * 3 == S21Matrix2{3, 6});
+}
+
+TEST(fixed_matrix, throws) {
+  S21Matrix4 singular{1, 2, 3, 4, 2, 4, 6, 8};
+  ASSERT_EQ(singular.Determinant(), 0.);
+  ASSERT_THROW(singular.InverseMatrix(), std::invalid_argument);
+  ASSERT_THROW(singular(4, 0), std::out_of_range);
+  S21Matrix wrong(3, 4);
+  ASSERT_THROW(S21Matrix3 converted(wrong), std::invalid_argument);
+  ASSERT_THROW((S21Matrix2{1, 2, 3, 4, 5}), std::out_of_range);
+}
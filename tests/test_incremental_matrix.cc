@@ -0,0 +1,138 @@
+#include "test_base.h"
+
+static void FillDiagonallyDominant(S21Matrix &matr, unsigned seed,
+                                   int diagonal) {
+  FillPseudoRandom(matr, seed);
+  if (diagonal < 0) return;
+  for (int i = 0; i < matr.GetRows(); i++)
+    matr(i, diagonal + i) += 2 * matr.GetCols();
+}
+
+static void ExpectCurrent(S21IncrementalMatrix &incremental) {
+  const S21Matrix &matr = incremental.GetMatrix();
+  const int n = matr.GetRows();
+  const double tolerance = 1e-13 * incremental.ConditionEstimate();
+  S21LU lu(matr);
+  ASSERT_NEAR(incremental.Determinant() / lu.Determinant(), 1., 1e-10);
+  ASSERT_TRUE(incremental.Inverse().EqMatrix(lu.Inverse(), tolerance));
+  S21Matrix x(n, 1);
+  FillDiagonallyDominant(x, n, -1);
+  ASSERT_TRUE(incremental.Solve(matr * x).EqMatrix(x, tolerance));
+}
+
+TEST(incremental_matrix, set_rows_and_cols) {
+  const int n = 60;
+  S21Matrix matr(n, n);
+  FillDiagonallyDominant(matr, 1, 0);
+  S21IncrementalMatrix incremental(matr);
+  incremental.Inverse();
+  for (int step = 0; step < 40; step++) {
+    const int index = step * 7 % n;
+    if (step % 2 == 0) {
+      S21Matrix row(1, n);
+      FillDiagonallyDominant(row, step + 2, -1);
+      row(0, index) += 2 * n;
+      incremental.SetRow(index, row);
+      for (int j = 0; j < n; j++) matr(index, j) = row(0, j);
+    } else {
+      S21Matrix col(n, 1);
+      FillDiagonallyDominant(col, step + 2, -1);
+      col(index, 0) += 2 * n;
+      incremental.SetCol(index, col);
+      for (int i = 0; i < n; i++) matr(i, index) = col(i, 0);
+    }
+    ASSERT_TRUE(incremental.GetMatrix().EqMatrix(matr, 0));
+    ExpectCurrent(incremental);
+  }
+  ASSERT_EQ(incremental.GetFactorizations(), 1);
+}
+
+TEST(incremental_matrix, rank_k_update) {
+  const int n = 50;
+  S21Matrix matr(n, n), u(n, 3), v(n, 3);
+  FillDiagonallyDominant(matr, 1, 0);
+  FillDiagonallyDominant(u, 2, -1);
+  FillDiagonallyDominant(v, 3, -1);
+  S21IncrementalMatrix incremental(matr);
+  incremental.Update(u, v);
+  ASSERT_TRUE(incremental.GetMatrix().EqMatrix(matr + u * v.Transpose()));
+  ExpectCurrent(incremental);
+  incremental.Update(u, v);
+  ExpectCurrent(incremental);
+  ASSERT_EQ(incremental.GetFactorizations(), 1);
+}
+
+TEST(incremental_matrix, refactorizes) {
+  const int n = 8;
+  S21Matrix matr(n, n), row(1, n);
+  FillDiagonallyDominant(matr, 1, 0);
+  S21IncrementalMatrix incremental(matr);
+  for (int i = 0; i < n; i++) {
+    FillDiagonallyDominant(row, i + 2, -1);
+    row(0, i) += 2 * n;
+    incremental.SetRow(i, row);
+  }
+  ASSERT_EQ(incremental.GetFactorizations(), 2);
+  ExpectCurrent(incremental);
+
+  // Two equal rows make the matrix singular; restoring one recovers it.
+  const S21ConstMatrixView current = incremental.GetMatrix().View();
+  S21Matrix saved(current.RowRange(1, 2));
+  for (int j = 0; j < n; j++) row(0, j) = current(0, j);
+  incremental.SetRow(1, row);
+  ASSERT_NEAR(incremental.Determinant(), 0., 1e-6);
+  ASSERT_TRUE(incremental.GetLU().IsSingular());
+  try {
+    incremental.Inverse();
+    FAIL();
+  } catch (const std::exception &e) {
+    ASSERT_STREQ(e.what(), "Determinant equals 0");
+  }
+  incremental.SetRow(1, saved);
+  ASSERT_FALSE(incremental.GetLU().IsSingular());
+  ExpectCurrent(incremental);
+}
+
+TEST(incremental_matrix, condition_drift) {
+  const int n = 40;
+  S21Matrix matr(n, n), col(n, 1);
+  FillDiagonallyDominant(matr, 1, 0);
+  S21IncrementalMatrix incremental(matr);
+  const double condition = incremental.ConditionEstimate();
+  for (int i = 0; i < n; i++) col(i, 0) = matr(i, 3) * 1e-5;
+  incremental.SetCol(3, col);
+  ASSERT_EQ(incremental.GetFactorizations(), 2);
+  ASSERT_GT(incremental.ConditionEstimate(),
+            S21IncrementalMatrix::kConditionDrift * condition);
+  ExpectCurrent(incremental);
+}
+
+TEST(incremental_matrix, Throw) {
+  S21Matrix matr(4, 4), wide(4, 2), narrow(4, 1), row(1, 3);
+  FillDiagonallyDominant(matr, 1, 0);
+  S21IncrementalMatrix incremental(matr);
+  try {
+    incremental.Update(wide, narrow);
+    FAIL();
+  } catch (const std::exception &e) {
+    ASSERT_STREQ(e.what(), "Sizes are not equal");
+  }
+  try {
+    incremental.SetRow(4, narrow.View().Transposed());
+    FAIL();
+  } catch (const std::exception &e) {
+    ASSERT_STREQ(e.what(), "Invalid index");
+  }
+  try {
+    incremental.SetRow(0, row);
+    FAIL();
+  } catch (const std::exception &e) {
+    ASSERT_STREQ(e.what(), "Sizes are not equal");
+  }
+  try {
+    S21IncrementalMatrix rectangular(wide);
+    FAIL();
+  } catch (const std::exception &e) {
+    ASSERT_STREQ(e.what(), "Matrix is not square");
+  }
+}
@@ -0,0 +1,85 @@
+#include <stdexcept>
+
+#include "test_base.h"
+
+TEST(lazy_matrix, chain_order) {
+  S21Matrix a(200, 200), b(200, 200), v(200, 1);
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(b, 2);
+  FillPseudoRandom(v, 3);
+  S21LazyMatrix product = S21LazyMatrix(a) * b * v;
+  ASSERT_DOUBLE_EQ(product.Flops(), 2. * (2. * 200 * 200 * 1));
+  ASSERT_TRUE(product.Evaluate().EqMatrix(S21Matrix(a * b * v), 1e-10));
+  S21LazyMatrix row = S21LazyMatrix(v).Transpose() * a * b;
+  ASSERT_DOUBLE_EQ(row.Flops(), 2. * (2. * 200 * 200 * 1));
+  ASSERT_TRUE(row.Evaluate().EqMatrix(S21Matrix(v.Transpose() * a * b),
+                                      1e-10));
+}
+
+TEST(lazy_matrix, scalars_and_transposes) {
+  S21Matrix a(30, 20), b(30, 40), c(20, 40), d(40, 20);
+  FillPseudoRandom(a, 4);
+  FillPseudoRandom(b, 5);
+  FillPseudoRandom(c, 6);
+  FillPseudoRandom(d, 7);
+  S21LazyMatrix lazy =
+      (S21LazyMatrix(a).Transpose() * 2. * b -
+       3. * (c - S21LazyMatrix(d).Transpose())) *
+      0.5;
+  S21Matrix expected((a.Transpose() * 2. * b - (c - d.Transpose()) * 3.) *
+                     0.5);
+  ASSERT_DOUBLE_EQ(lazy.Flops(), 2. * 20 * 40 * 30);
+  ASSERT_TRUE(lazy.Evaluate().EqMatrix(expected, 1e-12));
+  S21LazyMatrix transposed = (a * S21LazyMatrix(d).Transpose()).Transpose();
+  ASSERT_TRUE(transposed.Evaluate().EqMatrix(S21Matrix(d * a.Transpose()),
+                                             1e-12));
+}
+
+TEST(lazy_matrix, common_subexpressions) {
+  const int n = 40;
+  S21Matrix a(n, n), b(n, n), c(n, n);
+  FillPseudoRandom(a, 8);
+  FillPseudoRandom(b, 9);
+  FillPseudoRandom(c, 10);
+  S21LazyMatrix ab = S21LazyMatrix(a) * b;
+  S21LazyMatrix symmetric = ab + ab.Transpose() * 2.;
+  ASSERT_DOUBLE_EQ(symmetric.Flops(), 2. * n * n * n);
+  S21Matrix product(a * b);
+  ASSERT_TRUE(symmetric.Evaluate().EqMatrix(
+      S21Matrix(product + product.Transpose() * 2.), 1e-12));
+  S21LazyMatrix bt_at =
+      S21LazyMatrix(b).Transpose() * S21LazyMatrix(a).Transpose();
+  ASSERT_DOUBLE_EQ((ab - bt_at.Transpose()).Flops(), 2. * n * n * n);
+  ASSERT_TRUE((ab - bt_at.Transpose()).Evaluate().EqMatrix(S21Matrix(n, n)));
+  // A B is computed once and squared.
+  ASSERT_DOUBLE_EQ((ab * ab).Flops(), 2 * 2. * n * n * n);
+  ASSERT_TRUE((ab * ab).Evaluate().EqMatrix(S21Matrix(product * product),
+                                            1e-12));
+  S21LazyMatrix sum = S21LazyMatrix(a) + b;
+  S21LazyMatrix twice = sum * c + c * sum;
+  ASSERT_DOUBLE_EQ(twice.Flops(), 2 * 2. * n * n * n);
+  ASSERT_TRUE(twice.Evaluate().EqMatrix(
+      S21Matrix(S21Matrix(a + b) * c + c * S21Matrix(a + b)), 1e-12));
+  // A + B is materialized once for both of its uses; the products go
+  // straight into the result.
+  S21LazyMatrix turned = sum * c + c * sum.Transpose();
+  S21PoolResource pool;
+  S21Matrix evaluated;
+  {
+    S21ResourceScope scope(&pool);
+    evaluated = turned.Evaluate();
+  }
+  ASSERT_EQ(pool.GetStats().allocations, 2u);
+  ASSERT_TRUE(evaluated.EqMatrix(
+      S21Matrix(S21Matrix(a + b) * c + c * S21Matrix(a + b).Transpose()),
+      1e-12));
+}
+
+TEST(lazy_matrix, errors) {
+  S21Matrix a(3, 4), b(5, 6);
+  ASSERT_THROW(S21LazyMatrix(a) + b, std::invalid_argument);
+  ASSERT_THROW(S21LazyMatrix(a) - b, std::invalid_argument);
+  ASSERT_THROW(S21LazyMatrix(a) * b, std::invalid_argument);
+  S21Matrix c(3, 2);
+  ASSERT_NO_THROW(S21LazyMatrix(a).Transpose() * c);
+}
@@ -0,0 +1,108 @@
+#include "test_base.h"
+
+static void FillDiagonallyDominant(S21Matrix &matr, unsigned seed) {
+  FillPseudoRandom(matr, seed);
+  for (int i = 0; i < matr.GetRows(); i++) matr(i, i) += matr.GetCols();
+}
+
+static bool IsIdentity(S21Matrix &matr, double tolerance) {
+  for (int i = 0; i < matr.GetRows(); i++) {
+    for (int j = 0; j < matr.GetCols(); j++) {
+      if (fabs(matr(i, j) - (i == j ? 1. : 0.)) > tolerance) return false;
+    }
+  }
+  return true;
+}
+
+TEST(lu, determinant_of_triangular) {
+  S21Matrix matr(70, 70);
+  double expected = 1;
+  for (int i = 0; i < 70; i++) {
+    for (int j = i; j < 70; j++) matr(i, j) = 0.25 * (j - i) + 1;
+    matr(i, i) = (i % 3) ? 1.5 : -0.5;
+    expected *= matr(i, i);
+  }
+  S21Matrix transposed = matr.Transpose();
+  ASSERT_NEAR(matr.Determinant() / expected, 1., 1e-12);
+  ASSERT_NEAR(transposed.Determinant() / expected, 1., 1e-12);
+}
+
+TEST(lu, pivoting) {
+  S21Matrix matr(2, 2);
+  matr(0, 1) = 1;
+  matr(1, 0) = 1;
+  S21LU lu(matr);
+  ASSERT_FALSE(lu.IsSingular());
+  ASSERT_EQ(lu.GetPivots()[0], 1);
+  ASSERT_EQ(lu.Determinant(), -1);
+}
+
+TEST(lu, inverse_blocked) {
+  for (int n : {5, 64, 150}) {
+    S21Matrix matr(n, n);
+    FillDiagonallyDominant(matr, n);
+    S21Matrix product = matr * matr.InverseMatrix();
+    ASSERT_TRUE(IsIdentity(product, 1e-12));
+  }
+}
+
+TEST(lu, solve_multiple_rhs) {
+  S21Matrix matr(90, 90), x(90, 3);
+  FillDiagonallyDominant(matr, 7);
+  for (int i = 0; i < 90; i++) {
+    for (int j = 0; j < 3; j++) x(i, j) = i - 10. * j;
+  }
+  S21Matrix b = matr * x;
+  S21Matrix solved = matr.Solve(b);
+  ASSERT_TRUE(solved.EqMatrix(x));
+}
+
+TEST(lu, singular) {
+  S21Matrix matr(3, 3);
+  matr._FillMatrix(1);
+  S21LU lu(matr);
+  ASSERT_TRUE(lu.IsSingular());
+  try {
+    lu.Solve(matr);
+  } catch (const std::exception &e) {
+    ASSERT_STREQ(e.what(), "Determinant equals 0");
+  }
+}
+
+TEST(lu, rank_one_update) {
+  S21Matrix matr(100, 100), u(100, 1), v(100, 1), x(100, 2);
+  FillDiagonallyDominant(matr, 1);
+  FillPseudoRandom(u, 2);
+  FillPseudoRandom(v, 3);
+  FillPseudoRandom(x, 4);
+  S21LU lu(matr);
+  ASSERT_TRUE(lu.Update(u, v));
+  S21Matrix updated = matr + u * v.Transpose();
+  ASSERT_TRUE(lu.Solve(updated * x).EqMatrix(x, 1e-10));
+  ASSERT_NEAR(lu.Determinant() / S21LU(updated).Determinant(), 1., 1e-10);
+}
+
+TEST(lu, update_to_singular) {
+  S21Matrix matr(2, 2), u(2, 1), v(2, 1);
+  matr(0, 0) = matr(1, 1) = 1;
+  u(0, 0) = -1;
+  v(0, 0) = 1;
+  S21LU lu(matr);
+  ASSERT_FALSE(lu.Update(u, v));
+  ASSERT_TRUE(lu.IsSingular());
+  try {
+    lu.Update(u, matr);
+    FAIL();
+  } catch (const std::exception &e) {
+    ASSERT_STREQ(e.what(), "Sizes are not equal");
+  }
+}
+
+TEST(lu, Throw) {
+  try {
+    S21Matrix matr(3, 2);
+    S21LU lu(matr);
+  } catch (const std::exception &e) {
+    ASSERT_STREQ(e.what(), "Matrix is not square");
+  }
+}
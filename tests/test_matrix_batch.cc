@@ -0,0 +1,136 @@
+#include <vector>
+
+#include "test_base.h"
+
+static std::vector<S21Matrix> RandomMatrices(int count, int rows, int cols,
+                                             unsigned seed) {
+  std::vector<S21Matrix> matrices;
+  for (int index = 0; index < count; index++) {
+    S21Matrix matr(rows, cols);
+    FillPseudoRandom(matr, seed + index);
+    matrices.push_back(matr);
+  }
+  return matrices;
+}
+
+TEST(matrix_batch, layout) {
+  std::vector<S21Matrix> matrices = RandomMatrices(5, 2, 3, 1);
+  S21MatrixBatch batch(matrices);
+  ASSERT_EQ(batch.GetCount(), 5);
+  ASSERT_EQ(batch.GetRows(), 2);
+  ASSERT_EQ(batch.GetCols(), 3);
+  ASSERT_EQ(&batch(4, 1, 2), batch.Lane(1, 2) + 4);
+  ASSERT_GE(batch.LaneStride(), 5);
+  ASSERT_EQ(batch.Lane(0, 1), batch.Lane(0, 0) + batch.LaneStride());
+  ASSERT_EQ(S21MatrixBatch(512, 1, 1).LaneStride() % 512, 8);
+  for (int index = 0; index < 5; index++) {
+    ASSERT_TRUE(batch.Get(index) == matrices[index]);
+  }
+  batch.Set(2, matrices[0]);
+  ASSERT_TRUE(batch.Get(2) == matrices[0]);
+  S21MatrixBatch copy(batch);
+  ASSERT_TRUE(copy == batch);
+  copy(0, 0, 0) += 1;
+  ASSERT_FALSE(copy == batch);
+}
+
+// Counts around multiples of the SIMD width and of the lane block.
+TEST(matrix_batch, element_wise) {
+  for (int count : {1, 7, 64, 131}) {
+    std::vector<S21Matrix> a = RandomMatrices(count, 3, 4, 2);
+    std::vector<S21Matrix> b = RandomMatrices(count, 3, 4, 900);
+    S21MatrixBatch sum(a), difference(a), scaled(a), other(b);
+    sum += other;
+    difference -= other;
+    scaled *= 0.25;
+    for (int index = 0; index < count; index++) {
+      S21Matrix expected_sum = a[index] + b[index];
+      S21Matrix expected_difference = a[index] - b[index];
+      S21Matrix expected_scaled = a[index] * 0.25;
+      ASSERT_TRUE(sum.Get(index) == expected_sum);
+      ASSERT_TRUE(difference.Get(index) == expected_difference);
+      ASSERT_TRUE(scaled.Get(index) == expected_scaled);
+    }
+  }
+}
+
+TEST(matrix_batch, mul_batch) {
+  for (int count : {1, 9, 130}) {
+    std::vector<S21Matrix> a = RandomMatrices(count, 3, 5, 3);
+    std::vector<S21Matrix> b = RandomMatrices(count, 5, 2, 400);
+    S21MatrixBatch product(a);
+    product *= S21MatrixBatch(b);
+    ASSERT_EQ(product.GetRows(), 3);
+    ASSERT_EQ(product.GetCols(), 2);
+    for (int index = 0; index < count; index++) {
+      S21Matrix expected = a[index] * b[index];
+      ASSERT_TRUE(product.Get(index).EqMatrix(expected, 1e-12));
+    }
+  }
+}
+
+TEST(matrix_batch, determinant_matches_matrix) {
+  for (int n : {1, 2, 3, 4, 6, 9}) {
+    std::vector<S21Matrix> matrices = RandomMatrices(70, n, n, n * 100);
+    std::vector<double> det = S21MatrixBatch(matrices).DeterminantBatch();
+    ASSERT_EQ(det.size(), 70u);
+    for (int index = 0; index < 70; index++) {
+      ASSERT_EQ(det[index], matrices[index].Determinant());
+    }
+  }
+  S21MatrixBatch singular(3, 2, 2);
+  singular(1, 0, 0) = 1;
+  singular(1, 1, 1) = 2;
+  std::vector<double> det = singular.DeterminantBatch();
+  ASSERT_EQ(det[0], 0.);
+  ASSERT_EQ(det[1], 2.);
+}
+
+TEST(matrix_batch, inverse_matches_matrix) {
+  for (int n : {1, 2, 4, 7}) {
+    std::vector<S21Matrix> matrices = RandomMatrices(67, n, n, n * 10);
+    for (S21Matrix &matr : matrices) {
+      for (int i = 0; i < n; i++) matr(i, i) += 3;
+    }
+    S21MatrixBatch inverse = S21MatrixBatch(matrices).InverseBatch();
+    for (int index = 0; index < 67; index++) {
+      ASSERT_TRUE(inverse.Get(index).EqMatrix(
+          matrices[index].InverseMatrix(), 1e-12));
+    }
+  }
+  std::vector<S21Matrix> matrices = RandomMatrices(4, 3, 3, 5);
+  matrices[2].MulNumber(0);
+  ASSERT_THROW(S21MatrixBatch(matrices).InverseBatch(),
+               std::invalid_argument);
+}
+
+TEST(matrix_batch, float_elements) {
+  S21FloatMatrixBatch batch(20, 2, 2);
+  for (int index = 0; index < 20; index++) {
+    batch(index, 0, 0) = index + 1.f;
+    batch(index, 1, 1) = 2.f;
+    batch(index, 0, 1) = 1.f;
+  }
+  std::vector<float> det = batch.DeterminantBatch();
+  S21FloatMatrixBatch inverse = batch.InverseBatch();
+  for (int index = 0; index < 20; index++) {
+    ASSERT_FLOAT_EQ(det[index], 2.f * (index + 1));
+    ASSERT_FLOAT_EQ(inverse(index, 0, 0), 1.f / (index + 1));
+  }
+}
+
+TEST(matrix_batch, throws) {
+  ASSERT_THROW(S21MatrixBatch(0, 2, 2), std::out_of_range);
+  ASSERT_THROW(S21MatrixBatch(std::vector<S21Matrix>()), std::out_of_range);
+  std::vector<S21Matrix> mixed = RandomMatrices(2, 2, 2, 1);
+  mixed.push_back(S21Matrix(3, 3));
+  ASSERT_THROW(S21MatrixBatch batch(mixed), std::invalid_argument);
+  S21MatrixBatch a(4, 2, 3), b(4, 2, 3), c(5, 2, 3);
+  ASSERT_THROW(a.SumBatch(c), std::invalid_argument);
+  ASSERT_THROW(a.MulBatch(b), std::invalid_argument);
+  ASSERT_THROW(a.DeterminantBatch(), std::invalid_argument);
+  ASSERT_THROW(a.InverseBatch(), std::invalid_argument);
+  ASSERT_THROW(a(4, 0, 0), std::out_of_range);
+  ASSERT_THROW(a(0, 2, 0), std::out_of_range);
+  ASSERT_THROW(a.Get(-1), std::out_of_range);
+}
@@ -0,0 +1,157 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+#include "test_base.h"
+
+static std::string TempPath(const std::string &name) {
+  return testing::TempDir() + "s21_matrix_file_" + name;
+}
+
+static void CorruptByte(const std::string &path, long offset) {
+  std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+  file.seekg(offset);
+  char byte = static_cast<char>(file.get());
+  file.seekp(offset);
+  file.put(static_cast<char>(byte ^ 1));
+}
+
+TEST(matrix_file, save_load) {
+  const std::string path = TempPath("save_load");
+  for (int cols : {1, 5, 8, 13, 100}) {
+    S21Matrix matr(17, cols);
+    FillPseudoRandom(matr, cols);
+    matr.Save(path);
+    S21Matrix loaded = S21Matrix::Load(path);
+    ASSERT_EQ(loaded.GetRows(), 17);
+    ASSERT_EQ(loaded.GetCols(), cols);
+    ASSERT_TRUE(loaded.EqMatrix(matr, 0));
+  }
+  // Shrinking leaves old values in the row padding; they are not saved.
+  S21Matrix shrunk(4, 20);
+  FillPseudoRandom(shrunk, 3);
+  shrunk.SetCols(11);
+  shrunk.Save(path);
+  S21Matrix loaded = S21Matrix::Load(path);
+  ASSERT_TRUE(loaded.EqMatrix(shrunk, 0));
+  ASSERT_EQ(loaded.data()[15], 0);
+  std::remove(path.c_str());
+}
+
+TEST(matrix_file, header) {
+  const std::string path = TempPath("header");
+  S21Matrix matr(3, 10);
+  matr.Save(path);
+  S21MatrixFileInfo info = S21ReadMatrixFileInfo(path);
+  ASSERT_EQ(info.version, 1u);
+  ASSERT_EQ(info.dtype, S21MatrixDtype::kDouble);
+  ASSERT_EQ(info.rows, 3);
+  ASSERT_EQ(info.cols, 10);
+  ASSERT_EQ(info.stride, matr.stride());
+  ASSERT_EQ(info.data_offset % 64, 0u);
+  std::remove(path.c_str());
+}
+
+TEST(matrix_file, other_types) {
+  const std::string path = TempPath("types");
+  S21FloatMatrix floats(5, 33);
+  S21LongDoubleMatrix long_doubles(6, 7);
+  floats._FillMatrix(0.5f);
+  long_doubles._FillMatrix(0.25L);
+  floats.Save(path);
+  ASSERT_TRUE(S21FloatMatrix::Load(path) == floats);
+  ASSERT_THROW(S21Matrix::Load(path), std::invalid_argument);
+  long_doubles.Save(path);
+  ASSERT_TRUE(S21LongDoubleMatrix::Load(path).EqMatrix(long_doubles, 0));
+  S21BasicMappedMatrix<long double> mapped(path);
+  ASSERT_TRUE(mapped.Verify());
+  std::remove(path.c_str());
+}
+
+TEST(matrix_file, mapped) {
+  const std::string path = TempPath("mapped");
+  S21Matrix matr(40, 30), b(30, 7);
+  FillPseudoRandom(matr, 4);
+  FillPseudoRandom(b, 5);
+  matr.Save(path);
+  S21MappedMatrix mapped(path);
+  ASSERT_EQ(mapped.GetRows(), 40);
+  ASSERT_EQ(mapped.GetCols(), 30);
+  ASSERT_EQ(mapped.stride(), matr.stride());
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(mapped.data()) % 64, 0u);
+  ASSERT_EQ(mapped(39, 29), matr(39, 29));
+  ASSERT_THROW(mapped(40, 0), std::out_of_range);
+  ASSERT_TRUE(mapped.Verify());
+  mapped.Prefetch(10, 100);
+  S21Matrix product(40, 7);
+  S21Matrix::Gemm(1., mapped.View(), b, 0., product);
+  ASSERT_TRUE(product.EqMatrix(matr * b, 0));
+  S21MappedMatrix moved(std::move(mapped));
+  ASSERT_EQ(mapped.data(), nullptr);
+  ASSERT_TRUE(moved.ToMatrix() == matr);
+  std::remove(path.c_str());
+}
+
+TEST(matrix_file, streaming_writer) {
+  const std::string path = TempPath("writer");
+  S21Matrix matr(50, 9);
+  FillPseudoRandom(matr, 6);
+  {
+    S21MatrixWriter writer(path, 9, 50);
+    S21ConstMatrixView transposed = matr.View().Transposed();
+    writer.WriteRows(transposed.RowRange(0, 4));
+    for (int i = 4; i < 9; i++) {
+      S21Matrix row(transposed.RowRange(i, i + 1));
+      writer.WriteRow(row.data());
+    }
+    ASSERT_EQ(writer.RowsWritten(), 9);
+    ASSERT_THROW(writer.WriteRows(transposed.RowRange(0, 1)),
+                 std::invalid_argument);
+  }
+  S21Matrix expected = matr.Transpose();
+  ASSERT_TRUE(S21Matrix::Load(path).EqMatrix(expected, 0));
+  {
+    S21MatrixWriter writer(path, 3, 9);
+    writer.WriteRows(matr.View().RowRange(0, 2));
+    ASSERT_THROW(writer.Close(), std::out_of_range);
+  }
+  ASSERT_THROW(S21Matrix::Load(path), std::invalid_argument);
+  ASSERT_THROW(S21MappedMatrix mapped(path), std::invalid_argument);
+  std::remove(path.c_str());
+}
+
+TEST(matrix_file, corruption) {
+  const std::string path = TempPath("corrupt");
+  S21Matrix matr(8, 8);
+  FillPseudoRandom(matr, 7);
+  matr.Save(path);
+  CorruptByte(path, 64 + 100);
+  ASSERT_THROW(S21Matrix::Load(path), std::invalid_argument);
+  ASSERT_FALSE(S21MappedMatrix(path).Verify());
+  // The alignment field, then the data offset: either would misalign the
+  // mapped data.
+  for (long offset : {20, 48}) {
+    CorruptByte(path, offset);
+    ASSERT_THROW(S21MappedMatrix mapped(path), std::invalid_argument);
+    CorruptByte(path, offset);
+    ASSERT_NO_THROW(S21MappedMatrix mapped(path));
+  }
+  CorruptByte(path, 0);
+  ASSERT_THROW(S21ReadMatrixFileInfo(path), std::invalid_argument);
+  std::remove(path.c_str());
+  ASSERT_THROW(S21Matrix::Load(path), std::system_error);
+}
+
+TEST(matrix_file, checksum_pieces) {
+  unsigned char bytes[100];
+  for (int i = 0; i < 100; i++) bytes[i] = i * 7;
+  S21Checksum whole, pieces;
+  whole.Update(bytes, 100);
+  pieces.Update(bytes, 3);
+  pieces.Update(bytes + 3, 20);
+  pieces.Update(bytes + 23, 77);
+  ASSERT_EQ(whole.Digest(), pieces.Digest());
+  pieces.Update(bytes, 1);
+  ASSERT_NE(whole.Digest(), pieces.Digest());
+}
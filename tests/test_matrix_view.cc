@@ -0,0 +1,202 @@
+#include "test_base.h"
+
+TEST(matrix_view, slicing) {
+  S21Matrix matr(6, 9);
+  FillPseudoRandom(matr, 1);
+  S21MatrixView view = matr.View();
+  ASSERT_EQ(view.data(), matr.data());
+  ASSERT_EQ(view.stride(), matr.stride());
+  S21MatrixView block = view.Block(2, 3, 3, 4);
+  S21MatrixView rows = view.RowRange(1, 4);
+  S21MatrixView cols = view.ColRange(5, 9);
+  S21MatrixView transposed = view.Transposed();
+  ASSERT_EQ(block.GetRows(), 3);
+  ASSERT_EQ(block.GetCols(), 4);
+  ASSERT_EQ(transposed.GetRows(), 9);
+  ASSERT_EQ(block(1, 2), matr(3, 5));
+  ASSERT_EQ(rows(2, 8), matr(3, 8));
+  ASSERT_EQ(cols(5, 0), matr(5, 5));
+  ASSERT_EQ(transposed(7, 4), matr(4, 7));
+  ASSERT_EQ(transposed.Block(1, 2, 3, 2)(2, 1), matr(3, 3));
+  block(0, 0) = 42;
+  ASSERT_EQ(matr(2, 3), 42);
+  S21ConstMatrixView read_only = block;
+  ASSERT_EQ(read_only(0, 0), 42);
+  ASSERT_THROW(block(3, 0), std::out_of_range);
+  ASSERT_THROW(view.Block(4, 0, 3, 1), std::out_of_range);
+  ASSERT_THROW(view.ColRange(3, 3), std::out_of_range);
+}
+
+TEST(matrix_view, external_buffer) {
+  double buffer[12] = {1, 2, 3, 0, 4, 5, 6, 0, 7, 8, 10, 0};
+  S21MatrixView view(buffer, 3, 3, 4);
+  ASSERT_DOUBLE_EQ(S21Matrix(view).Determinant(), -3.);
+  S21Matrix identity(3, 3);
+  for (int i = 0; i < 3; i++) identity(i, i) = 1;
+  S21Matrix::Gemm(2., identity, view, 0., view);
+  ASSERT_EQ(buffer[9], 16);
+  ASSERT_EQ(buffer[3], 0);
+  double column_major[6] = {1, 2, 3, 4, 5, 6};
+  S21ConstMatrixView columns(column_major, 2, 3, 1, 2);
+  ASSERT_EQ(columns(1, 2), 6);
+  ASSERT_EQ(S21Matrix(columns)(0, 1), 3);
+  ASSERT_THROW(S21MatrixView(nullptr, 2, 2, 2), std::out_of_range);
+  ASSERT_THROW(S21MatrixView(buffer, 0, 2, 2), std::out_of_range);
+}
+
+TEST(matrix_view, element_wise_kernels) {
+  S21Matrix a(40, 50), b(40, 50), out(50, 40);
+  FillPseudoRandom(a, 2);
+  FillPseudoRandom(b, 3);
+  s21::Add<double>(a.View().Block(3, 4, 20, 30), b.View().Block(0, 0, 20, 30),
+                   out.View().Block(10, 5, 20, 30));
+  s21::Sub<double>(a.View().Transposed(), b.View().Transposed(),
+                   out.View());
+  for (int i = 0; i < 50; i++) {
+    for (int j = 0; j < 40; j++) ASSERT_EQ(out(i, j), a(j, i) - b(j, i));
+  }
+  s21::Scale<double>(a.View().ColRange(0, 10), 0.5,
+                     out.View().Transposed().ColRange(0, 10));
+  ASSERT_EQ(out(7, 11), a(11, 7) * 0.5);
+  s21::Fill<double>(out.View().Block(0, 0, 2, 2), 9.);
+  ASSERT_EQ(out(1, 1), 9);
+  ASSERT_THROW(s21::Add<double>(a, b, out), std::invalid_argument);
+  ASSERT_TRUE(s21::Equal<double>(a.View().Block(1, 1, 5, 5),
+                                 a.View().Block(1, 1, 5, 5), 0));
+  ASSERT_FALSE(s21::Equal<double>(a, out, 1));
+  ASSERT_FALSE(s21::Equal<double>(S21ConstMatrixView(), a, 1));
+}
+
+TEST(matrix_view, copy) {
+  S21Matrix a(37, 70), t(70, 37);
+  FillPseudoRandom(a, 4);
+  s21::Copy<double>(a.View().Transposed(), t);
+  ASSERT_TRUE(t == S21Matrix(a.Transpose()));
+  S21Matrix shifted(a);
+  s21::Copy<double>(shifted.View().RowRange(0, 30),
+                    shifted.View().RowRange(7, 37));
+  for (int i = 7; i < 37; i++) {
+    for (int j = 0; j < 70; j++) ASSERT_EQ(shifted(i, j), a(i - 7, j));
+  }
+  S21Matrix square(8, 8);
+  FillPseudoRandom(square, 5);
+  S21Matrix expected = square.Transpose();
+  s21::Copy<double>(square.View().Transposed(), square);
+  ASSERT_TRUE(square == expected);
+}
+
+TEST(matrix_view, gemm) {
+  S21Matrix a(30, 20), b(30, 25), c(20, 25);
+  FillPseudoRandom(a, 6);
+  FillPseudoRandom(b, 7);
+  S21Matrix expected = a.Transpose() * b;
+  S21Matrix::Gemm(1., a.View().Transposed(), b, 0., c);
+  ASSERT_TRUE(c.EqMatrix(expected, 1e-12));
+  S21Matrix block_product = S21Matrix(a.View().Block(0, 0, 10, 10));
+  block_product.MulMatrix(b.View().Block(5, 5, 10, 10));
+  S21Matrix left(a.View().Block(0, 0, 10, 10));
+  S21Matrix right(b.View().Block(5, 5, 10, 10));
+  ASSERT_TRUE(block_product.EqMatrix(left * right, 1e-12));
+  S21Matrix square(12, 12);
+  FillPseudoRandom(square, 8);
+  S21Matrix squared = square * square;
+  s21::Gemm<double>(1, square, square, 0, square);
+  ASSERT_TRUE(square.EqMatrix(squared, 1e-12));
+  ASSERT_THROW(S21Matrix::Gemm(1., a, b, 0., c), std::invalid_argument);
+}
+
+TEST(matrix_view, matrix_operations) {
+  S21Matrix a(10, 10), b(20, 20);
+  FillPseudoRandom(a, 9);
+  FillPseudoRandom(b, 10);
+  S21Matrix sum(a);
+  sum.SumMatrix(b.View().Block(5, 5, 10, 10));
+  sum.SubMatrix(b.View().Block(5, 5, 10, 10));
+  ASSERT_TRUE(sum.EqMatrix(a.View(), 1e-15));
+  ASSERT_FALSE(sum.EqMatrix(b.View().Block(0, 0, 10, 10)));
+  ASSERT_THROW(sum.SumMatrix(b.View().RowRange(0, 10)),
+               std::invalid_argument);
+  for (int i = 0; i < 10; i++) a(i, i) += 10;
+  S21Matrix rhs(b.View().Block(0, 0, 10, 3));
+  S21Matrix x = a.Solve(b.View().Block(0, 0, 10, 3));
+  ASSERT_TRUE((a * x).EqMatrix(rhs, 1e-12));
+}
+
+TEST(matrix_view, overlapping_operand) {
+  S21Matrix a(3, 3);
+  for (int i = 0; i < 9; i++) a(i / 3, i % 3) = i;
+  S21Matrix expected(a.View().Transposed());
+  expected.SumMatrix(a);
+  a.SumMatrix(a.View().Transposed());
+  ASSERT_TRUE(a == expected);
+  S21Matrix b(40, 41);
+  FillPseudoRandom(b, 11);
+  S21Matrix shifted(b);
+  s21::Sub<double>(shifted.View().Block(0, 1, 40, 40),
+                   shifted.View().Block(0, 0, 40, 40),
+                   shifted.View().Block(0, 1, 40, 40));
+  for (int i = 0; i < 40; i++) {
+    for (int j = 1; j < 41; j++)
+      ASSERT_EQ(shifted(i, j), b(i, j) - b(i, j - 1));
+  }
+}
+
+TEST(matrix_view, blocks_side_by_side) {
+  S21Matrix matr(64, 64);
+  FillPseudoRandom(matr, 12);
+  S21Matrix original(matr);
+  S21PoolResource pool;
+  {
+    S21ResourceScope scope(&pool);
+    // The blocks share their rows but not their columns.
+    s21::Add<double>(matr.View().Block(32, 0, 32, 32),
+                     matr.View().Block(32, 32, 32, 32),
+                     matr.View().Block(32, 32, 32, 32));
+    s21::Sub<double>(matr.View().Block(0, 0, 32, 32),
+                     matr.View().Block(0, 32, 32, 32),
+                     matr.View().Block(0, 0, 32, 32));
+    s21::Copy<double>(matr.View().Block(0, 0, 16, 16),
+                      matr.View().Block(0, 16, 16, 16));
+  }
+  ASSERT_EQ(pool.GetStats().allocations, 0u);
+  for (int i = 0; i < 32; i++) {
+    for (int j = 0; j < 32; j++) {
+      ASSERT_EQ(matr(32 + i, 32 + j),
+                original(32 + i, j) + original(32 + i, 32 + j));
+      const double difference = original(i, j) - original(i, 32 + j);
+      if (i >= 16 || j < 16) {
+        ASSERT_EQ(matr(i, j), difference);
+      }
+      if (i < 16 && j < 16) {
+        ASSERT_EQ(matr(i, 16 + j), difference);
+      }
+    }
+  }
+}
+
+TEST(matrix_view, determinant_in_place) {
+  S21Matrix matr(30, 30);
+  FillPseudoRandom(matr, 11);
+  S21Matrix block(matr.View().Block(3, 4, 20, 20));
+  const double expected = block.Determinant();
+  ASSERT_EQ(S21LU::DeterminantInPlace(matr.View().Block(3, 4, 20, 20)),
+            expected);
+  S21Matrix square(4, 4);
+  FillPseudoRandom(square, 12);
+  S21Matrix copy(square);
+  ASSERT_NEAR(S21LU::DeterminantInPlace(square.View().Transposed()),
+              copy.Determinant(), 1e-12);
+  ASSERT_THROW(S21LU::DeterminantInPlace(matr.View().RowRange(0, 2)),
+               std::invalid_argument);
+}
+
+TEST(matrix_view, float_elements) {
+  S21FloatMatrix a(3, 4);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 4; j++) a(i, j) = i * 4 + j;
+  }
+  S21BasicMatrixView<float> view = a.View().Block(1, 1, 2, 3);
+  s21::Scale<float>(view, 2.f, view);
+  ASSERT_FLOAT_EQ(a(2, 3), 22.f);
+  ASSERT_FLOAT_EQ(a(0, 3), 3.f);
+}
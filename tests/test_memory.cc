@@ -0,0 +1,99 @@
+#include <memory>
+#include <vector>
+
+#include "test_base.h"
+
+TEST(memory, default_resource) {
+  S21Matrix matr(4, 4);
+  ASSERT_EQ(matr.GetResource(), S21AlignedResource::Instance());
+  ASSERT_EQ(S21Matrix::GetDefaultResource(), S21AlignedResource::Instance());
+}
+
+TEST(memory, pool_reuses_blocks) {
+  S21PoolResource pool;
+  for (int i = 0; i < 10; i++) {
+    S21Matrix matr(20, 20, &pool);
+    matr(19, 19) = i;
+    ASSERT_EQ(matr.GetResource(), &pool);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(matr.data()) % 64, 0u);
+  }
+  S21AllocationStats stats = pool.GetStats();
+  ASSERT_EQ(stats.allocations, 10u);
+  ASSERT_EQ(stats.deallocations, 10u);
+  ASSERT_EQ(stats.upstream_allocations, 1u);
+  ASSERT_EQ(stats.AllocationsAvoided(), 9u);
+  ASSERT_EQ(stats.bytes_in_use, 0u);
+  ASSERT_GE(stats.peak_bytes, 20u * 24 * sizeof(double));
+}
+
+TEST(memory, pool_large_blocks_go_upstream) {
+  S21PoolResource pool;
+  { S21Matrix matr(1024, 1024, &pool); }
+  { S21Matrix matr(1024, 1024, &pool); }
+  ASSERT_EQ(pool.GetStats().upstream_allocations, 2u);
+}
+
+TEST(memory, arena_reset) {
+  S21ArenaResource arena(1 << 16);
+  {
+    S21ResourceScope scope(&arena);
+    S21Matrix a(8, 8), b(8, 8);
+    a._FillMatrix(1);
+    b._FillMatrix(2);
+    S21Matrix c = a + b;
+    ASSERT_EQ(c.GetResource(), &arena);
+    ASSERT_DOUBLE_EQ(c(7, 7), a(7, 7) + b(7, 7));
+  }
+  ASSERT_EQ(S21Matrix::GetDefaultResource(), S21AlignedResource::Instance());
+  ASSERT_EQ(arena.GetStats().upstream_allocations, 1u);
+  arena.Reset();
+  {
+    S21ResourceScope scope(&arena);
+    S21Matrix a(8, 8);
+    ASSERT_EQ(arena.GetStats().upstream_allocations, 1u);
+  }
+  S21Matrix big(300, 300, &arena);
+  big(299, 299) = 1;
+  ASSERT_EQ(arena.GetStats().upstream_allocations, 2u);
+}
+
+TEST(memory, arena_over_aligned) {
+  S21ArenaResource arena(1 << 16);
+  void* first = arena.allocate(64);
+  void* aligned = arena.allocate(100, 256);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 256, 0u);
+  ASSERT_EQ(arena.GetStats().upstream_allocations, 2u);
+  void* next = arena.allocate(64);
+  ASSERT_EQ(next, static_cast<char*>(first) + 64);
+  ASSERT_EQ(arena.GetStats().upstream_allocations, 2u);
+  arena.Reset();
+  ASSERT_EQ(arena.allocate(1 << 15), first);
+  arena.Release();
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(arena.allocate(8, 4096)) % 4096,
+            0u);
+}
+
+TEST(memory, arena_freed_on_workers) {
+  S21ArenaResource arena(1 << 16);
+  std::vector<std::unique_ptr<S21Matrix>> matrices;
+  for (int i = 0; i < 256; i++)
+    matrices.push_back(std::make_unique<S21Matrix>(4, 4, &arena));
+  s21::ParallelFor(256, 1, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t i = begin; i < end; i++) matrices[i].reset();
+  });
+  ASSERT_EQ(arena.GetStats().deallocations, 256u);
+  ASSERT_EQ(arena.GetStats().bytes_in_use, 0u);
+}
+
+TEST(memory, assignment_keeps_resource) {
+  S21PoolResource pool;
+  S21Matrix a(5, 5, &pool), b(6, 6);
+  b._FillMatrix(1);
+  a = b;
+  ASSERT_EQ(a.GetResource(), &pool);
+  ASSERT_TRUE(a == b);
+  S21Matrix moved(std::move(a));
+  ASSERT_EQ(moved.GetResource(), &pool);
+  S21Matrix copy(moved);
+  ASSERT_EQ(copy.GetResource(), S21AlignedResource::Instance());
+}
@@ -0,0 +1,79 @@
+#include <string>
+
+#include "test_base.h"
+
+TEST(profile, scope) {
+  s21::ResetProfile();
+  {
+    s21::ProfileScope outer(s21::ProfileOp::kInverse, 1000);
+    s21::ProfileAllocated(64);
+    {
+      s21::ProfileScope same(s21::ProfileOp::kInverse, 500);
+      s21::ProfileScope inner(s21::ProfileOp::kMulMatrix, 200);
+      s21::ProfileCopied(32);
+    }
+  }
+  s21::ProfileAllocated(128);
+  s21::ProfileCopied(16);
+  s21::ProfileSnapshot snapshot = s21::TakeProfileSnapshot();
+  const s21::OpProfile &inverse = snapshot[s21::ProfileOp::kInverse];
+  ASSERT_EQ(inverse.calls, 1u);
+  ASSERT_EQ(inverse.flops, 1000u);
+  ASSERT_EQ(inverse.bytes_allocated, 64u);
+  ASSERT_EQ(snapshot[s21::ProfileOp::kMulMatrix].calls, 1u);
+  ASSERT_EQ(snapshot[s21::ProfileOp::kMulMatrix].bytes_copied, 32u);
+  ASSERT_GE(inverse.time_ns, snapshot[s21::ProfileOp::kMulMatrix].time_ns);
+  std::uint64_t histogram = 0;
+  for (std::uint64_t count : inverse.time_histogram) histogram += count;
+  ASSERT_EQ(histogram, 1u);
+  ASSERT_EQ(snapshot[s21::ProfileOp::kAllocate].calls, 1u);
+  ASSERT_EQ(snapshot[s21::ProfileOp::kAllocate].bytes_allocated, 128u);
+  ASSERT_EQ(snapshot[s21::ProfileOp::kCopy].bytes_copied, 16u);
+  if (!snapshot.hardware) {
+    ASSERT_EQ(inverse.cycles, 0u);
+  }
+  s21::ResetProfile();
+  ASSERT_EQ(s21::TakeProfileSnapshot()[s21::ProfileOp::kInverse].calls, 0u);
+}
+
+TEST(profile, json) {
+  s21::ResetProfile();
+  {
+    s21::ProfileScope scope(s21::ProfileOp::kSolve, 42);
+  }
+  const std::string json = s21::ProfileJson(s21::TakeProfileSnapshot());
+  ASSERT_EQ(json.front(), '{');
+  ASSERT_EQ(json.back(), '}');
+  ASSERT_NE(json.find("\"operations\": {\"Allocate\": {"), std::string::npos);
+  const std::size_t solve = json.find("\"Solve\": {\"calls\": 1, ");
+  ASSERT_NE(solve, std::string::npos);
+  ASSERT_NE(json.find("\"flops\": 42, ", solve), std::string::npos);
+  ASSERT_NE(json.find("\"time_histogram_ns\": {\"", solve), std::string::npos);
+  ASSERT_NE(json.find("\"Load\": {"), std::string::npos);
+  ASSERT_STREQ(s21::ProfileOpName(s21::ProfileOp::kComplements),
+               "CalcComplements");
+  s21::ResetProfile();
+}
+
+// Counts only appear in a library built with make INSTRUMENT=1.
+TEST(profile, matrix_operations) {
+  s21::ResetProfile();
+  S21Matrix a(40, 30), b(30, 20);
+  S21Matrix copy = a;
+  a.MulMatrix(b);
+  s21::ProfileSnapshot snapshot = s21::TakeProfileSnapshot();
+  const s21::OpProfile &mul = snapshot[s21::ProfileOp::kMulMatrix];
+  if (snapshot.enabled) {
+    ASSERT_EQ(mul.calls, 1u);
+    ASSERT_EQ(mul.flops, 2u * 40 * 30 * 20);
+    ASSERT_EQ(mul.bytes_allocated, 40u * 24 * sizeof(double));
+    ASSERT_EQ(snapshot[s21::ProfileOp::kCopy].calls, 1u);
+    ASSERT_EQ(snapshot[s21::ProfileOp::kCopy].bytes_copied,
+              40u * 30 * sizeof(double));
+    ASSERT_GE(snapshot[s21::ProfileOp::kAllocate].calls, 2u);
+  } else {
+    ASSERT_EQ(mul.calls, 0u);
+    ASSERT_EQ(snapshot[s21::ProfileOp::kAllocate].calls, 0u);
+  }
+  s21::ResetProfile();
+}
@@ -0,0 +1,72 @@
+#include "test_base.h"
+
+TEST(qr, r_factor) {
+  const int shapes[][2] = {{1, 1}, {5, 3}, {40, 40}, {100, 33}, {200, 70}};
+  for (const auto &shape : shapes) {
+    S21Matrix a(shape[0], shape[1]);
+    FillPseudoRandom(a, shape[0] + shape[1]);
+    S21QR qr(a);
+    ASSERT_FALSE(qr.IsRankDeficient());
+    S21Matrix r = qr.GetR();
+    for (int i = 0; i < shape[1]; i++) {
+      for (int j = 0; j < i; j++) ASSERT_EQ(r(i, j), 0);
+    }
+    // Q is orthogonal, so R^T R = A^T A.
+    S21Matrix gram = a.Transpose() * a;
+    ASSERT_TRUE((r.Transpose() * r).EqMatrix(gram, 1e-12 * shape[0]));
+  }
+}
+
+TEST(qr, square_solve) {
+  S21Matrix a(90, 90), x(90, 3);
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(x, 2);
+  S21Matrix b = a * x;
+  ASSERT_TRUE(a.SolveLeastSquares(b).EqMatrix(x, 1e-9));
+}
+
+TEST(qr, least_squares) {
+  S21Matrix a(150, 40), b(150, 2);
+  FillPseudoRandom(a, 3);
+  FillPseudoRandom(b, 4);
+  S21QR qr(a);
+  S21Matrix x = qr.Solve(b);
+  ASSERT_EQ(x.GetRows(), 40);
+  ASSERT_EQ(x.GetCols(), 2);
+  // The residual is orthogonal to the columns of A.
+  S21Matrix residual = a * x - b;
+  S21Matrix normal = a.Transpose() * residual;
+  for (int i = 0; i < 40; i++) {
+    for (int j = 0; j < 2; j++) ASSERT_NEAR(normal(i, j), 0, 1e-12);
+  }
+  // A consistent system is solved exactly.
+  S21Matrix exact = a * x;
+  ASSERT_TRUE(qr.Solve(exact).EqMatrix(x, 1e-10));
+}
+
+TEST(qr, rank_deficient) {
+  S21Matrix a(6, 3);
+  for (int i = 0; i < 6; i++) {
+    a(i, 0) = i + 1;
+    a(i, 1) = 2 * (i + 1);
+    a(i, 2) = i % 2;
+  }
+  S21QR qr(a);
+  ASSERT_TRUE(qr.IsRankDeficient());
+  try {
+    qr.Solve(a);
+    FAIL();
+  } catch (const std::exception &e) {
+    ASSERT_STREQ(e.what(), "Matrix is rank deficient");
+  }
+}
+
+TEST(qr, Throw) {
+  try {
+    S21Matrix a(2, 3);
+    S21QR qr(a);
+    FAIL();
+  } catch (const std::exception &e) {
+    ASSERT_STREQ(e.what(), "Rows less than columns");
+  }
+}
@@ -0,0 +1,189 @@
+#include <cstring>
+#include <vector>
+
+#include "test_base.h"
+
+static const s21::SimdLevel kLevels[] = {
+    s21::SimdLevel::kSse2, s21::SimdLevel::kAvx2, s21::SimdLevel::kAvx512};
+
+static std::vector<double> Sequence(std::size_t n, double seed) {
+  std::vector<double> v(n);
+  for (std::size_t j = 0; j < n; j++) v[j] = seed * (j + 1) / 7. - j * 0.3;
+  return v;
+}
+
+static bool SameBits(const std::vector<double> &a,
+                     const std::vector<double> &b) {
+  return a.size() == b.size() &&
+         std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+}
+
+TEST(simd, dispatch) {
+  const s21::SimdKernels *scalar =
+      s21::SimdKernelsFor(s21::SimdLevel::kScalar);
+  ASSERT_NE(scalar, nullptr);
+  const s21::SimdKernels &active = s21::Simd();
+  ASSERT_EQ(s21::SimdKernelsFor(active.level), &active);
+}
+
+TEST(simd, variants_match_scalar) {
+  const s21::SimdKernels &ref = *s21::SimdKernelsFor(s21::SimdLevel::kScalar);
+  for (s21::SimdLevel level : kLevels) {
+    const s21::SimdKernels *simd = s21::SimdKernelsFor(level);
+    if (simd == nullptr) continue;
+    for (std::size_t n = 0; n < 70; n++) {
+      std::vector<double> a = Sequence(n + 1, 1.3), b = Sequence(n + 1, -2.9);
+      std::vector<double> expected(n), actual(n);
+
+      ref.add(a.data() + 1, b.data(), expected.data(), n);
+      simd->add(a.data() + 1, b.data(), actual.data(), n);
+      ASSERT_TRUE(SameBits(expected, actual));
+
+      ref.sub(a.data() + 1, b.data(), expected.data(), n);
+      simd->sub(a.data() + 1, b.data(), actual.data(), n);
+      ASSERT_TRUE(SameBits(expected, actual));
+
+      ref.scale(a.data(), 0.1, expected.data(), n);
+      simd->scale(a.data(), 0.1, actual.data(), n);
+      ASSERT_TRUE(SameBits(expected, actual));
+
+      expected.assign(b.begin(), b.begin() + n);
+      actual.assign(b.begin(), b.begin() + n);
+      ref.axpy(0.7, a.data(), expected.data(), n);
+      simd->axpy(0.7, a.data(), actual.data(), n);
+      ASSERT_TRUE(SameBits(expected, actual));
+
+      expected.assign(b.begin(), b.begin() + n);
+      actual.assign(b.begin(), b.begin() + n);
+      ref.mul_add(a.data(), a.data() + 1, expected.data(), n);
+      simd->mul_add(a.data(), a.data() + 1, actual.data(), n);
+      ASSERT_TRUE(SameBits(expected, actual));
+      ref.mul_sub(a.data() + 1, b.data(), expected.data(), n);
+      simd->mul_sub(a.data() + 1, b.data(), actual.data(), n);
+      ASSERT_TRUE(SameBits(expected, actual));
+
+      ref.div(a.data(), b.data() + 1, expected.data(), n);
+      simd->div(a.data(), b.data() + 1, actual.data(), n);
+      ASSERT_TRUE(SameBits(expected, actual));
+
+      double dot = ref.dot(a.data() + 1, b.data(), n);
+      double simd_dot = simd->dot(a.data() + 1, b.data(), n);
+      ASSERT_EQ(std::memcmp(&dot, &simd_dot, sizeof(double)), 0);
+
+      ref.fill(expected.data(), n, -3.25);
+      simd->fill(actual.data(), n, -3.25);
+      ASSERT_TRUE(SameBits(expected, actual));
+
+      ref.ramp(expected.data(), n, 5, 0.1);
+      simd->ramp(actual.data(), n, 5, 0.1);
+      ASSERT_TRUE(SameBits(expected, actual));
+    }
+  }
+}
+
+TEST(simd, equal_matches_scalar) {
+  const s21::SimdKernels &ref = *s21::SimdKernelsFor(s21::SimdLevel::kScalar);
+  for (s21::SimdLevel level : kLevels) {
+    const s21::SimdKernels *simd = s21::SimdKernelsFor(level);
+    if (simd == nullptr) continue;
+    for (std::size_t n = 1; n < 40; n++) {
+      std::vector<double> a = Sequence(n, 2.), b = a;
+      ASSERT_TRUE(simd->equal(a.data(), b.data(), n, 1e-7));
+      for (std::size_t pos = 0; pos < n; pos++) {
+        b = a;
+        b[pos] += 1e-8;
+        ASSERT_EQ(ref.equal(a.data(), b.data(), n, 1e-7),
+                  simd->equal(a.data(), b.data(), n, 1e-7));
+        b[pos] += 1e-6;
+        ASSERT_FALSE(simd->equal(a.data(), b.data(), n, 1e-7));
+        b[pos] = NAN;
+        ASSERT_EQ(ref.equal(a.data(), b.data(), n, 1e-7),
+                  simd->equal(a.data(), b.data(), n, 1e-7));
+      }
+    }
+  }
+}
+
+TEST(simd, transpose_matches_scalar) {
+  const s21::SimdKernels &ref = *s21::SimdKernelsFor(s21::SimdLevel::kScalar);
+  std::vector<double> a = Sequence(37 * 41, 0.9);
+  for (s21::SimdLevel level : kLevels) {
+    const s21::SimdKernels *simd = s21::SimdKernelsFor(level);
+    if (simd == nullptr) continue;
+    for (int rows : {1, 4, 8, 13, 32}) {
+      for (int cols : {1, 3, 8, 16, 29}) {
+        std::vector<double> expected(41 * 37, -1.), actual(41 * 37, -1.);
+        ref.transpose(rows, cols, a.data(), 41, expected.data(), 37);
+        simd->transpose(rows, cols, a.data(), 41, actual.data(), 37);
+        ASSERT_TRUE(SameBits(expected, actual));
+      }
+    }
+  }
+}
+
+TEST(simd, float_variants_match_scalar) {
+  const s21::BasicSimdKernels<float> &ref =
+      *s21::SimdKernelsFor<float>(s21::SimdLevel::kScalar);
+  ASSERT_EQ(s21::SimdKernelsFor<float>(s21::Simd<float>().level),
+            &s21::Simd<float>());
+  for (s21::SimdLevel level : kLevels) {
+    const s21::BasicSimdKernels<float> *simd =
+        s21::SimdKernelsFor<float>(level);
+    if (simd == nullptr) continue;
+    for (std::size_t n = 0; n < 70; n++) {
+      std::vector<float> a(n + 1), b(n + 1), expected(n), actual(n);
+      for (std::size_t j = 0; j <= n; j++) {
+        a[j] = 1.3f * (j + 1) / 7.f - j * 0.3f;
+        b[j] = -2.9f * (j + 1) / 7.f;
+      }
+      ref.add(a.data() + 1, b.data(), expected.data(), n);
+      simd->add(a.data() + 1, b.data(), actual.data(), n);
+      ASSERT_EQ(expected, actual);
+
+      ref.sub(a.data() + 1, b.data(), expected.data(), n);
+      simd->sub(a.data() + 1, b.data(), actual.data(), n);
+      ASSERT_EQ(expected, actual);
+
+      ref.scale(a.data(), 0.1f, expected.data(), n);
+      simd->scale(a.data(), 0.1f, actual.data(), n);
+      ASSERT_EQ(expected, actual);
+
+      expected.assign(b.begin(), b.begin() + n);
+      actual.assign(b.begin(), b.begin() + n);
+      ref.axpy(0.7f, a.data(), expected.data(), n);
+      simd->axpy(0.7f, a.data(), actual.data(), n);
+      ASSERT_EQ(expected, actual);
+
+      ref.mul_add(a.data(), a.data() + 1, expected.data(), n);
+      simd->mul_add(a.data(), a.data() + 1, actual.data(), n);
+      ASSERT_EQ(expected, actual);
+      ref.mul_sub(a.data() + 1, b.data(), expected.data(), n);
+      simd->mul_sub(a.data() + 1, b.data(), actual.data(), n);
+      ASSERT_EQ(expected, actual);
+
+      ref.div(a.data(), b.data() + 1, expected.data(), n);
+      simd->div(a.data(), b.data() + 1, actual.data(), n);
+      ASSERT_EQ(expected, actual);
+
+      ASSERT_EQ(ref.dot(a.data() + 1, b.data(), n),
+                simd->dot(a.data() + 1, b.data(), n));
+
+      ASSERT_TRUE(simd->equal(a.data(), a.data(), n, 1e-4f));
+      if (n > 0) {
+        b.assign(a.begin(), a.end());
+        b[n - 1] += 1e-3f;
+        ASSERT_FALSE(simd->equal(a.data(), b.data(), n, 1e-4f));
+      }
+    }
+    std::vector<float> source(37 * 41);
+    for (std::size_t j = 0; j < source.size(); j++) source[j] = j * 0.5f;
+    for (int rows : {1, 4, 8, 13, 32}) {
+      for (int cols : {1, 3, 8, 16, 29}) {
+        std::vector<float> expected(41 * 37, -1.f), actual(41 * 37, -1.f);
+        ref.transpose(rows, cols, source.data(), 41, expected.data(), 37);
+        simd->transpose(rows, cols, source.data(), 41, actual.data(), 37);
+        ASSERT_EQ(expected, actual);
+      }
+    }
+  }
+}
@@ -0,0 +1,124 @@
+#include <cmath>
+#include <vector>
+
+#include "test_base.h"
+
+// About one element in density is non-zero.
+static S21Matrix RandomSparse(int rows, int cols, unsigned density,
+                              unsigned seed) {
+  S21Matrix matr(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      seed = seed * 1103515245u + 12345u;
+      if ((seed >> 16) % density == 0)
+        matr(i, j) = static_cast<double>((seed >> 8) % 2001) / 1000. - 1.;
+    }
+  }
+  return matr;
+}
+
+TEST(sparse_matrix, from_dense) {
+  S21Matrix dense = RandomSparse(40, 30, 10, 1);
+  dense(3, 4) = 1e-9;
+  for (S21SparseFormat format :
+       {S21SparseFormat::kCsr, S21SparseFormat::kCsc}) {
+    S21SparseMatrix sparse(dense, 0., format);
+    ASSERT_EQ(sparse.GetFormat(), format);
+    ASSERT_EQ(sparse.Offsets().size(),
+              format == S21SparseFormat::kCsr ? 41u : 31u);
+    ASSERT_EQ(sparse.Offsets().back(), sparse.NonZeros());
+    ASSERT_TRUE(sparse.ToDense() == dense);
+    ASSERT_EQ(sparse(3, 4), 1e-9);
+    S21SparseMatrix dropped(dense, 1e-6, format);
+    ASSERT_EQ(dropped.NonZeros() + 1, sparse.NonZeros());
+    ASSERT_EQ(dropped(3, 4), 0.);
+  }
+}
+
+TEST(sparse_matrix, from_dense_keeps_nan) {
+  S21Matrix dense = RandomSparse(20, 15, 5, 2);
+  dense(7, 2) = NAN;
+  for (S21SparseFormat format :
+       {S21SparseFormat::kCsr, S21SparseFormat::kCsc}) {
+    S21SparseMatrix sparse(dense, 0.5, format);
+    ASSERT_TRUE(std::isnan(sparse(7, 2)));
+    S21Matrix round_trip = sparse.ToDense();
+    ASSERT_TRUE(std::isnan(round_trip(7, 2)));
+    round_trip(7, 2) = dense(7, 2) = 0;
+    ASSERT_TRUE(round_trip == S21SparseMatrix(dense, 0.5, format).ToDense());
+    dense(7, 2) = NAN;
+  }
+}
+
+TEST(sparse_matrix, from_triplets) {
+  std::vector<S21Triplet> triplets = {
+      {2, 1, 1.}, {0, 3, 2.}, {2, 1, 0.5}, {1, 0, -1.}, {0, 0, 4.}};
+  S21SparseMatrix csr(3, 4, triplets);
+  S21SparseMatrix csc(3, 4, triplets, S21SparseFormat::kCsc);
+  ASSERT_EQ(csr.NonZeros(), 4u);
+  ASSERT_EQ(csr(2, 1), 1.5);
+  ASSERT_EQ(csr(1, 1), 0.);
+  ASSERT_EQ(std::vector<int>(csr.Indices().begin(), csr.Indices().end()),
+            (std::vector<int>{0, 3, 0, 1}));
+  ASSERT_TRUE(csr == csc);
+  ASSERT_TRUE(csr.ToDense() == csc.ToDense());
+  ASSERT_TRUE(csr.ToFormat(S21SparseFormat::kCsc).Indices() == csc.Indices());
+  ASSERT_TRUE(csc.ToFormat(S21SparseFormat::kCsr).Values() == csr.Values());
+}
+
+TEST(sparse_matrix, transpose) {
+  S21Matrix dense = RandomSparse(17, 23, 4, 2);
+  S21SparseMatrix sparse(dense);
+  S21SparseMatrix transposed = sparse.Transpose();
+  ASSERT_EQ(transposed.GetRows(), 23);
+  ASSERT_EQ(transposed.GetFormat(), S21SparseFormat::kCsc);
+  S21Matrix expected = dense.Transpose();
+  ASSERT_TRUE(transposed.ToDense() == expected);
+}
+
+TEST(sparse_matrix, add) {
+  S21Matrix a = RandomSparse(30, 20, 5, 3), b = RandomSparse(30, 20, 5, 4);
+  S21SparseMatrix sa(a), sb(b, 0., S21SparseFormat::kCsc);
+  S21Matrix sum = a + b, difference = a - b;
+  ASSERT_TRUE((sa + sb).ToDense() == sum);
+  ASSERT_TRUE((sa - sb).ToDense() == difference);
+  S21SparseMatrix zero = sa - sa;
+  ASSERT_EQ(zero.NonZeros(), 0u);
+  ASSERT_TRUE(zero == S21SparseMatrix(30, 20));
+}
+
+TEST(sparse_matrix, mul_vector) {
+  S21Matrix dense = RandomSparse(300, 200, 20, 5);
+  S21Matrix x(200, 1);
+  for (int i = 0; i < 200; i++) x(i, 0) = i * 0.01 - 1;
+  S21Matrix expected = dense * x;
+  for (S21SparseFormat format :
+       {S21SparseFormat::kCsr, S21SparseFormat::kCsc}) {
+    S21SparseMatrix sparse(dense, 0., format);
+    std::vector<double> y(300, -1.);
+    sparse.MulVector(x.data(), y.data());
+    for (int i = 0; i < 300; i++) ASSERT_NEAR(y[i], expected(i, 0), 1e-12);
+  }
+}
+
+TEST(sparse_matrix, mul_matrix) {
+  S21Matrix dense = RandomSparse(70, 90, 8, 6);
+  S21Matrix b = RandomSparse(90, 33, 1, 7);
+  S21Matrix expected = dense * b;
+  for (S21SparseFormat format :
+       {S21SparseFormat::kCsr, S21SparseFormat::kCsc}) {
+    S21SparseMatrix sparse(dense, 0., format);
+    ASSERT_TRUE((sparse * b).EqMatrix(expected, 1e-12));
+  }
+}
+
+TEST(sparse_matrix, throws) {
+  ASSERT_THROW(S21SparseMatrix(0, 3), std::out_of_range);
+  std::vector<S21Triplet> bad = {{3, 0, 1.}};
+  ASSERT_THROW(S21SparseMatrix(3, 3, bad), std::out_of_range);
+  S21SparseMatrix a(3, 4), b(4, 3);
+  ASSERT_THROW(a(3, 0), std::out_of_range);
+  ASSERT_THROW(a.SumMatrix(b), std::invalid_argument);
+  ASSERT_THROW(a.MulMatrix(S21Matrix(3, 3)), std::invalid_argument);
+  ASSERT_FALSE(a == b);
+}
@@ -0,0 +1,137 @@
+#include <cmath>
+#include <vector>
+
+#include "test_base.h"
+
+// Small integers keep every sum and product exact, so any schedule of the
+// recursion gives exactly the classic result.
+static void FillIntegers(S21Matrix &matr, unsigned seed) {
+  for (int i = 0; i < matr.GetRows(); i++) {
+    for (int j = 0; j < matr.GetCols(); j++) {
+      seed = seed * 1103515245u + 12345u;
+      matr(i, j) = static_cast<double>((seed >> 16) % 9) - 4.;
+    }
+  }
+}
+
+// Restores the process-wide settings at the end of a test.
+class StrassenSettings {
+ public:
+  StrassenSettings(s21::MulAlgorithm algorithm, int crossover)
+      : algorithm_(s21::SetMulAlgorithm(algorithm)),
+        crossover_(s21::SetStrassenCrossover(crossover)) {}
+  ~StrassenSettings() {
+    s21::SetMulAlgorithm(algorithm_);
+    s21::SetStrassenCrossover(crossover_);
+  }
+
+ private:
+  s21::MulAlgorithm algorithm_;
+  int crossover_;
+};
+
+TEST(strassen, exact_on_integers) {
+  StrassenSettings settings(s21::MulAlgorithm::kClassic, 8);
+  const int shapes[][3] = {{64, 64, 64},  {67, 45, 91}, {33, 100, 17},
+                           {120, 9, 130}, {9, 9, 9},    {1, 50, 50}};
+  for (const auto &shape : shapes) {
+    S21Matrix a(shape[0], shape[1]), b(shape[1], shape[2]);
+    FillIntegers(a, shape[0]);
+    FillIntegers(b, shape[2]);
+    S21Matrix classic = a * b;
+    S21Matrix strassen = a;
+    strassen.MulMatrix(b, s21::MulAlgorithm::kStrassen);
+    ASSERT_TRUE(strassen.EqMatrix(classic, 0));
+  }
+}
+
+TEST(strassen, normwise_error) {
+  StrassenSettings settings(s21::MulAlgorithm::kStrassen, 16);
+  S21Matrix a(257, 300), b(300, 263);
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(b, 2);
+  S21Matrix strassen = a * b;
+  S21Matrix classic = a;
+  classic.MulMatrix(b, s21::MulAlgorithm::kClassic);
+  double error = 0;
+  for (int i = 0; i < 257; i++) {
+    for (int j = 0; j < 263; j++) {
+      error = std::max(error, std::fabs(strassen(i, j) - classic(i, j)));
+    }
+  }
+  // max |A| and max |B| are 1; four levels over leaves of 16.
+  ASSERT_GT(error, 0);
+  ASSERT_LT(error, 300 * 1e-13);
+}
+
+TEST(strassen, settings) {
+  StrassenSettings settings(s21::MulAlgorithm::kStrassen, 0);
+  ASSERT_EQ(s21::GetMulAlgorithm(), s21::MulAlgorithm::kStrassen);
+  ASSERT_EQ(s21::GetStrassenCrossover(), 1);
+  ASSERT_EQ(s21::SetStrassenCrossover(4), 1);
+  S21Matrix a(21, 21), b(21, 21);
+  FillIntegers(a, 3);
+  FillIntegers(b, 4);
+  S21Matrix product = a;
+  product *= b;
+  ASSERT_EQ(s21::SetMulAlgorithm(s21::MulAlgorithm::kClassic),
+            s21::MulAlgorithm::kStrassen);
+  ASSERT_TRUE(product.EqMatrix(a * b, 0));
+}
+
+TEST(strassen, workspace) {
+  ASSERT_EQ(s21::StrassenWorkspace<double>(512, 512, 512, 512), 0u);
+  ASSERT_EQ(s21::StrassenWorkspace<double>(100, 40, 60, 8),
+            50u * 30 + 30 * 20 + 25u * 15 + 15 * 10 + 12u * 7 + 7 * 5);
+  // The recursion stays inside the workspace it asks for.
+  const int m = 37, n = 29, k = 43, crossover = 4;
+  S21Matrix a(m, k), b(n, k), c(m, n);
+  FillIntegers(a, 5);
+  FillIntegers(b, 6);
+  const std::size_t size = s21::StrassenWorkspace<double>(m, n, k, crossover);
+  std::vector<double> workspace(size + 16, 7.);
+  s21::Strassen<double>(m, n, k, a.data(), a.stride(), 1, b.data(), 1,
+                        b.stride(), c.data(), c.stride(), 1, crossover,
+                        workspace.data());
+  for (std::size_t i = size; i < size + 16; i++) ASSERT_EQ(workspace[i], 7.);
+  ASSERT_TRUE(c.EqMatrix(a * S21Matrix(b.View().Transposed()), 0));
+}
+
+TEST(strassen, single_workspace_allocation) {
+  StrassenSettings settings(s21::MulAlgorithm::kStrassen, 64);
+  const int n = 1024;
+  S21Matrix a(n, n), b(n, n), c(n, n);
+  FillIntegers(a, 7);
+  FillIntegers(b, 8);
+  S21PoolResource pool;
+  {
+    S21ResourceScope scope(&pool);
+    s21::Multiply<double>(s21::MulAlgorithm::kStrassen, n, n, n, a.data(),
+                          a.stride(), 1, b.data(), b.stride(), 1, c.data(),
+                          c.stride(), 1);
+  }
+  // The workspace is the one allocation; the quadrant updates reuse C.
+  ASSERT_EQ(pool.GetStats().allocations, 1u);
+  ASSERT_TRUE(c.EqMatrix(a * b, 0));
+}
+
+TEST(strassen, other_types) {
+  StrassenSettings settings(s21::MulAlgorithm::kStrassen, 8);
+  S21FloatMatrix a(70, 50), b(50, 61);
+  S21LongDoubleMatrix c(45, 45);
+  for (int i = 0; i < 70; i++) {
+    for (int j = 0; j < 50; j++) a(i, j) = (i * 3 + j) % 7 - 3.f;
+  }
+  for (int i = 0; i < 50; i++) {
+    for (int j = 0; j < 61; j++) b(i, j) = (i + j * 5) % 5 - 2.f;
+  }
+  for (int i = 0; i < 45; i++) {
+    for (int j = 0; j < 45; j++) c(i, j) = (i * j) % 11 - 5.L;
+  }
+  S21FloatMatrix product = a;
+  product.MulMatrix(b, s21::MulAlgorithm::kClassic);
+  ASSERT_TRUE((a * b).EqMatrix(product, 0));
+  S21LongDoubleMatrix square = c;
+  square.MulMatrix(c, s21::MulAlgorithm::kClassic);
+  ASSERT_TRUE((c * c).EqMatrix(square, 0));
+}
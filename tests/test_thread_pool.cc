@@ -0,0 +1,121 @@
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "test_base.h"
+
+// Runs the enclosed test body with a four-thread global pool, whatever the
+// host has, and restores the default afterwards.
+class PoolGuard {
+ public:
+  explicit PoolGuard(int threads,
+                     s21::AffinityPolicy policy = s21::AffinityPolicy::kNone)
+      : previous_(s21::ThreadPool::Instance().GetThreadCount()) {
+    s21::ThreadPool::Instance().Configure(threads, policy);
+  }
+  ~PoolGuard() { s21::ThreadPool::Instance().Configure(previous_); }
+
+ private:
+  int previous_;
+};
+
+TEST(thread_pool, covers_range_once) {
+  s21::ThreadPool pool(4);
+  ASSERT_EQ(pool.GetThreadCount(), 4);
+  std::vector<std::atomic<int>> hits(10007);
+  pool.ParallelFor(10007, 16, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t i = begin; i < end; i++) hits[i]++;
+  });
+  for (const std::atomic<int> &hit : hits) ASSERT_EQ(hit, 1);
+}
+
+TEST(thread_pool, inline_below_grain) {
+  s21::ThreadPool pool(4);
+  int calls = 0;
+  pool.ParallelFor(100, 64, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    calls++;
+    ASSERT_EQ(begin, 0);
+    ASSERT_EQ(end, 100);
+  });
+  ASSERT_EQ(calls, 1);
+}
+
+TEST(thread_pool, nested) {
+  s21::ThreadPool pool(3, s21::AffinityPolicy::kCompact);
+  std::atomic<long> sum(0);
+  pool.ParallelFor(8, 1, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t i = begin; i < end; i++) {
+      pool.ParallelFor(100, 1, [&](std::ptrdiff_t b, std::ptrdiff_t e) {
+        sum += e - b;
+      });
+    }
+  });
+  ASSERT_EQ(sum, 800);
+}
+
+TEST(thread_pool, rethrows) {
+  s21::ThreadPool pool(4);
+  try {
+    pool.ParallelFor(64, 1, [&](std::ptrdiff_t begin, std::ptrdiff_t) {
+      if (begin > 0) throw std::runtime_error("chunk failed");
+    });
+    FAIL();
+  } catch (const std::exception &e) {
+    ASSERT_STREQ(e.what(), "chunk failed");
+  }
+}
+
+TEST(thread_pool, submit) {
+  s21::ThreadPool pool(2);
+  std::atomic<int> done(0);
+  for (int i = 0; i < 50; i++) pool.Submit([&] { done++; });
+  while (done < 50) std::this_thread::yield();
+  ASSERT_EQ(done, 50);
+}
+
+TEST(thread_pool, configure_runs_queued_tasks) {
+  s21::ThreadPool pool(3);
+  std::atomic<int> done(0);
+  for (int i = 0; i < 200; i++) {
+    pool.Submit([&] {
+      pool.Submit([&] { done++; });
+      done++;
+    });
+  }
+  pool.Configure(1);
+  ASSERT_EQ(done, 400);
+  pool.Submit([&] { done++; });
+  ASSERT_EQ(done, 401);
+}
+
+TEST(thread_pool, kernels_match_serial) {
+  S21Matrix a(300, 200), b(200, 260), c(300, 200);
+  a._FillMatrix(0.5);
+  b._FillMatrix(-3);
+  c._FillMatrix(2);
+  for (int i = 0; i < 200; i++) a(i % 300, i) += 400;
+  S21Matrix square(200, 200);
+  for (int i = 0; i < 200; i++) {
+    for (int j = 0; j < 200; j++) square(i, j) = a(i, j);
+  }
+  S21Matrix serial_product, serial_sum, serial_transpose;
+  double serial_det = 0;
+  {
+    PoolGuard guard(1);
+    serial_product = a * b;
+    serial_sum = a + c;
+    serial_transpose = a.Transpose();
+    serial_det = square.Determinant();
+  }
+  {
+    PoolGuard guard(4, s21::AffinityPolicy::kScatter);
+    S21Matrix product = a * b, sum = a + c, transpose = a.Transpose();
+    ASSERT_EQ(std::memcmp(product.data(), serial_product.data(),
+                          sizeof(double) * product.stride() * 300),
+              0);
+    ASSERT_TRUE(sum == serial_sum);
+    ASSERT_TRUE(transpose == serial_transpose);
+    ASSERT_EQ(square.Determinant(), serial_det);
+  }
+}
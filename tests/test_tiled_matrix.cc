@@ -0,0 +1,128 @@
+#include <cstdio>
+#include <string>
+
+#include "test_base.h"
+
+static std::string TempPath(const std::string &name) {
+  return testing::TempDir() + "s21_tiled_matrix_" + name;
+}
+
+TEST(tiled_matrix, create) {
+  const std::string path = TempPath("create");
+  S21TiledMatrix matr(path, 300, 520, 200);
+  ASSERT_EQ(matr.GetRows(), 300);
+  ASSERT_EQ(matr.GetCols(), 520);
+  ASSERT_EQ(matr.GetTile(), 256);
+  ASSERT_EQ(matr.TileRows(), 2);
+  ASSERT_EQ(matr.TileCols(), 3);
+  ASSERT_TRUE(matr.ToMatrix() == S21Matrix(300, 520));
+  S21Matrix tile(256, 256);
+  s21::Fill<double>(tile, 2.5);
+  matr.WriteTile(1, 2, tile);
+  S21TiledMatrix opened = S21TiledMatrix::Open(path);
+  ASSERT_EQ(opened.GetTile(), 256);
+  S21Matrix loaded = opened.ToMatrix();
+  ASSERT_EQ(loaded(299, 519), 2.5);
+  ASSERT_EQ(loaded(256, 512), 2.5);
+  ASSERT_EQ(loaded(255, 511), 0);
+  S21Matrix read(256, 256);
+  opened.ReadTile(1, 2, read);
+  ASSERT_TRUE(read == tile);
+  ASSERT_THROW(opened.ReadTile(2, 0, read), std::out_of_range);
+  S21Matrix small(10, 10);
+  ASSERT_THROW(opened.ReadTile(0, 0, small), std::invalid_argument);
+  ASSERT_THROW(S21FloatTiledMatrix::Open(path), std::invalid_argument);
+  std::remove(path.c_str());
+}
+
+TEST(tiled_matrix, mul_matrix) {
+  const std::string a_path = TempPath("a"), b_path = TempPath("b");
+  const std::string c_path = TempPath("c");
+  S21Matrix a(300, 520), b(520, 270);
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(b, 2);
+  S21TiledMatrix tiled_a = S21TiledMatrix::FromMatrix(a_path, a, 256);
+  S21TiledMatrix tiled_b = S21TiledMatrix::FromMatrix(b_path, b, 256);
+  ASSERT_TRUE(tiled_a.ToMatrix() == a);
+  S21TiledMatrix c = tiled_a.MulMatrix(tiled_b, c_path);
+  ASSERT_EQ(c.GetRows(), 300);
+  ASSERT_EQ(c.GetCols(), 270);
+  ASSERT_TRUE(c.ToMatrix().EqMatrix(a * b, 0));
+  S21Matrix edge(256, 256);
+  c.ReadTile(1, 1, edge);
+  ASSERT_EQ(edge(43, 13), (a * b)(299, 269));
+  ASSERT_EQ(edge(44, 13), 0);
+  ASSERT_EQ(edge(43, 14), 0);
+  ASSERT_THROW(tiled_a.MulMatrix(tiled_a, c_path), std::invalid_argument);
+  S21TiledMatrix other_tile = S21TiledMatrix::FromMatrix(b_path, b, 512);
+  ASSERT_THROW(tiled_a.MulMatrix(other_tile, c_path), std::invalid_argument);
+  std::remove(a_path.c_str());
+  std::remove(b_path.c_str());
+  std::remove(c_path.c_str());
+}
+
+TEST(tiled_matrix, edge_tile_of_one) {
+  const std::string a_path = TempPath("a"), b_path = TempPath("b");
+  const std::string c_path = TempPath("c");
+  const int shapes[][3] = {{300, 520, 257}, {257, 520, 300}, {300, 257, 270},
+                           {3, 600, 1},     {1, 600, 3},     {257, 1, 257}};
+  for (const auto &shape : shapes) {
+    S21Matrix a(shape[0], shape[1]), b(shape[1], shape[2]);
+    FillPseudoRandom(a, 5);
+    FillPseudoRandom(b, 6);
+    S21TiledMatrix tiled_a = S21TiledMatrix::FromMatrix(a_path, a, 256);
+    S21TiledMatrix tiled_b = S21TiledMatrix::FromMatrix(b_path, b, 256);
+    S21Matrix c = tiled_a.MulMatrix(tiled_b, c_path).ToMatrix();
+    ASSERT_TRUE(c.EqMatrix(a * b, 0));
+  }
+  S21Matrix edge(256, 256);
+  S21TiledMatrix(S21TiledMatrix::Open(c_path)).ReadTile(1, 1, edge);
+  ASSERT_EQ(edge(1, 0), 0);
+  ASSERT_EQ(edge(0, 1), 0);
+  std::remove(a_path.c_str());
+  std::remove(b_path.c_str());
+  std::remove(c_path.c_str());
+}
+
+TEST(tiled_matrix, smaller_than_tile) {
+  const std::string a_path = TempPath("a"), c_path = TempPath("c");
+  S21Matrix a(7, 7);
+  FillPseudoRandom(a, 3);
+  S21TiledMatrix tiled = S21TiledMatrix::FromMatrix(a_path, a);
+  ASSERT_EQ(tiled.GetTile(), S21TiledMatrix::kDefaultTile);
+  S21TiledMatrix c = tiled.MulMatrix(tiled, c_path);
+  ASSERT_TRUE(c.ToMatrix().EqMatrix(a * a, 0));
+  std::remove(a_path.c_str());
+  std::remove(c_path.c_str());
+}
+
+TEST(tiled_matrix, float_elements) {
+  const std::string a_path = TempPath("a"), c_path = TempPath("c");
+  S21FloatMatrix a(270, 260);
+  for (int i = 0; i < 270; i++) {
+    for (int j = 0; j < 260; j++) a(i, j) = (i * 7 + j * 3) % 11 - 5.f;
+  }
+  S21FloatTiledMatrix tiled = S21FloatTiledMatrix::FromMatrix(a_path, a, 1);
+  S21FloatTiledMatrix at = S21FloatTiledMatrix::FromMatrix(
+      TempPath("at"), a.View().Transposed(), 1);
+  S21FloatTiledMatrix c = tiled.MulMatrix(at, c_path);
+  ASSERT_TRUE(c.ToMatrix() == a * a.Transpose());
+  std::remove(a_path.c_str());
+  std::remove(TempPath("at").c_str());
+  std::remove(c_path.c_str());
+}
+
+TEST(tiled_matrix, matrix_file) {
+  const std::string file_path = TempPath("file"), path = TempPath("tiles");
+  S21Matrix matr(290, 600);
+  FillPseudoRandom(matr, 4);
+  matr.Save(file_path);
+  S21TiledMatrix tiled = S21TiledMatrix::FromFile(path, file_path, 256);
+  ASSERT_TRUE(tiled.ToMatrix() == matr);
+  std::remove(file_path.c_str());
+  tiled.Save(file_path);
+  ASSERT_TRUE(S21MappedMatrix(file_path).Verify());
+  ASSERT_TRUE(S21Matrix::Load(file_path) == matr);
+  std::remove(file_path.c_str());
+  std::remove(path.c_str());
+}
@@ -0,0 +1,71 @@
+#include "test_base.h"
+
+// Lower triangle of a with the given diagonal, zeros above. The elements
+// below the diagonal are scaled by 1 / n: random unit triangular matrices
+// are exponentially ill-conditioned otherwise.
+static S21Matrix Lower(S21Matrix &a, bool unit) {
+  const int n = a.GetRows();
+  S21Matrix l(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < i; j++) l(i, j) = a(i, j) / n;
+    l(i, i) = unit ? 1 : a(i, i) + 4;
+  }
+  return l;
+}
+
+TEST(triangular, lower_and_upper) {
+  for (int n : {1, 10, 64, 150}) {
+    S21Matrix a(n, n), x(n, 5);
+    FillPseudoRandom(a, n);
+    FillPseudoRandom(x, n + 1);
+    for (bool unit : {false, true}) {
+      S21Matrix l = Lower(a, unit), u = l.Transpose();
+      // The unused triangles hold garbage that must not be read.
+      for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) l(i, j) = 1e6;
+        for (int j = 0; j < i; j++) u(i, j) = 1e6;
+      }
+      const s21::Diagonal diagonal =
+          unit ? s21::Diagonal::kUnit : s21::Diagonal::kNonUnit;
+      S21Matrix lower = Lower(a, unit), upper = lower.Transpose();
+      S21Matrix b = lower * x;
+      s21::TriangularSolve<double>(s21::Triangle::kLower, diagonal, l, b);
+      ASSERT_TRUE(b.EqMatrix(x, 1e-10));
+      b = upper * x;
+      s21::TriangularSolve<double>(s21::Triangle::kUpper, diagonal, u, b);
+      ASSERT_TRUE(b.EqMatrix(x, 1e-10));
+    }
+  }
+}
+
+TEST(triangular, strided_views) {
+  S21Matrix a(100, 100), x(3, 100);
+  FillPseudoRandom(a, 1);
+  FillPseudoRandom(x, 2);
+  S21Matrix lower = Lower(a, false);
+  // A transposed lower triangle is upper; right-hand sides in the rows of a
+  // matrix are the columns of its transposed view.
+  S21Matrix b = x * lower;
+  s21::TriangularSolve<double>(
+      s21::Triangle::kUpper, s21::Diagonal::kNonUnit,
+      lower.View().Transposed(), b.View().Transposed());
+  ASSERT_TRUE(b.EqMatrix(x, 1e-10));
+}
+
+TEST(triangular, Throw) {
+  S21Matrix a(3, 3), b(4, 1), c(3, 2);
+  try {
+    s21::TriangularSolve<double>(s21::Triangle::kLower,
+                                 s21::Diagonal::kNonUnit, a, b);
+    FAIL();
+  } catch (const std::exception &e) {
+    ASSERT_STREQ(e.what(), "Sizes are not equal");
+  }
+  try {
+    s21::TriangularSolve<double>(s21::Triangle::kLower,
+                                 s21::Diagonal::kNonUnit, c, b);
+    FAIL();
+  } catch (const std::exception &e) {
+    ASSERT_STREQ(e.what(), "Matrix is not square");
+  }
+}
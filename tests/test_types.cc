@@ -0,0 +1,107 @@
+#include "test_base.h"
+
+template <class T>
+class element_type : public ::testing::Test {};
+
+using ElementTypes = ::testing::Types<float, double, long double>;
+TYPED_TEST_SUITE(element_type, ElementTypes);
+
+TYPED_TEST(element_type, arithmetic_matches_double) {
+  using T = TypeParam;
+  S21Matrix a(70, 70), b(70, 70);
+  FillWellConditioned(a, 1);
+  FillWellConditioned(b, 2);
+  S21BasicMatrix<T> ta(a), tb(b);
+  const T tolerance = S21Tolerance<T>::kEqual * 100;
+
+  S21Matrix sum = a + b - b * 2.;
+  S21BasicMatrix<T> tsum = ta + tb - tb * 2.;
+  ASSERT_TRUE(S21Matrix(tsum).EqMatrix(sum, tolerance));
+
+  S21Matrix product = a * b;
+  ASSERT_TRUE(S21Matrix(ta * tb).EqMatrix(product, tolerance));
+
+  S21BasicMatrix<T> transposed = ta.Transpose();
+  for (int i = 0; i < 70; i++) ASSERT_EQ(transposed(i, 3), ta(3, i));
+
+  S21Matrix small(5, 5);
+  FillWellConditioned(small, 3);
+  S21BasicMatrix<T> tsmall(small);
+  ASSERT_NEAR(static_cast<double>(tsmall.Determinant()), small.Determinant(),
+              small.Determinant() * tolerance);
+  ASSERT_TRUE(
+      S21Matrix(tsmall.InverseMatrix()).EqMatrix(small.InverseMatrix(),
+                                                 tolerance));
+}
+
+TYPED_TEST(element_type, lu_solve) {
+  using T = TypeParam;
+  S21BasicMatrix<T> a(90, 90), x(90, 2);
+  FillWellConditioned(a, 4);
+  FillWellConditioned(x, 5);
+  S21BasicMatrix<T> b = a * x;
+  S21BasicLU<T> lu(a);
+  ASSERT_FALSE(lu.IsSingular());
+  ASSERT_TRUE(lu.Solve(b).EqMatrix(x, S21Tolerance<T>::kEqual * 100));
+}
+
+TEST(element_type, tolerance_policy) {
+  S21FloatMatrix a(2, 2), b(2, 2);
+  b(1, 1) = 5e-5f;
+  ASSERT_TRUE(a == b);
+  b(1, 1) = 5e-4f;
+  ASSERT_FALSE(a == b);
+  ASSERT_TRUE(a.EqMatrix(b, 1e-3f));
+
+  S21LongDoubleMatrix c(2, 2), d(2, 2);
+  d(0, 0) = 1e-9L;
+  ASSERT_FALSE(c == d);
+  d(0, 0) = 1e-11L;
+  ASSERT_TRUE(c == d);
+}
+
+TEST(element_type, conversion) {
+  S21Matrix a(3, 4);
+  FillWellConditioned(a, 6);
+  S21FloatMatrix f(a);
+  ASSERT_EQ(f.GetRows(), 3);
+  ASSERT_EQ(f(2, 3), static_cast<float>(a(2, 3)));
+  S21LongDoubleMatrix l(f);
+  ASSERT_EQ(l(1, 2), static_cast<long double>(f(1, 2)));
+  S21FixedMatrix<3, 4, float> fixed(a);
+  ASSERT_TRUE(fixed.ToMatrix() == f);
+}
+
+// Double accumulation of float operands is as accurate as a double product
+// of the rounded operands and beats the float product.
+TEST(element_type, mixed_precision) {
+  const int n = 300;
+  S21Matrix a(n, n), b(n, n);
+  FillWellConditioned(a, 7);
+  FillWellConditioned(b, 8);
+  S21FloatMatrix fa(a), fb(b);
+  S21Matrix exact = S21Matrix(fa) * S21Matrix(fb);
+
+  S21FloatMatrix plain(fa), mixed(fa);
+  plain.MulMatrix(fb);
+  mixed.MulMatrixMixed(fb);
+  double plain_error = 0, mixed_error = 0;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      plain_error = std::max(plain_error, std::abs(plain(i, j) - exact(i, j)));
+      mixed_error = std::max(mixed_error, std::abs(mixed(i, j) - exact(i, j)));
+    }
+  }
+  ASSERT_LT(mixed_error, plain_error);
+  // Only the final rounding to float remains.
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      ASSERT_NEAR(mixed(i, j), exact(i, j), std::abs(exact(i, j)) * 1e-7);
+    }
+  }
+
+  S21FloatMatrix small(6, 6);
+  FillWellConditioned(small, 9);
+  double det = small.DeterminantMixed();
+  ASSERT_DOUBLE_EQ(det, S21Matrix(small).Determinant());
+}
@@ -0,0 +1,155 @@
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "test_base.h"
+
+static S21Vector PseudoRandomVector(int size, unsigned seed) {
+  S21Matrix column(size, 1);
+  FillPseudoRandom(column, seed);
+  return S21Vector(column);
+}
+
+// alpha * a * b + beta * c element by element.
+static S21Matrix NaiveGemm(double alpha, S21ConstMatrixView a,
+                           S21ConstMatrixView b, double beta,
+                           S21ConstMatrixView c) {
+  S21Matrix result(c.GetRows(), c.GetCols());
+  for (int i = 0; i < c.GetRows(); i++) {
+    for (int j = 0; j < c.GetCols(); j++) {
+      double sum = 0;
+      for (int p = 0; p < a.GetCols(); p++) sum += a(i, p) * b(p, j);
+      result(i, j) = alpha * sum + beta * c(i, j);
+    }
+  }
+  return result;
+}
+
+TEST(vector, construction_and_access) {
+  S21Vector v{1., 2., 3.};
+  ASSERT_EQ(v.GetSize(), 3);
+  ASSERT_EQ(v(1), 2.);
+  v(2) = -4.;
+  S21Matrix row(1, 3);
+  row(0, 2) = -4.;
+  row(0, 1) = 2.;
+  row(0, 0) = 1.;
+  ASSERT_TRUE(S21Vector(row) == v);
+  ASSERT_TRUE(v.ToMatrix().EqMatrix(S21Matrix(row.Transpose())));
+  ASSERT_TRUE(S21Vector(v.View().Transposed()) == v);
+  ASSERT_TRUE(S21Vector(4) == S21Vector({0., 0., 0., 0.}));
+  ASSERT_THROW(S21Vector(0), std::out_of_range);
+  ASSERT_THROW(v(3), std::out_of_range);
+  ASSERT_THROW(S21Vector(S21Matrix(2, 2)), std::invalid_argument);
+}
+
+TEST(vector, level_one) {
+  const int n = 40000;
+  S21Vector x = PseudoRandomVector(n, 1), y = PseudoRandomVector(n, 2);
+  double dot = 0, norm1 = 0, max = 0;
+  for (int i = 0; i < n; i++) {
+    dot += x(i) * y(i);
+    norm1 += std::fabs(x(i));
+    max = std::max(max, std::fabs(x(i)));
+  }
+  ASSERT_NEAR(x.Dot(y), dot, 1e-9);
+  ASSERT_NEAR(x.Norm1(), norm1, 1e-9);
+  ASSERT_EQ(x.NormInf(), max);
+  ASSERT_NEAR(x.Norm2(), std::sqrt(x.Dot(x)), 1e-12);
+  S21Vector axpy = y;
+  axpy.Axpy(0.5, x);
+  ASSERT_TRUE(axpy.EqVector(y + x * 0.5, 1e-15));
+  ASSERT_TRUE((axpy - y).EqVector(0.5 * x, 1e-15));
+  ASSERT_THROW(x.Dot(S21Vector(3)), std::invalid_argument);
+  ASSERT_THROW(x += S21Vector(3), std::invalid_argument);
+}
+
+TEST(vector, norm2_rescales) {
+  const double big = std::numeric_limits<double>::max() / 2;
+  ASSERT_DOUBLE_EQ(S21Vector({big, big}).Norm2(), big * std::sqrt(2.));
+  ASSERT_DOUBLE_EQ(S21Vector({3e-200, 4e-200}).Norm2(), 5e-200);
+  ASSERT_EQ(S21Vector(5).Norm2(), 0.);
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double inf = std::numeric_limits<double>::infinity();
+  ASSERT_TRUE(std::isnan(S21Vector({nan}).NormInf()));
+  ASSERT_TRUE(std::isnan(S21Vector({nan, 0}).Norm2()));
+  ASSERT_TRUE(std::isnan(S21Vector({inf, nan}).NormInf()));
+  ASSERT_TRUE(std::isnan(S21Vector({0, nan}).Norm1()));
+  ASSERT_EQ(S21Vector({1, -inf}).Norm2(), inf);
+}
+
+TEST(vector, gemv_and_ger) {
+  S21Matrix a(70, 50);
+  FillPseudoRandom(a, 3);
+  S21Vector x = PseudoRandomVector(50, 4), y = PseudoRandomVector(70, 5);
+  ASSERT_TRUE(S21Vector(a * x).EqVector(
+      S21Vector(NaiveGemm(1, a.View(), x.View(), 0, S21Matrix(70, 1))),
+      1e-12));
+  ASSERT_TRUE(S21Vector(y * a).EqVector(
+      S21Vector(NaiveGemm(1, y.View().Transposed(), a.View(), 0,
+                          S21Matrix(1, 50))),
+      1e-12));
+  S21Vector result = y;
+  s21::Gemv<double>(2., a.View(), x, -1., result);
+  ASSERT_TRUE(result.EqVector(
+      S21Vector(NaiveGemm(2, a.View(), x.View(), -1, y.View())), 1e-12));
+  S21Vector square = PseudoRandomVector(50, 6);
+  S21Matrix b(50, 50);
+  FillPseudoRandom(b, 7);
+  S21Vector expected = b * square;
+  s21::Gemv<double>(1., b.View(), square, 0., square);
+  ASSERT_TRUE(square == expected);
+  S21Matrix updated = a;
+  s21::Ger<double>(0.5, y, x, updated.View());
+  ASSERT_TRUE(updated.EqMatrix(
+      NaiveGemm(0.5, y.View(), x.View().Transposed(), 1, a.View()), 1e-12));
+  ASSERT_THROW(a * y, std::invalid_argument);
+  ASSERT_THROW(s21::Ger<double>(1., x, y, a.View()), std::invalid_argument);
+}
+
+// Products with one row or column of C, or with k == 1, take the GEMV and
+// GER paths of s21::Gemm for every layout of the operands.
+TEST(vector, gemm_routes_vector_shapes) {
+  for (int threads : {1, 3}) {
+    const int previous = s21::ThreadPool::Instance().GetThreadCount();
+    s21::ThreadPool::Instance().Configure(threads);
+    for (auto [m, n, k] : {std::array<int, 3>{90, 1, 70}, {1, 90, 70},
+                           {90, 70, 1}, {1, 1, 70}}) {
+      S21Matrix a(m, k), at(k, m), b(k, n), bt(n, k), c(m, n), ct(n, m);
+      FillPseudoRandom(a, 8);
+      FillPseudoRandom(b, 9);
+      FillPseudoRandom(c, 10);
+      at = S21Matrix(a.Transpose());
+      bt = S21Matrix(b.Transpose());
+      for (double beta : {0., 1., -0.5}) {
+        S21Matrix expected = NaiveGemm(1.5, a.View(), b.View(), beta, c);
+        for (bool trans_a : {false, true}) {
+          for (bool trans_b : {false, true}) {
+            S21ConstMatrixView va =
+                trans_a ? at.View().Transposed() : a.View();
+            S21ConstMatrixView vb =
+                trans_b ? bt.View().Transposed() : b.View();
+            S21Matrix actual = c;
+            s21::Gemm<double>(1.5, va, vb, beta, actual.View());
+            ASSERT_TRUE(actual.EqMatrix(expected, 1e-12));
+            ct = S21Matrix(c.Transpose());
+            s21::Gemm<double>(1.5, va, vb, beta, ct.View().Transposed());
+            ASSERT_TRUE(S21Matrix(ct.Transpose()).EqMatrix(expected, 1e-12));
+          }
+        }
+      }
+    }
+    s21::ThreadPool::Instance().Configure(previous);
+  }
+}
+
+TEST(vector, float_elements) {
+  S21BasicMatrix<float> a(3, 2);
+  a(0, 0) = 1.f;
+  a(1, 1) = 2.f;
+  a(2, 0) = 3.f;
+  S21BasicVector<float> x{1.f, -1.f};
+  ASSERT_TRUE((a * x).EqVector(S21BasicVector<float>{1.f, -2.f, 3.f}));
+  ASSERT_FLOAT_EQ((S21BasicVector<float>{3.f, 4.f}.Norm2()), 5.f);
+}